@@ -0,0 +1,316 @@
+/*
+ * Autofocus - V-curve sweep with on-device curve fitting
+ *
+ * The engine steps the focuser through evenly spaced sample positions.
+ * At each one it announces the sample and waits for the client to send
+ * back a focus metric (HFR or contrast). Samples feed an incremental
+ * least-squares fit; after the sweep the focuser moves to the fitted
+ * best focus, approaching it from the sweep direction so gear backlash
+ * is taken up the same way it was during the sweep.
+ *
+ * Contrast is fitted as a parabola (maximum at focus). HFR follows a
+ * hyperbola, HFR^2 = A(x - c)^2 + B, so HFR^2 is fitted as a parabola
+ * (minimum at focus).
+ *
+ * The engine runs on the network task and drives one axis through the
+ * same command queue and status snapshot as the API handlers. A move
+ * that comes to rest anywhere but its target (emergency stop, changed
+ * limits, another command) fails the run instead of waiting for it.
+ */
+
+#ifndef AUTOFOCUS_H
+#define AUTOFOCUS_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "Config.h"
+
+enum FocusMetric {
+  METRIC_HFR = 0,                  // Smaller is better
+  METRIC_CONTRAST = 1              // Larger is better
+};
+
+// ----------------------------------------------------------------
+// Incremental least-squares parabola fit, y = a*x^2 + b*x + c
+// Only running sums are kept, so each sample costs O(1).
+// ----------------------------------------------------------------
+class FocusCurveFit {
+private:
+  double sx[5];                    // sum x^k, k = 0..4
+  double sxy[3];                   // sum x^k * y, k = 0..2
+  
+  static double det3(double a, double b, double c,
+                     double d, double e, double f,
+                     double g, double h, double i) {
+    return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+  }
+  
+public:
+  FocusCurveFit() { reset(); }
+  
+  void reset() {
+    for (int k = 0; k < 5; k++) sx[k] = 0;
+    for (int k = 0; k < 3; k++) sxy[k] = 0;
+  }
+  
+  void add(double x, double y) {
+    double xk = 1;
+    for (int k = 0; k < 5; k++) {
+      sx[k] += xk;
+      if (k < 3) sxy[k] += xk * y;
+      xk *= x;
+    }
+  }
+  
+  int count() const { return (int)sx[0]; }
+  
+  // Solve the normal equations; false if the samples do not determine
+  // a parabola
+  bool solve(double& a, double& b, double& c) const {
+    if (count() < 3) return false;
+    
+    double d = det3(sx[4], sx[3], sx[2], sx[3], sx[2], sx[1], sx[2], sx[1], sx[0]);
+    if (fabs(d) < 1e-9) return false;
+    
+    a = det3(sxy[2], sx[3], sx[2], sxy[1], sx[2], sx[1], sxy[0], sx[1], sx[0]) / d;
+    b = det3(sx[4], sxy[2], sx[2], sx[3], sxy[1], sx[1], sx[2], sxy[0], sx[0]) / d;
+    c = det3(sx[4], sx[3], sxy[2], sx[3], sx[2], sxy[1], sx[2], sx[1], sxy[0]) / d;
+    return true;
+  }
+};
+
+// ----------------------------------------------------------------
+// Sweep state machine
+// ----------------------------------------------------------------
+struct AutofocusParams {
+  int axis;                        // Focuser axis to sweep
+  int start;                       // First sample position
+  int step;                        // Spacing; the sign sets the sweep direction
+  int count;                       // Number of samples
+  FocusMetric metric;
+  unsigned long settle;            // ms to wait after arriving before sampling
+  int backlash;                    // Overshoot used to take up gear slack
+};
+
+enum AutofocusEventType {
+  AF_EVENT_SAMPLE = 0,             // At a sample position, send the metric
+  AF_EVENT_DONE = 1,               // At best focus
+  AF_EVENT_FAILED = 2,             // No usable fit or a move failed; the focuser stays put
+  AF_EVENT_CANCELLED = 3
+};
+
+struct AutofocusEvent {
+  AutofocusEventType type;
+  int axis;
+  int index;                       // Sample index (SAMPLE)
+  int position;
+  bool haveEstimate;
+  int estimate;                    // Best focus fitted so far / final
+  const char* message;             // Reason (FAILED)
+};
+
+class AutofocusEngine {
+private:
+  enum Phase {
+    PHASE_IDLE,
+    PHASE_MOVE,                    // Waiting for the motor to reach moveTarget
+    PHASE_SETTLE,
+    PHASE_WAIT_METRIC,
+    PHASE_FIT
+  };
+  
+  // What to do once the current move settles
+  enum AfterMove {
+    AFTER_TAKEUP_START,
+    AFTER_SAMPLE,
+    AFTER_TAKEUP_BEST,
+    AFTER_BEST
+  };
+  
+  AutofocusParams params;
+  FocusCurveFit fit;
+  Phase phase;
+  AfterMove afterMove;
+  int moveTarget;
+  bool moveIssued;
+  int index;
+  int bestPosition;
+  unsigned long settleStart;
+  unsigned long moveSentAt;
+  
+  int direction() const { return params.step > 0 ? 1 : -1; }
+  int samplePosition(int i) const { return params.start + i * params.step; }
+  
+  void moveTo(int target, AfterMove after) {
+    moveTarget = target;
+    moveIssued = false;
+    afterMove = after;
+    phase = PHASE_MOVE;
+  }
+  
+  // Fitted best focus as a position, or false if the fit is unusable
+  bool fittedBest(int& position, const char*& reason) const {
+    double a, b, c;
+    if (!fit.solve(a, b, c)) {
+      reason = "Not enough distinct samples";
+      return false;
+    }
+    
+    bool minimum = (params.metric == METRIC_HFR);
+    if ((minimum && a <= 0) || (!minimum && a >= 0)) {
+      reason = "No focus curve in sweep";
+      return false;
+    }
+    
+    // Vertex in sample-index units; allow half a step past either end,
+    // then keep it on the sweep, which is known to be within the limits
+    double x = -b / (2 * a);
+    if (x < -0.5 || x > fit.count() - 0.5) {
+      reason = "Best focus outside sweep";
+      return false;
+    }
+    x = constrain(x, 0.0, (double)(params.count - 1));
+    
+    position = params.start + (int)lround(x * params.step);
+    return true;
+  }
+  
+  AutofocusEvent makeEvent(AutofocusEventType type, int position) const {
+    AutofocusEvent event = { type, params.axis, index, position, false, 0, nullptr };
+    return event;
+  }
+  
+public:
+  AutofocusEngine() : params(), phase(PHASE_IDLE), afterMove(AFTER_SAMPLE),
+                      moveTarget(0), moveIssued(false), index(0),
+                      bestPosition(0), settleStart(0), moveSentAt(0) {}
+  
+  bool isActive() const { return phase != PHASE_IDLE; }
+  int getAxis() const { return params.axis; }
+  
+  void start(const AutofocusParams& p) {
+    params = p;
+    fit.reset();
+    index = 0;
+    moveTo(samplePosition(0) - direction() * params.backlash, AFTER_TAKEUP_START);
+  }
+  
+  // Abandon the run; returns false if nothing was running
+  bool cancel(AutofocusEvent& event) {
+    if (phase == PHASE_IDLE) return false;
+    phase = PHASE_IDLE;
+    event = makeEvent(AF_EVENT_CANCELLED, moveTarget);
+    return true;
+  }
+  
+  // Move the caller should queue for the motor; call moveSent() once it
+  // has been queued
+  bool pendingMove(int& target) const {
+    if (phase != PHASE_MOVE || moveIssued) return false;
+    target = moveTarget;
+    return true;
+  }
+  
+  void moveSent(unsigned long now) {
+    moveIssued = true;
+    moveSentAt = now;
+  }
+  
+  // Metric for the sample announced last; index < 0 skips the check
+  CommandResult addMetric(int sampleIndex, float value) {
+    if (phase != PHASE_WAIT_METRIC) {
+      return { 409, "error", "No sample pending", ERROR_NONE };
+    }
+    if (sampleIndex >= 0 && sampleIndex != index) {
+      return { 400, "error", "Wrong sample index", ERROR_NONE };
+    }
+    if (!isfinite(value) || (params.metric == METRIC_HFR && value <= 0)) {
+      return { 400, "error", "Invalid metric", ERROR_NONE };
+    }
+    
+    double y = (params.metric == METRIC_HFR) ? (double)value * value : value;
+    fit.add(index, y);
+    phase = PHASE_FIT;
+    return { 200, "success", nullptr, ERROR_NONE };
+  }
+  
+  // Advance the run; returns true when event has been filled in
+  bool poll(const MotorStatus& status, unsigned long now, AutofocusEvent& event);
+};
+
+bool AutofocusEngine::poll(const MotorStatus& status, unsigned long now, AutofocusEvent& event) {
+  switch (phase) {
+    case PHASE_IDLE:
+    case PHASE_WAIT_METRIC:
+      return false;
+      
+    case PHASE_MOVE:
+      if (!moveIssued || status.running) {
+        return false;
+      }
+      if (status.target != moveTarget || status.position != moveTarget) {
+        // At rest elsewhere once the move has had time to show in the
+        // status: it was stopped, clamped or replaced
+        if (now - moveSentAt < AUTOFOCUS_MOVE_GRACE) {
+          return false;
+        }
+        phase = PHASE_IDLE;
+        event = makeEvent(AF_EVENT_FAILED, status.position);
+        event.message = (status.state == STATE_EMERGENCY_STOP) ? "Emergency stop" : "Move did not reach its target";
+        return true;
+      }
+      
+      switch (afterMove) {
+        case AFTER_TAKEUP_START:
+          moveTo(samplePosition(0), AFTER_SAMPLE);
+          return false;
+        case AFTER_SAMPLE:
+          settleStart = now;
+          phase = PHASE_SETTLE;
+          return false;
+        case AFTER_TAKEUP_BEST:
+          moveTo(bestPosition, AFTER_BEST);
+          return false;
+        case AFTER_BEST:
+          phase = PHASE_IDLE;
+          event = makeEvent(AF_EVENT_DONE, bestPosition);
+          event.haveEstimate = true;
+          event.estimate = bestPosition;
+          return true;
+      }
+      return false;
+      
+    case PHASE_SETTLE:
+      if (now - settleStart < params.settle) {
+        return false;
+      }
+      phase = PHASE_WAIT_METRIC;
+      event = makeEvent(AF_EVENT_SAMPLE, samplePosition(index));
+      {
+        const char* reason;
+        event.haveEstimate = fittedBest(event.estimate, reason);
+      }
+      return true;
+      
+    case PHASE_FIT: {
+      if (index + 1 < params.count) {
+        index++;
+        moveTo(samplePosition(index), AFTER_SAMPLE);
+        return false;
+      }
+      
+      const char* reason = nullptr;
+      if (!fittedBest(bestPosition, reason)) {
+        phase = PHASE_IDLE;
+        event = makeEvent(AF_EVENT_FAILED, status.position);
+        event.message = reason;
+        return true;
+      }
+      moveTo(bestPosition - direction() * params.backlash, AFTER_TAKEUP_BEST);
+      return false;
+    }
+  }
+  return false;
+}
+
+#endif // AUTOFOCUS_H
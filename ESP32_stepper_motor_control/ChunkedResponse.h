@@ -0,0 +1,72 @@
+/*
+ * Chunked Response - Fixed-buffer streaming for large HTTP replies
+ *
+ * Text is collected in one RESPONSE_CHUNK_SIZE buffer and sent as an
+ * HTTP chunk whenever it fills, so a reply of any length costs the same
+ * memory. Network task only.
+ */
+
+#ifndef CHUNKED_RESPONSE_H
+#define CHUNKED_RESPONSE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <stdarg.h>
+#include "Config.h"
+
+class ChunkedResponse {
+private:
+  WebServer& server;
+  char buffer[RESPONSE_CHUNK_SIZE];
+  size_t used;
+  
+  void flush() {
+    if (used > 0) {
+      server.sendContent(buffer, used);
+      used = 0;
+    }
+  }
+  
+public:
+  // Sends the status line and headers
+  ChunkedResponse(WebServer& web, int code, const char* contentType) : server(web), used(0) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(code, contentType, "");
+  }
+  
+  void write(const char* text, size_t length) {
+    if (used + length > sizeof(buffer)) {
+      flush();
+    }
+    if (length > sizeof(buffer)) {
+      server.sendContent(text, length);
+      return;
+    }
+    memcpy(buffer + used, text, length);
+    used += length;
+  }
+  
+  void print(const char* text) {
+    write(text, strlen(text));
+  }
+  
+  // Formatted text; one call may produce up to RESPONSE_LINE_SIZE bytes
+  void printf(const char* format, ...) {
+    char line[RESPONSE_LINE_SIZE];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+      write(line, min((size_t)length, sizeof(line) - 1));
+    }
+  }
+  
+  // Sends what is buffered and the terminating chunk
+  void end() {
+    flush();
+    server.sendContent("");
+  }
+};
+
+#endif // CHUNKED_RESPONSE_H
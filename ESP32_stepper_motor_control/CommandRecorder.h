@@ -0,0 +1,213 @@
+/*
+ * Command Recorder - Ring buffer of incoming REST and WebSocket commands
+ *
+ * While recording, every POST body and WebSocket text message is stored
+ * as it arrives, with a micros() timestamp, so the command stream behind
+ * a field problem can be downloaded and replayed on a bench unit
+ * (tools/replay_commands.py). Records are variable length; when the ring
+ * fills, the oldest are dropped whole. The ring is allocated on the first
+ * start, in PSRAM when the board has it. Recording, control and export
+ * all run on the network task.
+ *
+ * Export format (GET /api/record), JSON lines, oldest first:
+ *   {"version":1,"records":2,"dropped":0,"recording":false,"now":91234567}
+ *   {"seq":1,"t":81234567,"src":"rest","uri":"/api/position","body":"{\"position\":1500}"}
+ *   {"seq":2,"t":81240012,"src":"ws","client":0,"body":"{\"cmd\":\"nudge\",\"steps\":-50}"}
+ * Bodies are JSON strings holding the text exactly as received; a
+ * "truncated":true field marks one cut at RECORDER_MAX_BODY bytes.
+ */
+
+#ifndef COMMAND_RECORDER_H
+#define COMMAND_RECORDER_H
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "Config.h"
+
+#define RECORDER_FORMAT_VERSION 1
+
+enum CommandSource {
+  COMMAND_SOURCE_REST = 0,
+  COMMAND_SOURCE_WEBSOCKET = 1
+};
+
+class CommandRecorder {
+private:
+  struct Record {
+    uint32_t sequence;
+    uint32_t time;                 // micros() on arrival
+    const char* uri;               // Route string for REST, nullptr for WebSocket
+    uint8_t source;
+    uint8_t client;                // WebSocket client number
+    uint8_t truncated;
+    uint8_t reserved;
+    uint16_t length;               // Body bytes following the record
+    uint16_t reserved2;
+  };
+  
+  uint8_t* buffer;
+  uint32_t capacity;
+  uint32_t head;                   // Where the next record goes
+  uint32_t tail;                   // Oldest record
+  uint32_t wrapAt;                 // End of the data before head wrapped to 0
+  bool wrapped;                    // Data is [tail, wrapAt) then [0, head)
+  uint32_t count;
+  uint32_t nextSequence;
+  uint32_t dropped;
+  bool recording;
+  
+  static uint32_t recordSize(uint16_t length) {
+    return (sizeof(Record) + length + 3) & ~3UL;
+  }
+  
+  const Record* at(uint32_t offset) const {
+    return (const Record*)(buffer + offset);
+  }
+  
+  uint32_t reserve(uint32_t size);
+  
+public:
+  CommandRecorder() : buffer(nullptr), capacity(0), head(0), tail(0), wrapAt(0), wrapped(false),
+                      count(0), nextSequence(1), dropped(0), recording(false) {}
+                      
+  // start() clears the ring and returns false if it cannot be allocated;
+  // stop() keeps what was recorded for download
+  bool start();
+  void stop() { recording = false; }
+  bool isRecording() const { return recording; }
+  
+  void record(CommandSource source, uint8_t client, const char* uri, const char* body, size_t length);
+  
+  // Walk the records oldest first: pass 0 to begin, then the returned
+  // cursor; 0 means done
+  uint32_t first() const { return count > 0 ? tail + 1 : 0; }
+  uint32_t next(uint32_t cursor) const;
+  
+  uint32_t getCount() const { return count; }
+  uint32_t getDropped() const { return dropped; }
+  
+  // Write one record as a JSON line; Writer needs write(text, length)
+  // and printf()
+  template<typename Writer>
+  void writeRecord(Writer& out, uint32_t cursor) const;
+};
+
+bool CommandRecorder::start() {
+  if (buffer == nullptr) {
+    if (psramFound()) {
+      buffer = (uint8_t*)heap_caps_malloc(RECORDER_PSRAM_SIZE, MALLOC_CAP_SPIRAM);
+      capacity = RECORDER_PSRAM_SIZE;
+    }
+    if (buffer == nullptr) {
+      buffer = (uint8_t*)malloc(RECORDER_RAM_SIZE);
+      capacity = RECORDER_RAM_SIZE;
+    }
+    if (buffer == nullptr) {
+      capacity = 0;
+      return false;
+    }
+  }
+  
+  head = tail = 0;
+  wrapAt = capacity;
+  wrapped = false;
+  count = 0;
+  nextSequence = 1;
+  dropped = 0;
+  recording = true;
+  return true;
+}
+
+// Make room for size contiguous bytes, dropping the oldest records as
+// needed; returns the offset to write at
+uint32_t CommandRecorder::reserve(uint32_t size) {
+  for (;;) {
+    if (!wrapped) {
+      if (capacity - head >= size) return head;
+      if (count == 0) {
+        head = tail = 0;
+        continue;
+      }
+      wrapAt = head;
+      head = 0;
+      wrapped = true;
+    } else {
+      if (tail - head >= size) return head;
+      tail += recordSize(at(tail)->length);
+      count--;
+      dropped++;
+      if (tail >= wrapAt) {
+        tail = 0;
+        wrapped = false;
+      }
+    }
+  }
+}
+
+void CommandRecorder::record(CommandSource source, uint8_t client, const char* uri,
+                             const char* body, size_t length) {
+  if (!recording) return;
+  
+  bool truncated = length > RECORDER_MAX_BODY;
+  if (truncated) length = RECORDER_MAX_BODY;
+  
+  uint32_t size = recordSize(length);
+  uint32_t offset = reserve(size);
+  Record* r = (Record*)(buffer + offset);
+  r->sequence = nextSequence++;
+  r->time = micros();
+  r->uri = uri;
+  r->source = source;
+  r->client = client;
+  r->truncated = truncated;
+  r->reserved = 0;
+  r->length = length;
+  r->reserved2 = 0;
+  memcpy(r + 1, body, length);
+  
+  head = offset + size;
+  count++;
+}
+
+// Cursors are offset + 1 so that 0 can mean done
+uint32_t CommandRecorder::next(uint32_t cursor) const {
+  uint32_t offset = cursor - 1;
+  offset += recordSize(at(offset)->length);
+  if (wrapped && offset >= wrapAt) {
+    offset = 0;
+  }
+  return offset == head ? 0 : offset + 1;
+}
+
+template<typename Writer>
+void CommandRecorder::writeRecord(Writer& out, uint32_t cursor) const {
+  const Record* r = at(cursor - 1);
+  if (r->source == COMMAND_SOURCE_REST) {
+    out.printf("{\"seq\":%lu,\"t\":%lu,\"src\":\"rest\",\"uri\":\"%s\",\"body\":\"",
+               (unsigned long)r->sequence, (unsigned long)r->time, r->uri);
+  } else {
+    out.printf("{\"seq\":%lu,\"t\":%lu,\"src\":\"ws\",\"client\":%u,\"body\":\"",
+               (unsigned long)r->sequence, (unsigned long)r->time, r->client);
+  }
+  
+  // Escape the body as a JSON string, copying plain runs in one go
+  const char* body = (const char*)(r + 1);
+  uint16_t start = 0;
+  for (uint16_t i = 0; i < r->length; i++) {
+    uint8_t c = body[i];
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+    out.write(body + start, i - start);
+    if (c == '"' || c == '\\') {
+      char escaped[2] = { '\\', (char)c };
+      out.write(escaped, 2);
+    } else {
+      out.printf("\\u%04x", c);
+    }
+    start = i + 1;
+  }
+  out.write(body + start, r->length - start);
+  const char* end = r->truncated ? "\",\"truncated\":true}\n" : "\"}\n";
+  out.write(end, strlen(end));
+}
+
+#endif // COMMAND_RECORDER_H
@@ -13,20 +13,119 @@
 #define WIFI_CHECK_INTERVAL 30000      // Check WiFi every 30 seconds (ms)
 #define WIFI_CONNECT_ATTEMPTS 20       // Max connection attempts
 #define REBOOT_DELAY 500               // Delay before reboot (ms)
-#define STATUS_UPDATE_INTERVAL 100     // WebSocket status update interval (ms)
-#define POSITION_SAVE_INTERVAL 5000    // Save position every 5 seconds (ms)
+#define STATUS_MOVING_INTERVAL 50      // Fastest WebSocket status rate while changing (ms)
+#define STATUS_HEARTBEAT_INTERVAL 5000 // Repeat an unchanged status this often (ms)
+#define STATUS_MAX_CLIENTS 5           // Matches WEBSOCKETS_SERVER_CLIENT_MAX
+#define STATUS_JSON_BUFFER_SIZE 256    // Encoded status is ~180 bytes
+#define STATUS_FRAME_VERSION 1         // Binary status frame layout version
+#define STATUS_FRAME_MAX_SIZE 32       // Largest binary status frame (bytes)
+#define MOTION_TASK_INTERVAL 5         // Motion task wakes at least every 5 ms
 
 // ----------------------------------------------------------------
 // Motor Constants
+// Positions and limits are in steps of the drive mode (see Drive
+// Mode), so they scale with it. Speed, acceleration and jerk are in
+// half-steps whatever the drive mode.
 // ----------------------------------------------------------------
-#define DEFAULT_MAX_STEPS 20000
-#define DEFAULT_STEPS_PER_ROTATION 4096
+#define DEFAULT_MAX_STEPS (10000 * STEPS_PER_FULL_STEP)
+#define DEFAULT_STEPS_PER_ROTATION (2048 * STEPS_PER_FULL_STEP)
 #define DEFAULT_SPEED 100
 #define MIN_SPEED 50
-#define MAX_SPEED 600
+#define MAX_SPEED 1000                 // Timer-driven stepping holds 1 ms intervals
+#define DEFAULT_ACCELERATION 2000      // steps/s^2
+#define DEFAULT_JERK 20000             // steps/s^3 (0 = trapezoidal profile)
+
+// Backlash compensation (see StepperMotor.h)
+#define DEFAULT_BACKLASH_MODE BACKLASH_OFF
+#define DEFAULT_BACKLASH_STEPS 0
+#define DEFAULT_BACKLASH_DIRECTION 1   // Overshoot mode approaches moving +
 
 // Soft limit warning zone
-#define SOFT_LIMIT_WARNING 500         // Warn when within 500 steps of limit
+#define SOFT_LIMIT_WARNING (250 * STEPS_PER_FULL_STEP)  // Warn within 500 half-steps of a limit
+
+// ----------------------------------------------------------------
+// Task Layout
+// Motion control (and its step interrupt) runs on core 1; WiFi, web
+// serving and persistence run on core 0.
+// ----------------------------------------------------------------
+#define MOTION_TASK_CORE 1
+#define MOTION_TASK_PRIORITY (configMAX_PRIORITIES - 2)
+#define MOTION_TASK_STACK 4096
+#define NETWORK_TASK_CORE 0
+#define NETWORK_TASK_PRIORITY 1
+#define NETWORK_TASK_STACK 8192
+#define COMMAND_QUEUE_SIZE 16          // Must be a power of two
+
+// ----------------------------------------------------------------
+// Motion Sequences
+// ----------------------------------------------------------------
+#define SEQUENCE_MAX_LEGS 16
+#define SEQUENCE_EVENT_QUEUE_SIZE 16   // Must be a power of two
+#define SEQUENCE_JSON_SIZE 1536        // JSON pool for a full sequence request
+
+// ----------------------------------------------------------------
+// Position Journal (flash partition from partitions.csv)
+// ----------------------------------------------------------------
+#define JOURNAL_PARTITION_LABEL "poslog"
+#define JOURNAL_SECTOR_SIZE 4096       // Flash erase unit
+
+// ----------------------------------------------------------------
+// Configuration Store (see ConfigStore.h)
+// ----------------------------------------------------------------
+#define CONFIG_NAMESPACE "stepper"
+#define CONFIG_BLOB_KEY "config"
+#define CONFIG_SCHEMA_VERSION 3
+#define CONFIG_FLUSH_DELAY 1000        // Write once settings are quiet this long
+#define CONFIG_FLUSH_MAX_DELAY 5000    // ...or at the latest this long after a change
+#define CONFIG_FLUSH_RETRY 250         // Check again this often while a motor moves
+#define CONFIG_TASK_PRIORITY 1         // Flushes run on NETWORK_TASK_CORE
+#define CONFIG_TASK_STACK 3072
+
+// ----------------------------------------------------------------
+// Step Trace (see StepTrace.h)
+// ----------------------------------------------------------------
+#define TRACE_STAGING_SIZE 256         // Steps the interrupt can queue; power of two
+#define TRACE_PSRAM_RECORDS 262144     // 2 MB ring when the board has PSRAM
+#define TRACE_RAM_RECORDS 4096         // 32 KB ring in internal RAM otherwise
+#define TRACE_EXPORT_CHUNK 256         // Records per write when streaming
+
+// ----------------------------------------------------------------
+// Command Recorder (see CommandRecorder.h)
+// ----------------------------------------------------------------
+#define RECORDER_PSRAM_SIZE 262144     // 256 KB ring when the board has PSRAM
+#define RECORDER_RAM_SIZE 16384        // 16 KB ring in internal RAM otherwise
+#define RECORDER_MAX_BODY 1024         // Longer bodies are cut (the API rejects them anyway)
+
+// ----------------------------------------------------------------
+// Streamed HTTP Responses (see ChunkedResponse.h)
+// ----------------------------------------------------------------
+#define RESPONSE_CHUNK_SIZE 512        // Bytes buffered per HTTP chunk
+#define RESPONSE_LINE_SIZE 192         // Longest single formatted piece
+
+// ----------------------------------------------------------------
+// Metrics (see Metrics.h)
+// ----------------------------------------------------------------
+#define METRICS_BUCKETS 21             // Power-of-two buckets, 1 us to ~1 s
+#define METRICS_MAX_ROUTES 32          // Timed /api routes
+#define METRICS_LABELS_SIZE 96         // Longest label set, e.g. method and path
+
+// ----------------------------------------------------------------
+// Loop Profiler (see Profiler.h)
+// Off by default; set to 1 to build in cycle-counter timing and
+// /api/profile data
+// ----------------------------------------------------------------
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0
+#endif
+#define PROFILER_WORST_COUNT 8         // Slowest network passes kept
+#define BENCH_ITERATIONS 1000          // Calls per /api/profile/bench case
+
+// ----------------------------------------------------------------
+// Autofocus
+// ----------------------------------------------------------------
+#define AUTOFOCUS_MAX_SAMPLES 100
+#define AUTOFOCUS_BACKLASH_STEPS (100 * STEPS_PER_FULL_STEP)  // Overshoot before approaching a position
+#define AUTOFOCUS_MOVE_GRACE 1000      // ms for a move to start before resting off target fails a run
 
 // ----------------------------------------------------------------
 // Pin Configuration (ULN2003)
@@ -37,10 +136,120 @@
 #define PIN_D GPIO_NUM_4
 
 // ----------------------------------------------------------------
-// ULN2003 Half-Step Sequence (8 steps per full step)
+// Axes
+// Each axis is a motor on its own ULN2003 board. Axis 0 is the focuser
+// (the web UI and commands without an "axis" field drive it); more can
+// run a filter wheel, dew shield or second focuser. All axes share the
+// drive mode and one step timer (see StepScheduler.h).
+// ----------------------------------------------------------------
+#ifndef AXIS_COUNT
+#define AXIS_COUNT 1
+#endif
+#define ALL_AXES -1                    // Emergency stop on every axis
+
+struct CoilPins {
+  uint8_t a, b, c, d;
+};
+
+constexpr CoilPins axisPins[] = {
+  { PIN_A, PIN_B, PIN_C, PIN_D },              // Axis 0
+  { GPIO_NUM_5, GPIO_NUM_6, GPIO_NUM_7, GPIO_NUM_8 }   // Axis 1 (D4, D5, D8, D9)
+};
+
+static_assert(AXIS_COUNT >= 1 && AXIS_COUNT <= sizeof(axisPins) / sizeof(axisPins[0]),
+              "Add coil pins to axisPins for every axis");
+              
+// ----------------------------------------------------------------
+// Drive Mode (see DriveMode.h)
+// DRIVE_MODE picks the coil sequence StepperMotor is compiled for:
+//   DRIVE_WAVE       one coil at a time, 4 steps per electrical cycle;
+//                    least current
+//   DRIVE_FULL_STEP  two coils at a time, 4 steps; most torque, for
+//                    fast slews
+//   DRIVE_HALF_STEP  one and two coils alternately, 8 steps (default)
+//   DRIVE_MICROSTEP  sine/cosine weighted LEDC PWM on every coil,
+//                    MICROSTEPS (16 or 32) per half-step; finest and
+//                    quietest, for focusing
+// A step is one step of the chosen mode: positions and limits are
+// counted in them, and saved ones are rescaled at boot when the mode
+// changes (see ConfigStore.h). Speed, acceleration and jerk are always
+// in half-steps.
+// ----------------------------------------------------------------
+#define DRIVE_WAVE 0
+#define DRIVE_FULL_STEP 1
+#define DRIVE_HALF_STEP 2
+#define DRIVE_MICROSTEP 3
+
+#ifndef DRIVE_MODE
+#define DRIVE_MODE DRIVE_HALF_STEP
+#endif
+#ifndef MICROSTEPS
+#define MICROSTEPS 16
+#endif
+static_assert(DRIVE_MODE >= DRIVE_WAVE && DRIVE_MODE <= DRIVE_MICROSTEP, "Unknown DRIVE_MODE");
+static_assert(MICROSTEPS == 16 || MICROSTEPS == 32, "MICROSTEPS must be 16 or 32");
+
+// Steps per full step (a quarter of an electrical cycle) in a mode
+constexpr int stepsPerFullStep(int mode, int microsteps) {
+  return mode == DRIVE_MICROSTEP ? 2 * microsteps : mode == DRIVE_HALF_STEP ? 2 : 1;
+}
+
+// Phase 0 of full-step drive sits half a step past coil A
+constexpr int phaseOffsetHalves(int mode) {
+  return mode == DRIVE_FULL_STEP ? 1 : 0;
+}
+
+#define STEPS_PER_FULL_STEP stepsPerFullStep(DRIVE_MODE, MICROSTEPS)
+#define PHASE_COUNT (4 * STEPS_PER_FULL_STEP)  // Coil phases per electrical cycle
+
+#define PWM_FREQUENCY 20000            // Microstepping PWM, above hearing
+#define PWM_RESOLUTION 10              // Duty bits
+#define PWM_CHANNEL_A 0                // LEDC channel per coil pin, axis 0;
+#define PWM_CHANNEL_B 1                // axis n adds 4 * n
+#define PWM_CHANNEL_C 2
+#define PWM_CHANNEL_D 3
+#define PWM_CHANNELS_PER_AXIS 4
+#define PWM_CHANNEL_COUNT 8            // LEDC channels on the ESP32-S3
+static_assert(DRIVE_MODE != DRIVE_MICROSTEP || AXIS_COUNT * PWM_CHANNELS_PER_AXIS <= PWM_CHANNEL_COUNT,
+              "Not enough LEDC channels to microstep every axis");
+
+// ----------------------------------------------------------------
+// Step Streaming (see StepStream.h)
+// Off by default; set to 1 to have the RMT play precomputed coil
+// waveforms instead of stepping from an interrupt. Switched drive modes
+// and a single axis only.
+// ----------------------------------------------------------------
+#ifndef STEP_STREAM
+#define STEP_STREAM 0
+#endif
+#define STREAM_RESOLUTION_HZ 1000000   // RMT tick = 1 us, as the step timer
+#define STREAM_MAX_HALF 500            // Longest RMT symbol half (ticks); bounds read-ahead
+#define STREAM_SCRATCH_SYMBOLS 8       // Symbols the encoder expands per coil at a time
+#define STREAM_SEGMENTS 8              // Segments of planned steps in the ring
+#define STREAM_SEGMENT_STEPS 64        // Steps per segment, at most
+#define STREAM_SEGMENT_US 20000        // A segment closes once it spans this long (us)
+#define STREAM_LOOKAHEAD_US 100000     // Steps planned this far ahead of playback (us)
+static_assert(!STEP_STREAM || (DRIVE_MODE != DRIVE_MICROSTEP && AXIS_COUNT == 1),
+              "Step streaming drives one axis in a switched drive mode");
+              
 // ----------------------------------------------------------------
-#define STEPS_IN_SEQUENCE 8
-const int stepSequence[8][4] = {
+// ULN2003 Coil Sequences (one row per step, coils A B C D)
+// ----------------------------------------------------------------
+constexpr int waveSequence[4][4] = {
+  {1, 0, 0, 0},
+  {0, 1, 0, 0},
+  {0, 0, 1, 0},
+  {0, 0, 0, 1}
+};
+
+constexpr int fullStepSequence[4][4] = {
+  {1, 1, 0, 0},
+  {0, 1, 1, 0},
+  {0, 0, 1, 1},
+  {1, 0, 0, 1}
+};
+
+constexpr int stepSequence[8][4] = {
   {1, 0, 0, 0},
   {1, 1, 0, 0},
   {0, 1, 0, 0},
@@ -51,6 +260,36 @@ const int stepSequence[8][4] = {
   {1, 0, 0, 1}
 };
 
+// Sequences are compiled into GPIO_OUT register bit patterns for each
+// axis's pins (see DriveMode.h), so each step updates all four coils
+// with one clear and one set register write
+constexpr uint32_t coilPattern(const CoilPins& pins, const int (&coils)[4]) {
+  return (coils[0] ? (1UL << pins.a) : 0) |
+         (coils[1] ? (1UL << pins.b) : 0) |
+         (coils[2] ? (1UL << pins.c) : 0) |
+         (coils[3] ? (1UL << pins.d) : 0);
+}
+
+constexpr uint32_t coilMask(const CoilPins& pins) {
+  return (1UL << pins.a) | (1UL << pins.b) | (1UL << pins.c) | (1UL << pins.d);
+}
+
+constexpr bool coilPinsInGpioOut(int axis = 0) {
+  return axis >= AXIS_COUNT ||
+         (axisPins[axis].a < 32 && axisPins[axis].b < 32 && axisPins[axis].c < 32 &&
+          axisPins[axis].d < 32 && coilPinsInGpioOut(axis + 1));
+}
+static_assert(coilPinsInGpioOut(), "Coil pins must live in the low GPIO_OUT register");
+
+// Speeds that excite resonance, in half-steps/s whatever the drive
+// mode. A move never cruises inside a band; it cruises at the band's
+// lower edge instead (acceleration still passes through). Find them by
+// ear or with the step trace for the motor and load in use.
+#define RESONANCE_BAND_COUNT 1
+constexpr int resonanceBands[RESONANCE_BAND_COUNT][2] = {
+  { 0, 0 }                       // { low, high }; an empty band is ignored
+};
+
 // ----------------------------------------------------------------
 // Error Codes
 // ----------------------------------------------------------------
@@ -76,6 +315,42 @@ enum MotorState {
   STATE_EMERGENCY_STOP = 3
 };
 
+// ----------------------------------------------------------------
+// WebSocket Status Formats
+// ----------------------------------------------------------------
+enum StatusFormat {
+  STATUS_FORMAT_JSON = 0,
+  STATUS_FORMAT_BINARY = 1
+};
+
+// ----------------------------------------------------------------
+// Backlash Compensation Modes
+// ----------------------------------------------------------------
+enum BacklashMode {
+  BACKLASH_OFF = 0,
+  BACKLASH_OVERSHOOT = 1,        // Final approach always from one direction
+  BACKLASH_SLACK = 2             // Extra steps across the gear gap on reversal
+};
+
+// ----------------------------------------------------------------
+// Motion Commands (web handlers -> motion task)
+// ----------------------------------------------------------------
+enum MotionCommandType {
+  CMD_SET_TARGET = 0,
+  CMD_NUDGE = 1,
+  CMD_SET_SPEED = 2,
+  CMD_SET_POSITION = 3,
+  CMD_EMERGENCY_STOP = 4,
+  CMD_SET_MAX_STEPS = 5,
+  CMD_SET_STEPS_PER_ROT = 6,
+  CMD_RUN_SEQUENCE = 7,          // Start the sequence waiting in the handoff slot
+  CMD_SET_BACKLASH_MODE = 8,
+  CMD_SET_BACKLASH_STEPS = 9,
+  CMD_SET_BACKLASH_DIRECTION = 10,
+  CMD_SET_TRACE = 11,            // 1 = start a step trace of the axis, 0 = stop it
+  CMD_MOVE_COORDINATED = 12      // Start the move waiting in the handoff slot
+};
+
 // ----------------------------------------------------------------
 // Configuration Structures
 // ----------------------------------------------------------------
@@ -94,9 +369,43 @@ struct MotorConfig {
   int minSpeed;
   int maxSpeed;
   int softLimitWarning;
+  int acceleration;
+  int jerk;
+  BacklashMode backlashMode;
+  int backlashSteps;
+  int backlashDirection;           // Preferred final approach, 1 or -1
+};
+
+struct MotionCommand {
+  MotionCommandType type;
+  int value;
+  int axis;                        // 0..AXIS_COUNT-1, or ALL_AXES
+};
+
+// Outcome of an API command, sent as an HTTP response or WebSocket ack
+struct CommandResult {
+  int code;
+  const char* status;
+  const char* message;
+  ErrorCode error;
+};
+
+// Motor state published by the motion task for the web side
+struct MotorStatus {
+  int position;
+  int target;
+  int speed;
+  MotorState state;
+  bool running;
+  int maxSteps;
+  int stepsPerRotation;
+  bool nearLimit;
+  int phase;                     // Coil sequence index, for the position journal
+  int axis;
 };
 
 struct LogEntry {
+  uint32_t sequence;               // Increases by one per entry, never reused
   unsigned long timestamp;
   int position;
   int targetPosition;
@@ -109,5 +418,6 @@ struct LogEntry {
 // Logging
 // ----------------------------------------------------------------
 #define LOG_BUFFER_SIZE 50
+#define LOG_PAGE_DEFAULT 20            // Entries per /api/logs page unless limit is given
 
 #endif // CONFIG_H
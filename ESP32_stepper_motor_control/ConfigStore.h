@@ -0,0 +1,298 @@
+/*
+ * Configuration Store - Typed, versioned, write-behind settings
+ *
+ * Each axis's motor settings live in one versioned NVS blob ("config"
+ * for axis 0, "config1", ... for the others). They are loaded once at
+ * boot; after that reads come from RAM and set() only updates RAM and
+ * wakes the flush task. The flush task waits until changes have stopped
+ * for CONFIG_FLUSH_DELAY (or CONFIG_FLUSH_MAX_DELAY has passed since the
+ * first one), then writes each changed axis's blob once, so a slider
+ * drag costs one NVS write and never blocks a request handler or the
+ * motor. A flash write stalls everything running from flash on both
+ * cores, so the write also waits until the atRest callback given to
+ * begin() reports every axis stopped, checking again every
+ * CONFIG_FLUSH_RETRY while one moves.
+ *
+ * Schema: version 0 is the per-key layout of older firmware ("maxSteps",
+ * "speed", ...). It is migrated into axis 0's blob on first boot; other
+ * axes start from the defaults. Version 2
+ * added the MICROSTEPS setting the step counts were saved under, and
+ * version 3 replaced it with the drive mode and its steps per full
+ * step. When the firmware's drive mode differs, step counts are rescaled
+ * at boot, and toCurrentUnits() and toCurrentPhase() convert the saved
+ * position and coil phase the same way. Bump
+ * CONFIG_SCHEMA_VERSION and add a step to migrate() when the layout
+ * changes.
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <stddef.h>
+#include "Config.h"
+
+class ConfigStore {
+private:
+  // Persisted layout, version 3 - fixed-width fields only
+  struct StoredConfig {
+    uint16_t version;
+    uint16_t size;
+    int32_t maxSteps;
+    int32_t stepsPerRotation;
+    int32_t speed;
+    int32_t acceleration;
+    int32_t jerk;
+    int32_t backlashMode;
+    int32_t backlashSteps;
+    int32_t backlashDirection;
+    int32_t stepsPerFullStep;      // Version 2 stored MICROSTEPS here
+    int32_t driveMode;             // Version 3
+  };
+  
+  Preferences prefs;
+  MotorConfig configs[AXIS_COUNT];
+  bool (*atRest)();                // Every axis stopped, or nullptr
+  portMUX_TYPE lock;
+  TaskHandle_t flushTaskHandle;
+  uint32_t dirty;                  // Bit n = axis n changed since its last write
+  int savedStepsPerFullStep[AXIS_COUNT];   // Units the stored step counts were in
+  int savedDriveMode[AXIS_COUNT];
+  
+  static void flushTask(void* param);
+  static const char* blobKey(int axis, char* buffer);
+  int32_t legacyInt(int axis, const char* key, int32_t fallback);
+  bool migrate(int axis, StoredConfig& stored);
+  void rescale(int axis, StoredConfig& stored);
+  void fromStored(int axis, const StoredConfig& stored);
+  StoredConfig toStored(int axis) const;
+  
+public:
+  ConfigStore() : configs(), atRest(nullptr), lock(portMUX_INITIALIZER_UNLOCKED), flushTaskHandle(nullptr), dirty(0) {
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      savedStepsPerFullStep[axis] = STEPS_PER_FULL_STEP;
+      savedDriveMode[axis] = DRIVE_MODE;
+    }
+  }
+  
+  // Load (migrating if needed) and start the flush task, which only
+  // writes while atRest() (if given) returns true
+  void begin(bool (*atRest)() = nullptr);
+  
+  // Copy of an axis's current settings
+  MotorConfig get(int axis) {
+    portENTER_CRITICAL(&lock);
+    MotorConfig copy = configs[axis];
+    portEXIT_CRITICAL(&lock);
+    return copy;
+  }
+  
+  // Change one field, e.g. set(0, &MotorConfig::maxSteps, 30000). The
+  // NVS write happens later on the flush task.
+  template<typename T>
+  void set(int axis, T MotorConfig::*field, T value) {
+    portENTER_CRITICAL(&lock);
+    bool changed = !(configs[axis].*field == value);
+    configs[axis].*field = value;
+    if (changed) dirty |= 1UL << axis;
+    portEXIT_CRITICAL(&lock);
+    
+    if (changed && flushTaskHandle != nullptr) {
+      xTaskNotifyGive(flushTaskHandle);
+    }
+  }
+  
+  // Write the changed axes now - call before a deliberate restart
+  void flush();
+  
+  // The flush task's write: flush() if every axis is at rest, else
+  // false to try again later
+  bool flushIfQuiet();
+  
+  // A step count or coil phase saved before this boot, in the current
+  // firmware's drive mode
+  bool unitsChanged(int axis) const {
+    return savedStepsPerFullStep[axis] != STEPS_PER_FULL_STEP || savedDriveMode[axis] != DRIVE_MODE;
+  }
+  int toCurrentUnits(int axis, int steps) const {
+    return (int)((int64_t)steps * STEPS_PER_FULL_STEP / savedStepsPerFullStep[axis]);
+  }
+  int toCurrentPhase(int axis, int phase) const;
+};
+
+void ConfigStore::begin(bool (*atRest)()) {
+  this->atRest = atRest;
+  prefs.begin(CONFIG_NAMESPACE, false);
+  
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    MotorConfig& config = configs[axis];
+    config.minSpeed = MIN_SPEED;
+    config.maxSpeed = MAX_SPEED;
+    config.softLimitWarning = SOFT_LIMIT_WARNING;
+  
+    char key[16];
+    StoredConfig stored;
+    memset(&stored, 0, sizeof(stored));
+    size_t length = prefs.getBytes(blobKey(axis, key), &stored, sizeof(stored));
+    if (length < offsetof(StoredConfig, maxSteps) || stored.size != length) {
+      stored.version = 0;          // No blob (or a damaged one) - older firmware
+    }
+    
+    bool migrated = migrate(axis, stored);
+    if (stored.stepsPerFullStep != STEPS_PER_FULL_STEP || stored.driveMode != DRIVE_MODE) {
+      rescale(axis, stored);
+      migrated = true;
+    }
+    fromStored(axis, stored);
+    if (migrated) {
+      dirty |= 1UL << axis;
+    }
+  }
+  flush();
+  
+  xTaskCreatePinnedToCore(flushTask, "config", CONFIG_TASK_STACK, this,
+                          CONFIG_TASK_PRIORITY, &flushTaskHandle, NETWORK_TASK_CORE);
+}
+
+const char* ConfigStore::blobKey(int axis, char* buffer) {
+  if (axis == 0) return CONFIG_BLOB_KEY;
+  sprintf(buffer, CONFIG_BLOB_KEY "%d", axis);
+  return buffer;
+}
+
+// Older firmware's per-key setting; only axis 0 has them
+int32_t ConfigStore::legacyInt(int axis, const char* key, int32_t fallback) {
+  return axis == 0 ? prefs.getInt(key, fallback) : fallback;
+}
+
+// Bring stored up to CONFIG_SCHEMA_VERSION; returns true if it changed
+bool ConfigStore::migrate(int axis, StoredConfig& stored) {
+  if (stored.version == CONFIG_SCHEMA_VERSION) {
+    return false;
+  }
+  
+  if (stored.version == 0 || stored.version > CONFIG_SCHEMA_VERSION) {
+    // Per-key layout (a newer blob we cannot read also starts from here).
+    // Older firmware only half-stepped, so defaults go in as half-steps
+    // and are rescaled with the rest.
+    stored.maxSteps = legacyInt(axis, "maxSteps", DEFAULT_MAX_STEPS * 2 / STEPS_PER_FULL_STEP);
+    stored.stepsPerRotation = legacyInt(axis, "stepsPerRot", DEFAULT_STEPS_PER_ROTATION * 2 / STEPS_PER_FULL_STEP);
+    stored.speed = legacyInt(axis, "speed", DEFAULT_SPEED);
+    stored.acceleration = legacyInt(axis, "accel", DEFAULT_ACCELERATION);
+    stored.jerk = legacyInt(axis, "jerk", DEFAULT_JERK);
+    stored.backlashMode = legacyInt(axis, "blMode", DEFAULT_BACKLASH_MODE);
+    stored.backlashSteps = legacyInt(axis, "blSteps", DEFAULT_BACKLASH_STEPS);
+    stored.backlashDirection = legacyInt(axis, "blDir", DEFAULT_BACKLASH_DIRECTION);
+    stored.stepsPerFullStep = 2;
+    stored.driveMode = DRIVE_HALF_STEP;
+  } else if (stored.version == 1) {
+    stored.stepsPerFullStep = 2;
+    stored.driveMode = DRIVE_HALF_STEP;
+  } else if (stored.version == 2) {
+    int microsteps = stored.stepsPerFullStep;
+    stored.stepsPerFullStep = 2 * microsteps;
+    stored.driveMode = microsteps > 1 ? DRIVE_MICROSTEP : DRIVE_HALF_STEP;
+  }
+  
+  stored.version = CONFIG_SCHEMA_VERSION;
+  stored.size = sizeof(StoredConfig);
+  return true;
+}
+
+// Convert step counts saved under another drive mode
+void ConfigStore::rescale(int axis, StoredConfig& stored) {
+  savedStepsPerFullStep[axis] = stored.stepsPerFullStep > 0 ? stored.stepsPerFullStep : 2;
+  savedDriveMode[axis] = stored.driveMode;
+  stored.maxSteps = toCurrentUnits(axis, stored.maxSteps);
+  stored.stepsPerRotation = toCurrentUnits(axis, stored.stepsPerRotation);
+  stored.backlashSteps = toCurrentUnits(axis, stored.backlashSteps);
+  stored.stepsPerFullStep = STEPS_PER_FULL_STEP;
+  stored.driveMode = DRIVE_MODE;
+}
+
+// Nearest coil phase at or below the saved one's electrical angle,
+// worked in half steps of each mode so full-step drive's half-step
+// offset comes out exact
+int ConfigStore::toCurrentPhase(int axis, int phase) const {
+  int64_t halves = (int64_t)(2 * phase + phaseOffsetHalves(savedDriveMode[axis])) * STEPS_PER_FULL_STEP
+                   / savedStepsPerFullStep[axis] - phaseOffsetHalves(DRIVE_MODE);
+  return (int)((halves >> 1) & (PHASE_COUNT - 1));
+}
+
+void ConfigStore::fromStored(int axis, const StoredConfig& stored) {
+  MotorConfig& config = configs[axis];
+  config.maxSteps = stored.maxSteps > 0 ? stored.maxSteps : DEFAULT_MAX_STEPS;
+  config.stepsPerRotation = stored.stepsPerRotation > 0 ? stored.stepsPerRotation : DEFAULT_STEPS_PER_ROTATION;
+  config.defaultSpeed = (stored.speed >= MIN_SPEED && stored.speed <= MAX_SPEED) ? stored.speed : DEFAULT_SPEED;
+  config.acceleration = stored.acceleration > 0 ? stored.acceleration : DEFAULT_ACCELERATION;
+  config.jerk = stored.jerk >= 0 ? stored.jerk : DEFAULT_JERK;
+  config.backlashMode = (stored.backlashMode >= BACKLASH_OFF && stored.backlashMode <= BACKLASH_SLACK)
+    ? (BacklashMode)stored.backlashMode : BACKLASH_OFF;
+  config.backlashSteps = stored.backlashSteps >= 0 ? stored.backlashSteps : 0;
+  config.backlashDirection = (stored.backlashDirection < 0) ? -1 : 1;
+}
+
+ConfigStore::StoredConfig ConfigStore::toStored(int axis) const {
+  const MotorConfig& config = configs[axis];
+  StoredConfig stored;
+  memset(&stored, 0, sizeof(stored));
+  stored.version = CONFIG_SCHEMA_VERSION;
+  stored.size = sizeof(StoredConfig);
+  stored.maxSteps = config.maxSteps;
+  stored.stepsPerRotation = config.stepsPerRotation;
+  stored.speed = config.defaultSpeed;
+  stored.acceleration = config.acceleration;
+  stored.jerk = config.jerk;
+  stored.backlashMode = config.backlashMode;
+  stored.backlashSteps = config.backlashSteps;
+  stored.backlashDirection = config.backlashDirection;
+  stored.stepsPerFullStep = STEPS_PER_FULL_STEP;
+  stored.driveMode = DRIVE_MODE;
+  return stored;
+}
+
+void ConfigStore::flush() {
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    portENTER_CRITICAL(&lock);
+    bool changed = dirty & (1UL << axis);
+    dirty &= ~(1UL << axis);
+    StoredConfig stored = toStored(axis);
+    portEXIT_CRITICAL(&lock);
+    if (!changed) continue;
+  
+    char key[16];
+    if (prefs.putBytes(blobKey(axis, key), &stored, sizeof(stored)) != sizeof(stored)) {
+      Serial.printf("ERROR: Config write failed (axis %d)!\n", axis);
+    }
+  }
+}
+
+bool ConfigStore::flushIfQuiet() {
+  if (atRest != nullptr && !atRest()) {
+    return false;
+  }
+  flush();
+  return true;
+}
+
+// Coalesce bursts of changes into one write, made while nothing moves
+void ConfigStore::flushTask(void* param) {
+  ConfigStore* store = static_cast<ConfigStore*>(param);
+  
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    
+    TickType_t first = xTaskGetTickCount();
+    while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_FLUSH_DELAY)) > 0 &&
+           xTaskGetTickCount() - first < pdMS_TO_TICKS(CONFIG_FLUSH_MAX_DELAY)) {
+      // Still changing - keep waiting
+    }
+    
+    while (!store->flushIfQuiet()) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_FLUSH_RETRY));
+    }
+  }
+}
+
+#endif // CONFIG_STORE_H
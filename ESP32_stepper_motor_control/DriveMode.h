@@ -0,0 +1,161 @@
+/*
+ * Drive Modes - Coil sequencing policies for StepperMotor
+ *
+ * StepperMotor is a template over one of these, picked by DRIVE_MODE in
+ * Config.h, so the step path is compiled for a single coil sequence.
+ * Each motor owns an instance bound to its axis's coil pins, with:
+ *   PHASES             coil phases per electrical cycle; a power of two
+ *                      so the step path wraps the phase with a mask
+ *   begin(pins, axis)  set up the coil pins
+ *   drive(phase)       energise the coils for a phase (step interrupt)
+ *   release()          all coils off (step interrupt)
+ */
+
+#ifndef DRIVE_MODE_H
+#define DRIVE_MODE_H
+
+#include <Arduino.h>
+#include <soc/gpio_reg.h>
+#include "Config.h"
+#if DRIVE_MODE == DRIVE_MICROSTEP
+#include <hal/ledc_ll.h>
+#endif
+
+// ----------------------------------------------------------------
+// Set stepper motor coil states
+// Coils going off are cleared through GPIO_OUT_W1TC and coils coming on
+// set through GPIO_OUT_W1TS. Each store only touches its own bits, so
+// there is no read of GPIO_OUT and nothing to race with other pins'
+// writers; a coil on in both phases is never touched, and the driver
+// never sees more than the two phases' coils at once.
+// ----------------------------------------------------------------
+static inline void IRAM_ATTR writeCoils(uint32_t clearMask, uint32_t setMask) {
+  REG_WRITE(GPIO_OUT_W1TC_REG, clearMask);
+  REG_WRITE(GPIO_OUT_W1TS_REG, setMask);
+}
+
+// Coils switched fully on or off from a sequence table, compiled into
+// per-phase GPIO set and clear masks for the axis's pins
+template<int Phases, const int (*Sequence)[4]>
+class SwitchedDrive {
+private:
+  static_assert((Phases & (Phases - 1)) == 0, "Phase count must be a power of two");
+  
+  uint32_t setMasks[Phases];       // Coils on in the phase
+  uint32_t clearMasks[Phases];     // The axis's other coils
+  uint32_t mask;
+  
+public:
+  static constexpr int PHASES = Phases;
+  static constexpr const int (*SEQUENCE)[4] = Sequence;   // Also played by StepStream
+  
+  SwitchedDrive() : setMasks(), clearMasks(), mask(0) {}
+  
+  void begin(const CoilPins& pins, int axis) {
+    mask = coilMask(pins);
+    for (int i = 0; i < Phases; i++) {
+      setMasks[i] = coilPattern(pins, Sequence[i]);
+      clearMasks[i] = mask & ~setMasks[i];
+    }
+    pinMode(pins.a, OUTPUT);
+    pinMode(pins.b, OUTPUT);
+    pinMode(pins.c, OUTPUT);
+    pinMode(pins.d, OUTPUT);
+  }
+  
+  void IRAM_ATTR drive(int phase) const { writeCoils(clearMasks[phase], setMasks[phase]); }
+  void IRAM_ATTR release() const { REG_WRITE(GPIO_OUT_W1TC_REG, mask); }
+};
+
+typedef SwitchedDrive<4, waveSequence> WaveDrive;
+typedef SwitchedDrive<4, fullStepSequence> FullStepDrive;
+typedef SwitchedDrive<8, stepSequence> HalfStepDrive;
+
+#if DRIVE_MODE == DRIVE_MICROSTEP
+// ----------------------------------------------------------------
+// Sine-weighted PWM microstepping. Winding A (pins A/C) follows cos
+// and winding B (pins B/D) sin of the electrical angle, which matches
+// the half-step table at every Microsteps-th phase. Duties come from a
+// quarter-wave table (shared by every axis) and go straight to the
+// LEDC registers, since the LEDC driver calls are not IRAM-safe. Axis
+// n uses channels 4n..4n+3.
+// ----------------------------------------------------------------
+template<int Microsteps>
+class SineDrive {
+public:
+  static constexpr int PHASES = 8 * Microsteps;
+  static constexpr int QUARTER = PHASES / 4;
+  static_assert((PHASES & (PHASES - 1)) == 0, "Phase count must be a power of two");
+  
+  SineDrive() : channel(0) {}
+  
+  void begin(const CoilPins& pins, int axis) {
+    const int maxDuty = (1 << PWM_RESOLUTION) - 1;
+    for (int i = 0; i <= QUARTER; i++) {
+      sineDuty[i] = (uint16_t)lroundf(sinf(i * (float)M_PI_2 / QUARTER) * maxDuty);
+    }
+    
+    // Attached through the driver once; after that only the duty
+    // registers are touched
+    channel = axis * PWM_CHANNELS_PER_AXIS;
+    ledcAttachChannel(pins.a, PWM_FREQUENCY, PWM_RESOLUTION, channel + PWM_CHANNEL_A);
+    ledcAttachChannel(pins.b, PWM_FREQUENCY, PWM_RESOLUTION, channel + PWM_CHANNEL_B);
+    ledcAttachChannel(pins.c, PWM_FREQUENCY, PWM_RESOLUTION, channel + PWM_CHANNEL_C);
+    ledcAttachChannel(pins.d, PWM_FREQUENCY, PWM_RESOLUTION, channel + PWM_CHANNEL_D);
+    ledcWrite(pins.a, 0);
+    ledcWrite(pins.b, 0);
+    ledcWrite(pins.c, 0);
+    ledcWrite(pins.d, 0);
+  }
+  
+  void IRAM_ATTR drive(int phase) const {
+    int sine = sineAt(phase);
+    int cosine = sineAt(phase + QUARTER);
+    writeDuty(channel + PWM_CHANNEL_A, cosine > 0 ? cosine : 0);
+    writeDuty(channel + PWM_CHANNEL_B, sine > 0 ? sine : 0);
+    writeDuty(channel + PWM_CHANNEL_C, cosine < 0 ? -cosine : 0);
+    writeDuty(channel + PWM_CHANNEL_D, sine < 0 ? -sine : 0);
+  }
+  
+  void IRAM_ATTR release() const {
+    writeDuty(channel + PWM_CHANNEL_A, 0);
+    writeDuty(channel + PWM_CHANNEL_B, 0);
+    writeDuty(channel + PWM_CHANNEL_C, 0);
+    writeDuty(channel + PWM_CHANNEL_D, 0);
+  }
+  
+private:
+  static inline uint16_t sineDuty[QUARTER + 1];   // 0..90 degrees
+  
+  int channel;                     // First of the axis's LEDC channels
+  
+  // Signed duty for sin(phase)
+  static int IRAM_ATTR sineAt(int phase) {
+    phase &= PHASES - 1;
+    int index = phase % QUARTER;
+    int value = ((phase / QUARTER) & 1) ? sineDuty[QUARTER - index] : sineDuty[index];
+    return phase >= 2 * QUARTER ? -value : value;
+  }
+  
+  static void IRAM_ATTR writeDuty(int channel, uint32_t duty) {
+    ledc_ll_set_duty_int_part(&LEDC, LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel, duty);
+    ledc_ll_set_duty_start(&LEDC, LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel, true);
+    ledc_ll_ls_channel_update(&LEDC, LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel);
+  }
+};
+#endif
+
+// The policy DRIVE_MODE selects
+#if DRIVE_MODE == DRIVE_WAVE
+typedef WaveDrive SelectedDrive;
+#elif DRIVE_MODE == DRIVE_FULL_STEP
+typedef FullStepDrive SelectedDrive;
+#elif DRIVE_MODE == DRIVE_HALF_STEP
+typedef HalfStepDrive SelectedDrive;
+#else
+typedef SineDrive<MICROSTEPS> SelectedDrive;
+#endif
+
+static_assert(SelectedDrive::PHASES == PHASE_COUNT, "Drive policy and PHASE_COUNT disagree");
+
+#endif // DRIVE_MODE_H
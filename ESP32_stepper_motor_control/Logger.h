@@ -1,5 +1,12 @@
 /*
  * Logging System - Circular Buffer for Motion History
+ *
+ * Every entry gets a sequence number that keeps counting past the end of
+ * the buffer, so clients can page with a cursor ("entries after N") and
+ * tell when entries they never saw have been overwritten. Entries are
+ * formatted one at a time into a caller's buffer; nothing grows with the
+ * number of entries. Logging and reading both happen on the network
+ * task.
  */
 
 #ifndef LOGGER_H
@@ -8,55 +15,87 @@
 #include <Arduino.h>
 #include "Config.h"
 
+enum LogLevel {
+  LOG_LEVEL_INFO = 0,              // Every entry
+  LOG_LEVEL_WARNING = 1,           // Entries carrying any error code
+  LOG_LEVEL_ERROR = 2              // Error codes other than warnings
+};
+
+struct LogFilter {
+  LogLevel level;
+  int error;                       // Only this ErrorCode, or -1 for any
+};
+
 class Logger {
 private:
   LogEntry buffer[LOG_BUFFER_SIZE];
-  int writeIndex;
-  int count;
+  uint32_t nextSequence;           // Sequence the next entry will get
+  uint32_t firstSequence;          // Entries before this were cleared
   
 public:
-  Logger() : writeIndex(0), count(0) {}
+  Logger() : nextSequence(1), firstSequence(1) {}
   
   void log(int position, int target, int speed, MotorState state, ErrorCode error) {
-    buffer[writeIndex].timestamp = millis();
-    buffer[writeIndex].position = position;
-    buffer[writeIndex].targetPosition = target;
-    buffer[writeIndex].speed = speed;
-    buffer[writeIndex].state = state;
-    buffer[writeIndex].error = error;
-    
-    writeIndex = (writeIndex + 1) % LOG_BUFFER_SIZE;
-    if (count < LOG_BUFFER_SIZE) count++;
+    LogEntry& entry = buffer[nextSequence % LOG_BUFFER_SIZE];
+    entry.sequence = nextSequence++;
+    entry.timestamp = millis();
+    entry.position = position;
+    entry.targetPosition = target;
+    entry.speed = speed;
+    entry.state = state;
+    entry.error = error;
   }
   
-  int getCount() const { return count; }
-  
-  const LogEntry* getEntry(int index) const {
-    if (index >= count) return nullptr;
-    int actualIndex = (writeIndex - count + index + LOG_BUFFER_SIZE) % LOG_BUFFER_SIZE;
-    return &buffer[actualIndex];
+  // Sequence range still held: [getOldestSequence(), getNextSequence())
+  uint32_t getNextSequence() const { return nextSequence; }
+  uint32_t getOldestSequence() const {
+    uint32_t kept = nextSequence > LOG_BUFFER_SIZE ? nextSequence - LOG_BUFFER_SIZE : 1;
+    return kept > firstSequence ? kept : firstSequence;
   }
   
-  void clear() {
-    writeIndex = 0;
-    count = 0;
+  // nullptr if the entry has been overwritten or not written yet
+  const LogEntry* getEntry(uint32_t sequence) const {
+    if (sequence < getOldestSequence() || sequence >= nextSequence) return nullptr;
+    return &buffer[sequence % LOG_BUFFER_SIZE];
   }
   
-  String getLastErrors(int maxEntries = 10) const {
-    String result = "[";
-    int entriesToShow = min(maxEntries, count);
+  static bool matches(const LogEntry& entry, const LogFilter& filter) {
+    if (filter.error >= 0 && entry.error != filter.error) return false;
+    switch (filter.level) {
+      case LOG_LEVEL_WARNING:
+        return entry.error != ERROR_NONE;
+      case LOG_LEVEL_ERROR:
+        return entry.error != ERROR_NONE && entry.error != ERROR_SOFT_LIMIT_WARNING;
+      default:
+        return true;
+    }
+  }
     
-    for (int i = count - entriesToShow; i < count; i++) {
-      const LogEntry* entry = getEntry(i);
-      if (entry && entry->error != ERROR_NONE) {
-        if (result.length() > 1) result += ",";
-        result += "{\"time\":" + String(entry->timestamp) + 
-                  ",\"pos\":" + String(entry->position) +
-                  ",\"error\":" + String(entry->error) + "}";
-      }
+  // First sequence of the newest `limit` matching entries, for clients
+  // that start without a cursor
+  uint32_t tailStart(const LogFilter& filter, int limit) const {
+    uint32_t sequence = nextSequence;
+    while (limit > 0 && sequence > getOldestSequence()) {
+      sequence--;
+      if (matches(buffer[sequence % LOG_BUFFER_SIZE], filter)) limit--;
     }
-    result += "]";
-    return result;
+    return sequence;
+  }
+  
+  // Format one entry as a JSON object; returns the length, or 0 if it
+  // does not fit in size
+  static size_t formatEntry(const LogEntry& entry, char* out, size_t size) {
+    int n = snprintf(out, size,
+                     "{\"seq\":%lu,\"timestamp\":%lu,\"position\":%d,\"target\":%d,"
+                     "\"speed\":%d,\"state\":%d,\"error\":%d}",
+                     (unsigned long)entry.sequence, entry.timestamp, entry.position,
+                     entry.targetPosition, entry.speed, (int)entry.state, (int)entry.error);
+    return (n > 0 && (size_t)n < size) ? n : 0;
+  }
+  
+  // Sequence numbers keep counting, so cursors held by clients stay valid
+  void clear() {
+    firstSequence = nextSequence;
   }
 };
 
@@ -0,0 +1,124 @@
+/*
+ * Metrics - Always-on timing histograms for /api/metrics
+ *
+ * Each histogram has power-of-two microsecond buckets (<= 1 us, 2 us,
+ * 4 us ... about 1 s, then +Inf), so recording a value is a count-
+ * leading-zeros and two adds under a short spinlock. That is cheap
+ * enough for the step interrupt. Values are exported in seconds, in the
+ * Prometheus text format.
+ *
+ * Recorded:
+ *   step lateness       - step interrupt, how long after its scheduled
+ *                         time each step fired
+ *   task pass time      - one pass of the motion task and of the network
+ *                         task (the firmware's "loop()" iterations)
+ *   request duration    - per /api route, handler start to finish
+ *
+ * and counted: sequence events lost to a full event queue.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "Config.h"
+
+class Histogram {
+public:
+  // Copy taken under the lock for export
+  struct Snapshot {
+    uint32_t buckets[METRICS_BUCKETS];
+    uint32_t count;
+    uint64_t sum;                  // us
+  };
+  
+  Histogram() : lock(portMUX_INITIALIZER_UNLOCKED) {
+    memset(&data, 0, sizeof(data));
+  }
+  
+  // Bucket i counts values <= 2^i us
+  static uint32_t IRAM_ATTR bucketFor(uint32_t us) {
+    return us <= 1 ? 0 : 32 - __builtin_clz(us - 1);
+  }
+  
+  // Safe from tasks and interrupts
+  void IRAM_ATTR observe(uint32_t us) {
+    uint32_t bucket = bucketFor(us);
+    portENTER_CRITICAL_SAFE(&lock);
+    if (bucket < METRICS_BUCKETS) data.buckets[bucket]++;
+    data.count++;
+    data.sum += us;
+    portEXIT_CRITICAL_SAFE(&lock);
+  }
+  
+  Snapshot read() {
+    portENTER_CRITICAL(&lock);
+    Snapshot copy = data;
+    portEXIT_CRITICAL(&lock);
+    return copy;
+  }
+  
+private:
+  Snapshot data;
+  portMUX_TYPE lock;
+};
+
+class Metrics {
+private:
+  struct Route {
+    const char* path;
+    const char* method;
+    Histogram duration;
+  };
+  
+  Route routes[METRICS_MAX_ROUTES];
+  int routeCount;
+  
+public:
+  Histogram stepLateness;
+  Histogram motionPass;
+  Histogram networkPass;
+  std::atomic<uint32_t> sequenceEventsDropped;
+  
+  Metrics() : routeCount(0), sequenceEventsDropped(0) {}
+  
+  // Register a route at startup; returns its index, or -1 if the table
+  // is full (the route then goes untimed)
+  int addRoute(const char* path, const char* method) {
+    if (routeCount >= METRICS_MAX_ROUTES) return -1;
+    routes[routeCount].path = path;
+    routes[routeCount].method = method;
+    return routeCount++;
+  }
+  
+  void observeRequest(int route, uint32_t us) {
+    if (route >= 0 && route < routeCount) routes[route].duration.observe(us);
+  }
+  
+  int getRouteCount() const { return routeCount; }
+  const char* getRoutePath(int route) const { return routes[route].path; }
+  const char* getRouteMethod(int route) const { return routes[route].method; }
+  Histogram& getRouteHistogram(int route) { return routes[route].duration; }
+  
+  // Write one histogram's sample lines; labels is "" or `key="value",...`
+  template<typename Writer>
+  static void writeHistogram(Writer& out, const char* name, const char* labels,
+                             const Histogram::Snapshot& h) {
+    const char* sep = labels[0] ? "," : "";
+    char block[METRICS_LABELS_SIZE + 2];
+    snprintf(block, sizeof(block), labels[0] ? "{%s}" : "%s", labels);
+    
+    uint32_t cumulative = 0;
+    for (int i = 0; i < METRICS_BUCKETS; i++) {
+      cumulative += h.buckets[i];
+      out.printf("%s_bucket{%s%sle=\"%.6f\"} %lu\n", name, labels, sep,
+                 (double)(1UL << i) / 1e6, (unsigned long)cumulative);
+    }
+    out.printf("%s_bucket{%s%sle=\"+Inf\"} %lu\n", name, labels, sep, (unsigned long)h.count);
+    out.printf("%s_sum%s %.6f\n", name, block, (double)h.sum / 1e6);
+    out.printf("%s_count%s %lu\n", name, block, (unsigned long)h.count);
+  }
+};
+
+#endif // METRICS_H
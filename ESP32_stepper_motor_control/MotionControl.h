@@ -0,0 +1,146 @@
+/*
+ * Motion Control Plumbing - Lock-free links between the web side and
+ * the motion task
+ *
+ * SpscQueue is a single-producer / single-consumer ring. CommandQueue is
+ * the one the network task pushes and the motion task pops. StatusSnapshot is a seqlock: the
+ * motion task publishes, any reader retries until it gets a consistent
+ * copy. HandoffSlot passes one larger request (a sequence, a coordinated
+ * move) alongside the command that starts it. Neither side ever blocks
+ * the other.
+ */
+
+#ifndef MOTION_CONTROL_H
+#define MOTION_CONTROL_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "Config.h"
+
+static inline bool sameStatus(const MotorStatus& a, const MotorStatus& b) {
+  return a.axis == b.axis && a.position == b.position && a.target == b.target &&
+         a.speed == b.speed && a.state == b.state &&
+         a.running == b.running && a.maxSteps == b.maxSteps &&
+         a.stepsPerRotation == b.stepsPerRotation &&
+         a.nearLimit == b.nearLimit;
+}
+
+template<typename T, uint32_t SIZE>
+class SpscQueue {
+private:
+  static_assert((SIZE & (SIZE - 1)) == 0, "SpscQueue size must be a power of two");
+  
+  T buffer[SIZE];
+  std::atomic<uint32_t> head;      // Next slot to write (producer)
+  std::atomic<uint32_t> tail;      // Next slot to read (consumer)
+  
+public:
+  SpscQueue() : head(0), tail(0) {}
+  
+  // Producer side - returns false if the queue is full
+  bool push(const T& item) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= SIZE) {
+      return false;
+    }
+    buffer[h & (SIZE - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  
+  // Producer side - whether count pushes would all fit
+  bool hasRoom(uint32_t count = 1) const {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    return SIZE - (h - tail.load(std::memory_order_acquire)) >= count;
+  }
+  
+  // Consumer side - returns false if the queue is empty
+  bool pop(T& item) {
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = buffer[t & (SIZE - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+typedef SpscQueue<MotionCommand, COMMAND_QUEUE_SIZE> CommandQueue;
+
+class StatusSnapshot {
+private:
+  MotorStatus status;
+  std::atomic<uint32_t> sequence;  // Odd while a write is in progress
+  
+public:
+  StatusSnapshot() : status(), sequence(0) {}
+  
+  // Writer side - motion task only
+  void publish(const MotorStatus& s) {
+    uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    status = s;
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+  
+  // Reader side - retries until it sees an unchanged, even sequence
+  MotorStatus read() const {
+    MotorStatus copy;
+    uint32_t before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      copy = status;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    return copy;
+  }
+};
+
+// ----------------------------------------------------------------
+// One-deep handoff from the network task to the motion task
+// ----------------------------------------------------------------
+template<typename T>
+class HandoffSlot {
+private:
+  T item;
+  std::atomic<bool> full;
+  
+public:
+  HandoffSlot() : item(), full(false) {}
+  
+  // Producer side - returns false while the last offer is still waiting
+  bool offer(const T& value) {
+    if (full.load(std::memory_order_acquire)) return false;
+    item = value;
+    full.store(true, std::memory_order_release);
+    return true;
+  }
+  
+  // Consumer side - returns false if nothing is waiting
+  bool take(T& value) {
+    if (!full.load(std::memory_order_acquire)) return false;
+    value = item;
+    full.store(false, std::memory_order_release);
+    return true;
+  }
+  
+  // Producer side - take back an offer whose command could not be
+  // queued (so the motion task will not look at the slot)
+  void withdraw() {
+    full.store(false, std::memory_order_release);
+  }
+};
+
+// Targets for a move that starts every listed axis together
+struct CoordinatedMove {
+  uint8_t mask;                    // Bit n set = axis n moves
+  int targets[AXIS_COUNT];
+  bool relative[AXIS_COUNT];       // Target is a step count from the current position
+};
+
+typedef HandoffSlot<CoordinatedMove> MoveSlot;
+
+#endif // MOTION_CONTROL_H
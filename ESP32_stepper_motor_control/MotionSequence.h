@@ -0,0 +1,166 @@
+/*
+ * Motion Sequences - Batches of moves run on the device
+ *
+ * A sequence is a list of legs, each an absolute or relative target
+ * with an optional speed and a dwell once it arrives. The network task
+ * hands a parsed sequence to the motion task through SequenceSlot;
+ * SequenceRunner then drives the legs from the motion task loop and
+ * reports progress back as SequenceEvents, so a focus sweep needs no
+ * WiFi round trip between moves.
+ *
+ * Relative legs are measured from the previous leg's target (the first
+ * from wherever the motor is when the sequence starts). Each axis has its
+ * own runner; a sequence drives one axis.
+ */
+
+#ifndef MOTION_SEQUENCE_H
+#define MOTION_SEQUENCE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "Config.h"
+#include "MotionControl.h"
+#include "StepperMotor.h"
+
+struct SequenceLeg {
+  bool relative;                   // value is a step count, not a position
+  int value;
+  int speed;                       // Steps/sec for this leg (0 = unchanged)
+  unsigned long dwell;             // ms to hold after arriving
+};
+
+struct MotionSequence {
+  uint32_t tag;                    // Client-chosen, echoed in events
+  int axis;
+  uint8_t count;
+  SequenceLeg legs[SEQUENCE_MAX_LEGS];
+};
+
+enum SequenceEventType {
+  SEQUENCE_LEG_DONE = 0,           // A leg arrived (before its dwell)
+  SEQUENCE_COMPLETE = 1,
+  SEQUENCE_CANCELLED = 2,          // Emergency stop, manual move or new sequence
+  SEQUENCE_FAILED = 3              // A leg's target was out of range
+};
+
+struct SequenceEvent {
+  SequenceEventType type;
+  int axis;
+  uint32_t tag;
+  uint8_t leg;
+  int position;
+  ErrorCode error;
+};
+
+typedef SpscQueue<SequenceEvent, SEQUENCE_EVENT_QUEUE_SIZE> SequenceEventQueue;
+
+typedef HandoffSlot<MotionSequence> SequenceSlot;
+
+// ----------------------------------------------------------------
+// Leg-by-leg execution - motion task only
+// ----------------------------------------------------------------
+class SequenceRunner {
+private:
+  enum Phase {
+    PHASE_IDLE,
+    PHASE_START_LEG,
+    PHASE_MOVING,
+    PHASE_DWELL
+  };
+  
+  MotionSequence sequence;
+  Phase phase;
+  uint8_t leg;
+  int legTarget;
+  int baseSpeed;                   // Restored when the sequence ends
+  unsigned long dwellStart;
+  
+  SequenceEvent makeEvent(SequenceEventType type, int position, ErrorCode error) const {
+    SequenceEvent event = { type, sequence.axis, sequence.tag, leg, position, error };
+    return event;
+  }
+  
+  SequenceEvent finish(StepperMotor& motor, SequenceEventType type, ErrorCode error) {
+    phase = PHASE_IDLE;
+    motor.setSpeed(baseSpeed);
+    return makeEvent(type, motor.getCurrentPosition(), error);
+  }
+  
+public:
+  SequenceRunner() : sequence(), phase(PHASE_IDLE), leg(0), legTarget(0), baseSpeed(0), dwellStart(0) {}
+  
+  bool isActive() const { return phase != PHASE_IDLE; }
+  int getAxis() const { return sequence.axis; }
+  
+  void start(const MotionSequence& seq, StepperMotor& motor) {
+    sequence = seq;
+    leg = 0;
+    legTarget = motor.getCurrentPosition();
+    baseSpeed = motor.getSpeed();
+    phase = (seq.count > 0) ? PHASE_START_LEG : PHASE_IDLE;
+  }
+  
+  // A speed set outside the sequence becomes the one restored at the end
+  void setBaseSpeed(int speed) {
+    baseSpeed = speed;
+  }
+  
+  // Abandon the sequence; the caller has already stopped or redirected
+  // the motor. Returns false if nothing was running.
+  bool cancel(StepperMotor& motor, SequenceEvent& event) {
+    if (phase == PHASE_IDLE) return false;
+    event = finish(motor, SEQUENCE_CANCELLED, ERROR_NONE);
+    return true;
+  }
+  
+  // Advance the sequence; call once per motion task pass. Returns true
+  // when event has been filled in.
+  bool poll(StepperMotor& motor, unsigned long now, SequenceEvent& event);
+};
+
+bool SequenceRunner::poll(StepperMotor& motor, unsigned long now, SequenceEvent& event) {
+  switch (phase) {
+    case PHASE_IDLE:
+      return false;
+      
+    case PHASE_START_LEG: {
+      const SequenceLeg& current = sequence.legs[leg];
+      int target = current.relative ? legTarget + current.value : current.value;
+      
+      if (motor.validatePosition(target) == ERROR_HARD_LIMIT) {
+        event = finish(motor, SEQUENCE_FAILED, ERROR_HARD_LIMIT);
+        return true;
+      }
+      
+      legTarget = target;
+      motor.setSpeed(current.speed > 0 ? current.speed : baseSpeed);
+      motor.setTargetPosition(target);
+      phase = PHASE_MOVING;
+      return false;
+    }
+    
+    case PHASE_MOVING:
+      if (motor.isRunning() || motor.getCurrentPosition() != legTarget) {
+        return false;
+      }
+      event = makeEvent(SEQUENCE_LEG_DONE, legTarget, ERROR_NONE);
+      dwellStart = now;
+      phase = PHASE_DWELL;
+      return true;
+      
+    case PHASE_DWELL:
+      if (now - dwellStart < sequence.legs[leg].dwell) {
+        return false;
+      }
+      if (leg + 1 >= sequence.count) {
+        event = finish(motor, SEQUENCE_COMPLETE, ERROR_NONE);
+        return true;
+      }
+      leg++;
+      phase = PHASE_START_LEG;
+      return false;
+  }
+  return false;
+}
+
+#endif // MOTION_SEQUENCE_H
@@ -0,0 +1,192 @@
+/*
+ * Position Journal - Wear-levelled position persistence
+ *
+ * Positions are appended as small CRC-protected records to a dedicated
+ * flash partition (see partitions.csv) instead of overwriting one NVS
+ * key. Records fill each 4 KB sector in turn; the next sector is erased
+ * only when the writer reaches it, so every sector wears evenly. At boot
+ * the partition is scanned once and the record with the highest
+ * sequence number and a valid CRC wins; a torn write just loses the
+ * record being written.
+ *
+ * Each record also stores the coil sequence index, so the first step
+ * after power-up continues from the phase the rotor is actually in.
+ *
+ * Records carry their axis (older firmware wrote 0 there), and each axis
+ * restores from its own newest record. Before a sector is erased, the
+ * newest record of any other axis that lives in it is copied forward,
+ * so an axis that stays put never loses its position to the wrap.
+ */
+
+#ifndef POSITION_JOURNAL_H
+#define POSITION_JOURNAL_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <esp_partition.h>
+#include <esp_rom_crc.h>
+#include "Config.h"
+
+class PositionJournal {
+private:
+  struct Record {
+    uint32_t sequence;             // 0xFFFFFFFF = never written
+    int32_t position;
+    uint8_t phase;                 // Coil sequence index
+    uint8_t axis;
+    uint8_t reserved[2];
+    uint32_t crc;                  // CRC-32 of the fields above
+  };
+  
+  static_assert(sizeof(Record) == 16, "Journal records must pack to 16 bytes");
+  static_assert(JOURNAL_SECTOR_SIZE % sizeof(Record) == 0, "Records must tile a sector");
+  
+  static const uint32_t RECORDS_PER_SECTOR = JOURNAL_SECTOR_SIZE / sizeof(Record);
+  static const uint32_t READ_CHUNK = 32;     // Records read per flash access at boot
+  
+  const esp_partition_t* partition;
+  uint32_t slotCount;
+  uint32_t nextSlot;               // Where the next record goes
+  uint32_t nextSequence;
+  Record latest[AXIS_COUNT];       // Each axis's newest record
+  uint32_t latestSlot[AXIS_COUNT];
+  bool haveLatest[AXIS_COUNT];
+  
+  bool write(int axis, int position, int phase);
+  
+  static uint32_t recordCRC(const Record& r) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&r, offsetof(Record, crc));
+  }
+  
+  static bool isBlank(const Record& r) {
+    const uint32_t* words = (const uint32_t*)&r;
+    for (size_t i = 0; i < sizeof(Record) / 4; i++) {
+      if (words[i] != 0xFFFFFFFF) return false;
+    }
+    return true;
+  }
+  
+public:
+  PositionJournal() : partition(nullptr), slotCount(0), nextSlot(0), nextSequence(1),
+                      latest(), latestSlot(), haveLatest() {}
+  
+  // Find the partition and replay it. Returns true if any valid record
+  // was found.
+  bool begin();
+  
+  // False if the journal partition is missing from the partition table
+  bool isReady() const { return partition != nullptr; }
+  
+  // An axis's position and phase from its newest record, if it has one
+  bool saved(int axis, int& position, int& phase) const;
+  
+  bool append(int axis, int position, int phase);
+};
+
+bool PositionJournal::begin() {
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                       JOURNAL_PARTITION_LABEL);
+  if (partition == nullptr || partition->size < 2 * JOURNAL_SECTOR_SIZE) {
+    partition = nullptr;
+    return false;
+  }
+  slotCount = (partition->size / JOURNAL_SECTOR_SIZE) * RECORDS_PER_SECTOR;
+  
+  // One pass over the partition
+  Record chunk[READ_CHUNK];
+  bool found = false;
+  uint32_t newestSlot = 0;
+  Record newest;
+  
+  for (uint32_t base = 0; base < slotCount; base += READ_CHUNK) {
+    if (esp_partition_read(partition, base * sizeof(Record), chunk, sizeof(chunk)) != ESP_OK) {
+      continue;
+    }
+    for (uint32_t i = 0; i < READ_CHUNK; i++) {
+      const Record& r = chunk[i];
+      if (r.sequence == 0xFFFFFFFF || r.crc != recordCRC(r)) continue;
+      if (!found || r.sequence > newest.sequence) {
+        found = true;
+        newest = r;
+        newestSlot = base + i;
+      }
+      if (r.axis < AXIS_COUNT && (!haveLatest[r.axis] || r.sequence > latest[r.axis].sequence)) {
+        haveLatest[r.axis] = true;
+        latest[r.axis] = r;
+        latestSlot[r.axis] = base + i;
+      }
+    }
+  }
+  
+  if (!found) {
+    nextSlot = 0;
+    nextSequence = 1;
+    return false;
+  }
+  
+  nextSequence = newest.sequence + 1;
+  nextSlot = (newestSlot + 1) % slotCount;
+  
+  // A slot that is not blank here means a torn write; start afresh in
+  // the next sector rather than write over it
+  Record check;
+  if (nextSlot % RECORDS_PER_SECTOR != 0 &&
+      (esp_partition_read(partition, nextSlot * sizeof(Record), &check, sizeof(check)) != ESP_OK ||
+       !isBlank(check))) {
+    nextSlot = (nextSlot / RECORDS_PER_SECTOR + 1) * RECORDS_PER_SECTOR % slotCount;
+  }
+  return true;
+}
+
+bool PositionJournal::saved(int axis, int& position, int& phase) const {
+  if (axis < 0 || axis >= AXIS_COUNT || !haveLatest[axis]) return false;
+  position = latest[axis].position;
+  phase = latest[axis].phase;
+  return true;
+}
+
+// Write one record. Flash writes stall both cores' caches, so only call
+// this while the motors are at rest.
+bool PositionJournal::append(int axis, int position, int phase) {
+  if (partition == nullptr || axis < 0 || axis >= AXIS_COUNT) return false;
+  
+  // Entering a sector - erase it first (it holds the oldest records),
+  // then carry forward any other axis whose newest record was there
+  if (nextSlot % RECORDS_PER_SECTOR == 0) {
+    uint32_t sector = nextSlot / RECORDS_PER_SECTOR;
+    if (esp_partition_erase_range(partition, nextSlot * sizeof(Record), JOURNAL_SECTOR_SIZE) != ESP_OK) {
+      return false;
+    }
+    for (int other = 0; other < AXIS_COUNT; other++) {
+      if (other != axis && haveLatest[other] && latestSlot[other] / RECORDS_PER_SECTOR == sector) {
+        write(other, latest[other].position, latest[other].phase);
+      }
+    }
+  }
+  
+  return write(axis, position, phase);
+}
+
+// Write at nextSlot, which must be blank
+bool PositionJournal::write(int axis, int position, int phase) {
+  Record r;
+  memset(&r, 0, sizeof(r));
+  r.sequence = nextSequence;
+  r.position = position;
+  r.phase = (uint8_t)phase;
+  r.axis = (uint8_t)axis;
+  r.crc = recordCRC(r);
+  
+  if (esp_partition_write(partition, nextSlot * sizeof(Record), &r, sizeof(r)) != ESP_OK) {
+    return false;
+  }
+  
+  latest[axis] = r;
+  latestSlot[axis] = nextSlot;
+  haveLatest[axis] = true;
+  nextSequence++;
+  nextSlot = (nextSlot + 1) % slotCount;
+  return true;
+}
+
+#endif // POSITION_JOURNAL_H
@@ -0,0 +1,190 @@
+/*
+ * Loop Profiler - Cycle-counter timing of the network and motion loops
+ *
+ * Built only with ENABLE_PROFILER set in Config.h; otherwise PROFILE()
+ * expands to the bare statement and nothing here is compiled in.
+ *
+ * Each section keeps count, min, max and total CPU cycles, plus a
+ * histogram with four buckets per power of two, so p99 is known to
+ * within 25% in fixed memory. A network task pass is one iteration: the
+ * PROFILE_NETWORK_PASS section closes it, and the slowest passes are
+ * kept with their time and per-section breakdown.
+ *
+ *   PROFILE(PROFILE_WEBSOCKET, webSocket.loop());
+ *
+ * Profiler builds also get benchmarkNs() for the on-device hot path
+ * benchmarks behind /api/profile/bench.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+enum ProfileSection {
+  PROFILE_HANDLE_CLIENT,
+  PROFILE_WEBSOCKET,
+  PROFILE_OTA,
+  PROFILE_SAVE_POSITION,
+  PROFILE_BROADCAST,
+  PROFILE_EVENTS,                  // Sequence and autofocus events
+  PROFILE_WIFI_CHECK,
+  PROFILE_NETWORK_PASS,            // Whole network task pass (one iteration)
+  PROFILE_MOTOR_UPDATE,            // Motion task - not part of the pass
+  PROFILE_SECTION_COUNT
+};
+
+#if ENABLE_PROFILER
+
+#include <esp_cpu.h>
+
+static const char* const PROFILE_SECTION_NAMES[PROFILE_SECTION_COUNT] = {
+  "handleClient", "webSocket", "ota", "savePosition", "broadcastStatus",
+  "events", "wifiCheck", "networkPass", "motorUpdate"
+};
+
+class LoopProfiler {
+public:
+  static const int BUCKETS = 128;  // 4 per power of two over 32 bits
+  
+  struct SectionStats {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[BUCKETS];
+  };
+  
+  struct Iteration {
+    unsigned long timestamp;       // millis() at the end of the pass
+    uint32_t cycles;
+    uint32_t sections[PROFILE_NETWORK_PASS];
+  };
+  
+  LoopProfiler() : worstKept(0), lock(portMUX_INITIALIZER_UNLOCKED) {
+    memset(stats, 0, sizeof(stats));
+    memset(worst, 0, sizeof(worst));
+    memset(&current, 0, sizeof(current));
+  }
+  
+  static uint32_t now() { return esp_cpu_get_cycle_count(); }
+  
+  void record(ProfileSection section, uint32_t cycles) {
+    portENTER_CRITICAL(&lock);
+    SectionStats& s = stats[section];
+    if (s.count == 0 || cycles < s.min) s.min = cycles;
+    if (cycles > s.max) s.max = cycles;
+    s.count++;
+    s.total += cycles;
+    s.buckets[bucketFor(cycles)]++;
+    
+    if (section < PROFILE_NETWORK_PASS) {
+      current.sections[section] += cycles;
+    } else if (section == PROFILE_NETWORK_PASS) {
+      current.cycles = cycles;
+      current.timestamp = millis();
+      keepIfWorst(current);
+      memset(&current, 0, sizeof(current));
+    }
+    portEXIT_CRITICAL(&lock);
+  }
+  
+  // Consistent copies for export, one section at a time to keep the
+  // caller's stack small
+  void readSection(ProfileSection section, SectionStats& out) {
+    portENTER_CRITICAL(&lock);
+    out = stats[section];
+    portEXIT_CRITICAL(&lock);
+  }
+  
+  int readWorst(Iteration* out) {
+    portENTER_CRITICAL(&lock);
+    memcpy(out, worst, sizeof(worst));
+    int count = worstKept;
+    portEXIT_CRITICAL(&lock);
+    return count;
+  }
+  
+  void reset() {
+    portENTER_CRITICAL(&lock);
+    memset(stats, 0, sizeof(stats));
+    memset(worst, 0, sizeof(worst));
+    memset(&current, 0, sizeof(current));
+    worstKept = 0;
+    portEXIT_CRITICAL(&lock);
+  }
+  
+  // Smallest bucket bound that covers the given fraction of samples
+  static uint32_t percentile(const SectionStats& s, float fraction) {
+    uint32_t wanted = (uint32_t)ceilf(s.count * fraction);
+    uint32_t seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+      seen += s.buckets[i];
+      if (seen >= wanted && seen > 0) {
+        uint32_t bound = bucketUpper(i);
+        return bound < s.max ? bound : s.max;
+      }
+    }
+    return s.max;
+  }
+  
+private:
+  SectionStats stats[PROFILE_SECTION_COUNT];
+  Iteration worst[PROFILER_WORST_COUNT];   // Slowest first
+  int worstKept;
+  Iteration current;
+  portMUX_TYPE lock;
+  
+  static int bucketFor(uint32_t v) {
+    if (v < 4) return v;
+    int msb = 31 - __builtin_clz(v);
+    return (msb - 1) * 4 + ((v >> (msb - 2)) & 3);
+  }
+  
+  static uint32_t bucketUpper(int index) {
+    if (index < 4) return index;
+    int msb = index / 4 + 1;
+    uint32_t step = 1UL << (msb - 2);
+    return (uint32_t)(4 + index % 4) * step + (step - 1);
+  }
+  
+  void keepIfWorst(const Iteration& it) {
+    int pos = worstKept;
+    while (pos > 0 && worst[pos - 1].cycles < it.cycles) pos--;
+    if (pos >= PROFILER_WORST_COUNT) return;
+    
+    int last = worstKept < PROFILER_WORST_COUNT ? worstKept : PROFILER_WORST_COUNT - 1;
+    for (int i = last; i > pos; i--) worst[i] = worst[i - 1];
+    worst[pos] = it;
+    if (worstKept < PROFILER_WORST_COUNT) worstKept++;
+  }
+};
+
+extern LoopProfiler profiler;
+
+// Time `iterations` calls of body(i) with the cycle counter; returns
+// nanoseconds per call
+template<typename Body>
+float benchmarkNs(int iterations, Body body) {
+  uint32_t start = LoopProfiler::now();
+  for (int i = 0; i < iterations; i++) {
+    body(i);
+  }
+  uint32_t cycles = LoopProfiler::now() - start;
+  return cycles * 1000.0f / ((float)ESP.getCpuFreqMHz() * iterations);
+}
+
+#define PROFILE(section, statement) do {                     \
+    uint32_t profileStart = LoopProfiler::now();             \
+    statement;                                               \
+    profiler.record(section, LoopProfiler::now() - profileStart); \
+  } while (0)
+  
+#else
+
+#define PROFILE(section, statement) do { statement; } while (0)
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_H
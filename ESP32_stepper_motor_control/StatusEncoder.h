@@ -0,0 +1,211 @@
+/*
+ * Status Encoder - Allocation-free status JSON and binary frames
+ *
+ * StatusEncoder writes the /api/status JSON into a fixed buffer with
+ * integer-only formatting (percentage is computed in hundredths). The
+ * last encoding is kept, so repeated requests for an unchanged status
+ * cost a compare.
+ *
+ * StatusFrameEncoder packs the same fields into little-endian binary
+ * WebSocket frames for clients that opt in:
+ *
+ *   Full frame (24 bytes)          Delta frame (5+ bytes)
+ *   0  u8  version                 0  u8  version
+ *   1  u8  type = 0                1  u8  type = 1
+ *   2  u8  flags                   2  u8  flags
+ *   3  u8  state                   3  u8  state
+ *   4  i32 position                4  u8  field mask, then per set bit:
+ *   8  i32 target                     bit 0  i16 position change
+ *   12 i32 maxSteps                   bit 1  i32 target
+ *   16 i32 stepsPerRot                bit 2  u16 speed
+ *   20 u16 speed                      bit 3  i32 maxSteps
+ *   22 u16 percentage x100            bit 4  i32 stepsPerRot
+ *                                     bit 5  u16 percentage x100
+ *
+ * flags: bit 0 running, bit 1 nearLimit, bits 4-5 axis. A delta applies
+ * to the last status the client received for that axis.
+ */
+
+#ifndef STATUS_ENCODER_H
+#define STATUS_ENCODER_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "MotionControl.h"
+
+// Position as a percentage of the +/- travel range, in hundredths
+static inline long percentHundredths(const MotorStatus& s) {
+  if (s.maxSteps <= 0) return 5000;
+  long long offset = (long long)s.position + s.maxSteps;
+  long long hundredths = offset * 10000 / (2LL * s.maxSteps);
+  if (hundredths < 0) return 0;
+  if (hundredths > 10000) return 10000;
+  return (long)hundredths;
+}
+
+class StatusEncoder {
+private:
+  char buffer[STATUS_JSON_BUFFER_SIZE];
+  size_t length;
+  MotorStatus encoded;
+  bool valid;
+  
+  void appendText(const char* text) {
+    while (*text && length < sizeof(buffer) - 1) {
+      buffer[length++] = *text++;
+    }
+  }
+  
+  void appendInt(long value) {
+    char digits[12];
+    int n = 0;
+    unsigned long magnitude = (value < 0) ? 0UL - (unsigned long)value : (unsigned long)value;
+  
+    do {
+      digits[n++] = '0' + (magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude > 0);
+  
+    if (value < 0 && length < sizeof(buffer) - 1) {
+      buffer[length++] = '-';
+    }
+    while (n > 0 && length < sizeof(buffer) - 1) {
+      buffer[length++] = digits[--n];
+    }
+  }
+  
+  void appendBool(bool value) {
+    appendText(value ? "true" : "false");
+  }
+  
+public:
+  StatusEncoder() : length(0), encoded(), valid(false) {
+    buffer[0] = '\0';
+  }
+  
+  // Returns a NUL-terminated JSON string owned by the encoder
+  const char* encode(const MotorStatus& s) {
+    if (valid && sameStatus(s, encoded)) {
+      return buffer;
+    }
+  
+    length = 0;
+    appendText("{\"axis\":");
+    appendInt(s.axis);
+    appendText(",\"position\":");
+    appendInt(s.position);
+    appendText(",\"target\":");
+    appendInt(s.target);
+    appendText(",\"speed\":");
+    appendInt(s.speed);
+    appendText(",\"state\":");
+    appendInt(s.state);
+    appendText(",\"running\":");
+    appendBool(s.running);
+    appendText(",\"maxSteps\":");
+    appendInt(s.maxSteps);
+    appendText(",\"stepsPerRot\":");
+    appendInt(s.stepsPerRotation);
+    appendText(",\"nearLimit\":");
+    appendBool(s.nearLimit);
+  
+    long pct = percentHundredths(s);
+    appendText(",\"percentage\":");
+    appendInt(pct / 100);
+    appendText(pct % 100 < 10 ? ".0" : ".");
+    appendInt(pct % 100);
+    appendText("}");
+    buffer[length] = '\0';
+  
+    encoded = s;
+    valid = true;
+    return buffer;
+  }
+  
+  size_t size() const { return length; }
+};
+
+class StatusFrameEncoder {
+private:
+  enum FrameType : uint8_t {
+    FRAME_FULL = 0,
+    FRAME_DELTA = 1
+  };
+  
+  enum DeltaField : uint8_t {
+    DELTA_POSITION = 1 << 0,
+    DELTA_TARGET = 1 << 1,
+    DELTA_SPEED = 1 << 2,
+    DELTA_MAX_STEPS = 1 << 3,
+    DELTA_STEPS_PER_ROT = 1 << 4,
+    DELTA_PERCENTAGE = 1 << 5
+  };
+  
+  uint8_t buffer[STATUS_FRAME_MAX_SIZE];
+  size_t length;
+  
+  void put8(uint8_t v) {
+    buffer[length++] = v;
+  }
+  
+  void put16(uint16_t v) {
+    buffer[length++] = v & 0xFF;
+    buffer[length++] = v >> 8;
+  }
+  
+  void put32(uint32_t v) {
+    put16(v & 0xFFFF);
+    put16(v >> 16);
+  }
+  
+  void putHeader(FrameType type, const MotorStatus& s) {
+    length = 0;
+    put8(STATUS_FRAME_VERSION);
+    put8(type);
+    put8((s.running ? 0x01 : 0) | (s.nearLimit ? 0x02 : 0) | ((s.axis & 0x03) << 4));
+    put8((uint8_t)s.state);
+  }
+  
+public:
+  StatusFrameEncoder() : length(0) {}
+  
+  // Encode s as a delta against base when possible, otherwise as a full
+  // frame. Returns the frame length; the frame is in data().
+  size_t encode(const MotorStatus& s, const MotorStatus* base) {
+    long positionChange = base ? (long)s.position - base->position : 0;
+  
+    if (base == nullptr || positionChange < INT16_MIN || positionChange > INT16_MAX) {
+      putHeader(FRAME_FULL, s);
+      put32(s.position);
+      put32(s.target);
+      put32(s.maxSteps);
+      put32(s.stepsPerRotation);
+      put16(s.speed);
+      put16(percentHundredths(s));
+      return length;
+    }
+  
+    long pct = percentHundredths(s);
+    uint8_t mask = 0;
+    if (positionChange != 0) mask |= DELTA_POSITION;
+    if (s.target != base->target) mask |= DELTA_TARGET;
+    if (s.speed != base->speed) mask |= DELTA_SPEED;
+    if (s.maxSteps != base->maxSteps) mask |= DELTA_MAX_STEPS;
+    if (s.stepsPerRotation != base->stepsPerRotation) mask |= DELTA_STEPS_PER_ROT;
+    if (pct != percentHundredths(*base)) mask |= DELTA_PERCENTAGE;
+  
+    putHeader(FRAME_DELTA, s);
+    put8(mask);
+    if (mask & DELTA_POSITION) put16((uint16_t)(int16_t)positionChange);
+    if (mask & DELTA_TARGET) put32(s.target);
+    if (mask & DELTA_SPEED) put16(s.speed);
+    if (mask & DELTA_MAX_STEPS) put32(s.maxSteps);
+    if (mask & DELTA_STEPS_PER_ROT) put32(s.stepsPerRotation);
+    if (mask & DELTA_PERCENTAGE) put16(pct);
+    return length;
+  }
+  
+  const uint8_t* data() const { return buffer; }
+};
+
+#endif // STATUS_ENCODER_H
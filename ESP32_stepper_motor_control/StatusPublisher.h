@@ -0,0 +1,111 @@
+/*
+ * Status Publisher - Decides when each WebSocket client gets a status
+ * update
+ *
+ * Updates go out only when the status has changed since that client's
+ * last update, at most every STATUS_MOVING_INTERVAL (or the client's own
+ * slower limit). An unchanged status is repeated as a heartbeat every
+ * STATUS_HEARTBEAT_INTERVAL so clients can tell the link is alive.
+ *
+ * Each client also picks its format (JSON or binary frames), whether
+ * binary updates may be sent as deltas against its last status, and
+ * which axes it follows (axis 0 until it asks). Every followed axis is
+ * tracked separately.
+ */
+
+#ifndef STATUS_PUBLISHER_H
+#define STATUS_PUBLISHER_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "MotionControl.h"
+
+class StatusPublisher {
+private:
+  struct ClientState {
+    bool connected;
+    uint8_t axes;                  // Bit n = client follows axis n
+    unsigned long lastSent[AXIS_COUNT];      // millis() of the last update
+    unsigned long minInterval;     // Client-requested spacing (ms)
+    MotorStatus lastStatus[AXIS_COUNT];      // What the client last received
+    StatusFormat format;
+    bool delta;                    // Binary updates may be deltas
+    bool haveBase[AXIS_COUNT];     // lastStatus is valid as a delta base
+  };
+  
+  ClientState clients[STATUS_MAX_CLIENTS];
+  
+public:
+  StatusPublisher() : clients() {}
+  
+  void connect(uint8_t num) {
+    if (num >= STATUS_MAX_CLIENTS) return;
+    clients[num] = ClientState();
+    clients[num].connected = true;
+    clients[num].axes = 0x01;
+  }
+  
+  void disconnect(uint8_t num) {
+    if (num >= STATUS_MAX_CLIENTS) return;
+    clients[num].connected = false;
+  }
+  
+  // Client-requested maximum update rate (Hz); 0 removes the limit
+  void setMaxRate(uint8_t num, int hz) {
+    if (num >= STATUS_MAX_CLIENTS) return;
+    clients[num].minInterval = (hz > 0) ? 1000UL / hz : 0;
+  }
+  
+  void setFormat(uint8_t num, StatusFormat format, bool delta) {
+    if (num >= STATUS_MAX_CLIENTS) return;
+    clients[num].format = format;
+    clients[num].delta = delta;
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      clients[num].haveBase[axis] = false;   // Next update is a full frame
+    }
+  }
+  
+  // Axes the client follows, as a bit mask
+  void setAxes(uint8_t num, uint8_t mask) {
+    if (num >= STATUS_MAX_CLIENTS) return;
+    clients[num].axes = mask;
+  }
+  
+  bool follows(uint8_t num, int axis) const {
+    return num < STATUS_MAX_CLIENTS && (clients[num].axes & (1 << axis));
+  }
+  
+  StatusFormat getFormat(uint8_t num) const {
+    return (num < STATUS_MAX_CLIENTS) ? clients[num].format : STATUS_FORMAT_JSON;
+  }
+  
+  // Status to delta-encode the next update against, or nullptr for a
+  // full frame (no base yet, deltas off, or a heartbeat is due)
+  const MotorStatus* deltaBase(uint8_t num, int axis, unsigned long now) const {
+    if (num >= STATUS_MAX_CLIENTS) return nullptr;
+    const ClientState& client = clients[num];
+    if (!client.delta || !client.haveBase[axis]) return nullptr;
+    if (now - client.lastSent[axis] >= STATUS_HEARTBEAT_INTERVAL) return nullptr;
+    return &client.lastStatus[axis];
+  }
+  
+  bool isDue(uint8_t num, const MotorStatus& status, unsigned long now) const {
+    if (!follows(num, status.axis) || !clients[num].connected) return false;
+    
+    const ClientState& client = clients[num];
+    unsigned long elapsed = now - client.lastSent[status.axis];
+    
+    if (elapsed >= STATUS_HEARTBEAT_INTERVAL) return true;
+    if (sameStatus(status, client.lastStatus[status.axis])) return false;
+    return elapsed >= max((unsigned long)STATUS_MOVING_INTERVAL, client.minInterval);
+  }
+  
+  void markSent(uint8_t num, const MotorStatus& status, unsigned long now) {
+    if (num >= STATUS_MAX_CLIENTS) return;
+    clients[num].lastSent[status.axis] = now;
+    clients[num].lastStatus[status.axis] = status;
+    clients[num].haveBase[status.axis] = true;
+  }
+};
+
+#endif // STATUS_PUBLISHER_H
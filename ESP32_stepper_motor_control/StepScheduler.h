@@ -0,0 +1,132 @@
+/*
+ * Step Scheduler - One hardware timer interleaving every axis's steps
+ *
+ * Each motor registers a step callback. The scheduler keeps each axis's
+ * next step deadline and sets the timer alarm for the earliest one; the
+ * interrupt then steps every axis that is due, and each callback returns
+ * that axis's next deadline. Deadlines within STEP_TIMER_MIN_WAIT of
+ * each other are served by the same interrupt, so axes stepping at
+ * related rates share interrupts the way a DDA tick would, while every
+ * axis keeps its own exact fixed-point step schedule. (Followers in a
+ * coordinated move are stepped by their leader's callback and are not
+ * scheduled themselves.)
+ *
+ * The timer interrupt is allocated on the core that calls begin();
+ * schedule() must be called from that core too (the motion task).
+ *
+ * Times are timer counts in microseconds, Q8 (PERIOD_ONE = 1 us).
+ */
+
+#ifndef STEP_SCHEDULER_H
+#define STEP_SCHEDULER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+#define STEP_TIMER_HZ 1000000         // Step timer counts microseconds
+#define STEP_TIMER_MIN_WAIT 2          // Earliest alarm after now (us)
+#define PERIOD_ONE 256                 // Q8 period scale
+#define STEP_IDLE INT64_MAX            // Deadline of an axis that is not stepping
+
+// Steps the axis if it is due at now; returns its next deadline or
+// STEP_IDLE. Runs in the timer interrupt.
+typedef int64_t (*StepCallback)(void* context, int64_t now);
+
+class StepScheduler {
+private:
+  struct Axis {
+    StepCallback step;
+    void* context;
+    int64_t deadline;
+  };
+  
+  Axis axes[AXIS_COUNT];
+  int count;
+  hw_timer_t* timer;
+  portMUX_TYPE lock;
+  int64_t alarmAt;                 // Pending alarm, STEP_IDLE if none
+  
+  static void timerISR(void* arg);
+  void onTimer();
+  void arm(int64_t deadline, int64_t now);
+  
+public:
+  StepScheduler() : axes(), count(0), timer(nullptr), lock(portMUX_INITIALIZER_UNLOCKED),
+                    alarmAt(STEP_IDLE) {}
+                    
+  // Register an axis; returns its slot
+  int add(StepCallback step, void* context);
+  
+  // Allocate the timer and its interrupt on the calling core
+  void begin();
+  
+  int64_t now() const {
+    return timer != nullptr ? (int64_t)timerRead(timer) * PERIOD_ONE : 0;
+  }
+  
+  // An axis started stepping; its first step is due at deadline
+  void schedule(int slot, int64_t deadline);
+};
+
+int StepScheduler::add(StepCallback step, void* context) {
+  if (count >= AXIS_COUNT) return -1;
+  axes[count].step = step;
+  axes[count].context = context;
+  axes[count].deadline = STEP_IDLE;
+  return count++;
+}
+
+void StepScheduler::begin() {
+  if (timer == nullptr) {
+    timer = timerBegin(STEP_TIMER_HZ);
+    timerAttachInterruptArg(timer, &StepScheduler::timerISR, this);
+  }
+}
+
+void IRAM_ATTR StepScheduler::timerISR(void* arg) {
+  static_cast<StepScheduler*>(arg)->onTimer();
+}
+
+// Set the alarm for deadline (no sooner than STEP_TIMER_MIN_WAIT from
+// now). Call with the lock held.
+void IRAM_ATTR StepScheduler::arm(int64_t deadline, int64_t now) {
+  int64_t earliest = now + STEP_TIMER_MIN_WAIT * PERIOD_ONE;
+  alarmAt = deadline > earliest ? deadline : earliest;
+  timerAlarm(timer, (uint64_t)(alarmAt / PERIOD_ONE), false, 0);
+}
+
+void IRAM_ATTR StepScheduler::onTimer() {
+  portENTER_CRITICAL_ISR(&lock);
+  alarmAt = STEP_IDLE;
+  int64_t next = STEP_IDLE;
+  for (int i = 0; i < count; i++) {
+    Axis& axis = axes[i];
+    if (axis.deadline != STEP_IDLE) {
+      // Each axis reads the clock afresh so its lateness is its own
+      int64_t now = (int64_t)timerRead(timer) * PERIOD_ONE;
+      if (axis.deadline <= now + STEP_TIMER_MIN_WAIT * PERIOD_ONE) {
+        axis.deadline = axis.step(axis.context, now);
+      }
+    }
+    if (axis.deadline < next) next = axis.deadline;
+  }
+  if (next != STEP_IDLE) {
+    arm(next, (int64_t)timerRead(timer) * PERIOD_ONE);
+  }
+  portEXIT_CRITICAL_ISR(&lock);
+}
+
+void StepScheduler::schedule(int slot, int64_t deadline) {
+  if (timer == nullptr || slot < 0 || slot >= count) return;
+  
+  portENTER_CRITICAL(&lock);
+  if (deadline < axes[slot].deadline) {
+    axes[slot].deadline = deadline;
+  }
+  if (deadline < alarmAt) {
+    arm(deadline, now());
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+#endif // STEP_SCHEDULER_H
@@ -0,0 +1,487 @@
+/*
+ * Step Stream - Precomputed coil waveforms played out by the RMT
+ *
+ * With STEP_STREAM set in Config.h, axis 0 takes no step interrupt. The
+ * motion task runs the usual step path ahead of time on the stream's
+ * own clock (StepperMotor::fillStream()) and hands each step here. Steps
+ * are kept in a ring of STREAM_SEGMENTS segments, each closed after
+ * STREAM_SEGMENT_STEPS steps or STREAM_SEGMENT_US, and planned up to
+ * STREAM_LOOKAHEAD_US ahead of playback; a segment is reused once it has
+ * played.
+ *
+ * Four RMT TX channels, started together by a sync manager, play the
+ * coils. Each runs one long transmission whose encoder expands the
+ * ring's steps into the coil's waveform a few symbols at a time and
+ * copies them into the channel's ping-pong memory, so the CPU is
+ * interrupted once per half memory block instead of once per step, and
+ * every edge lands on an RMT tick. Channel memory is always kept full,
+ * so the encoder reads ahead of playback by up to a memory block and
+ * its scratch buffer; halves are capped at STREAM_MAX_HALF ticks so
+ * that stays well inside the lookahead. A channel that still reaches a
+ * segment that is not ready ends there, and the others end at the same
+ * boundary, so a starved stream stops with the coils in step at a known
+ * position. The channels idle low, releasing the coils when a stream
+ * ends.
+ *
+ * The step path's GPIO writes go nowhere while the pins are routed to
+ * the RMT. The motor's own position is where the planned steps end;
+ * played() finds where the coils are from the time since playback began.
+ *
+ * Waveform layout (tools/step_waveform.py generates and checks the same):
+ *   - step i holds each coil at its level in step i's phase from the
+ *     step's time until step i+1's (or, for the last, until the stream
+ *     finishes); there are no gaps, including between reversal legs
+ *   - an interval of d ticks is n = ceil(d / STREAM_MAX_HALF) halves,
+ *     each ceil(remaining / halves left) ticks
+ *   - halves pair up into rmt_symbol_word_t symbols; an odd last half
+ *     is split in two (floor half second) so the count is even, or, if
+ *     it is a single tick, followed by a 1-tick low half (the idle
+ *     level), since a zero-length half would end the transmission early
+ *   - all four coils have the same halves; only the levels differ
+ */
+
+#ifndef STEP_STREAM_H
+#define STEP_STREAM_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <driver/rmt_tx.h>
+#include <driver/rmt_encoder.h>
+#include <esp_rom_gpio.h>
+#include <soc/gpio_sig_map.h>
+#include "Config.h"
+
+#define STREAM_NONE UINT32_MAX         // No final or starved segment yet
+
+// A planned step, kept until it has played
+struct StreamStep {
+  uint32_t time;                   // Stream time (us)
+  int32_t position;
+  int16_t slack;
+  uint8_t phase;
+  uint8_t reserved;
+};
+
+class StepStream {
+private:
+  struct Segment {
+    uint32_t end;                  // When the last step's interval ends (us)
+    uint16_t stepCount;
+    StreamStep steps[STREAM_SEGMENT_STEPS];
+  };
+  
+  // One per coil: expands the ring into its channel
+  struct CoilEncoder {
+    rmt_encoder_t base;
+    rmt_encoder_handle_t copy;
+    StepStream* stream;
+    int coil;
+    uint32_t segment;              // Where expansion has got to
+    uint16_t step;
+    uint16_t piecesLeft;           // Halves left in the current interval
+    uint32_t remaining;            // Ticks left in it
+    uint8_t level;
+    uint16_t halves;               // Expanded into scratch, not yet copied
+    uint32_t scratch[STREAM_SCRATCH_SYMBOLS];
+  };
+  
+  Segment segments[STREAM_SEGMENTS];
+  uint8_t levels[PHASE_COUNT];     // Coil bits (A = bit 0) per phase
+  rmt_channel_handle_t channels[4];
+  rmt_sync_manager_handle_t sync;
+  rmt_encoder_handle_t releaseEncoder;
+  CoilEncoder encoders[4];
+  bool ready;
+  
+  // Segments are numbered from the start of the stream; the one at
+  // committed is open (being filled) and those before it are read-only
+  // until retired
+  uint32_t retired;
+  std::atomic<uint32_t> committed;
+  std::atomic<uint32_t> finalCount;    // Segments in a finished stream
+  std::atomic<uint32_t> starveAt;      // First segment playback found missing
+  bool active;                     // Being built or played
+  bool playing;
+  uint32_t startMicros;
+  uint32_t lastTime;               // Newest step, or where the last leg rested
+  StreamStep lastPlayed;           // Newest step of the retired segments
+  
+  Segment& openSegment() { return segments[committed.load() % STREAM_SEGMENTS]; }
+  uint32_t elapsed() const { return playing ? micros() - startMicros : 0; }
+  
+  void commit(uint32_t end);
+  void play();
+  void release();
+  void teardown(const int* gpio);
+  StreamStep playedAt(uint32_t time) const;
+  
+  static bool nextInterval(CoilEncoder& coil);
+  static void expand(CoilEncoder& coil);
+  static size_t encodeCoil(rmt_encoder_t* encoder, rmt_channel_handle_t channel,
+                           const void* data, size_t size, rmt_encode_state_t* state);
+  static esp_err_t resetCoil(rmt_encoder_t* encoder);
+  static esp_err_t deleteCoil(rmt_encoder_t* encoder) { return ESP_OK; }
+  
+public:
+  StepStream() : levels(), channels(), sync(nullptr), releaseEncoder(nullptr), encoders(),
+                 ready(false), retired(0), committed(0), finalCount(STREAM_NONE),
+                 starveAt(STREAM_NONE), active(false), playing(false), startMicros(0),
+                 lastTime(0), lastPlayed() {}
+                 
+  // Route the coil pins to the RMT. Call from the motion task, so the
+  // refill interrupts land on its core. Returns false, with the pins
+  // back on GPIO_OUT, if the channels cannot be had.
+  bool begin(const CoilPins& pins, const int (*sequence)[4]);
+  bool isReady() const { return ready; }
+  
+  // A stream is being built or is still playing
+  bool isActive() const { return active; }
+  
+  // A leg can be added: no stream, or one that has not finished
+  bool canAppend() const { return !active || finalCount.load() == STREAM_NONE; }
+  
+  // Begin a stream from the axis's state at rest
+  void start(int position, int phase, int slack);
+  
+  // Room for another step: a free segment, and less than
+  // STREAM_LOOKAHEAD_US planned ahead of playback
+  bool hasRoom() const;
+  
+  // The next step, in stream time; steps come in time order
+  void step(uint32_t time, int position, int phase, int slack);
+  
+  // The axis came to rest at time for a reversal; the next leg starts
+  // there with the coils held
+  void rest(uint32_t time) { lastTime = time; }
+  uint32_t getRestTime() const { return lastTime; }
+  
+  // The axis came to rest on its target at time; the coils are
+  // released once the stream has played
+  void finish(uint32_t time);
+  
+  // From the motion task: retire played segments, start playback once
+  // the lookahead is planned, and notice the end of the stream
+  void service();
+  
+  // Playback caught up with planning and stopped short
+  bool isStarved() const;
+  
+  // The newest step the coils have taken
+  StreamStep played() const { return playedAt(elapsed()); }
+  
+  // Stop playback now and release the coils. Returns false if no stream
+  // was active; otherwise reached is where the coils got to.
+  bool abort(StreamStep& reached);
+};
+
+bool StepStream::begin(const CoilPins& pins, const int (*sequence)[4]) {
+  if (ready) return true;
+  for (int phase = 0; phase < PHASE_COUNT; phase++) {
+    levels[phase] = (sequence[phase][0] ? 1 : 0) | (sequence[phase][1] ? 2 : 0) |
+                    (sequence[phase][2] ? 4 : 0) | (sequence[phase][3] ? 8 : 0);
+  }
+  
+  const int gpio[4] = { pins.a, pins.b, pins.c, pins.d };
+  rmt_copy_encoder_config_t copyConfig = {};
+  for (int coil = 0; coil < 4; coil++) {
+    rmt_tx_channel_config_t config = {};
+    config.gpio_num = (gpio_num_t)gpio[coil];
+    config.clk_src = RMT_CLK_SRC_DEFAULT;
+    config.resolution_hz = STREAM_RESOLUTION_HZ;
+    config.mem_block_symbols = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+    config.trans_queue_depth = 1;
+    CoilEncoder& encoder = encoders[coil];
+    encoder.base.encode = &StepStream::encodeCoil;
+    encoder.base.reset = &StepStream::resetCoil;
+    encoder.base.del = &StepStream::deleteCoil;
+    encoder.stream = this;
+    encoder.coil = coil;
+    if (rmt_new_tx_channel(&config, &channels[coil]) != ESP_OK ||
+        rmt_new_copy_encoder(&copyConfig, &encoder.copy) != ESP_OK ||
+        rmt_enable(channels[coil]) != ESP_OK) {
+      teardown(gpio);
+      return false;
+    }
+  }
+  
+  rmt_sync_manager_config_t syncConfig = {};
+  syncConfig.tx_channel_array = channels;
+  syncConfig.array_size = 4;
+  if (rmt_new_copy_encoder(&copyConfig, &releaseEncoder) != ESP_OK ||
+      rmt_new_sync_manager(&syncConfig, &sync) != ESP_OK) {
+    teardown(gpio);
+    return false;
+  }
+  
+  ready = true;
+  release();
+  return true;
+}
+
+// Undo a begin() that failed part way
+void StepStream::teardown(const int* gpio) {
+  if (sync != nullptr) rmt_del_sync_manager(sync);
+  if (releaseEncoder != nullptr) rmt_del_encoder(releaseEncoder);
+  for (int coil = 0; coil < 4; coil++) {
+    if (encoders[coil].copy != nullptr) rmt_del_encoder(encoders[coil].copy);
+    if (channels[coil] != nullptr) {
+      rmt_disable(channels[coil]);
+      rmt_del_channel(channels[coil]);
+    }
+    encoders[coil].copy = nullptr;
+    channels[coil] = nullptr;
+    esp_rom_gpio_connect_out_signal(gpio[coil], SIG_GPIO_OUT_IDX, false, false);
+  }
+  sync = nullptr;
+  releaseEncoder = nullptr;
+}
+
+void StepStream::start(int position, int phase, int slack) {
+  retired = 0;
+  committed.store(0);
+  finalCount.store(STREAM_NONE);
+  starveAt.store(STREAM_NONE);
+  segments[0].stepCount = 0;
+  
+  lastPlayed.time = 0;
+  lastPlayed.position = position;
+  lastPlayed.slack = (int16_t)slack;
+  lastPlayed.phase = (uint8_t)phase;
+  lastTime = 0;
+  playing = false;
+  active = true;
+}
+
+bool StepStream::hasRoom() const {
+  if (!active || finalCount.load() != STREAM_NONE) return false;
+  if (committed.load() - retired + 1 >= STREAM_SEGMENTS) return false;
+  return (int32_t)(lastTime - elapsed()) < STREAM_LOOKAHEAD_US;
+}
+
+void StepStream::step(uint32_t time, int position, int phase, int slack) {
+  Segment* segment = &openSegment();
+  if (segment->stepCount == STREAM_SEGMENT_STEPS ||
+      (segment->stepCount > 0 && time - segment->steps[0].time >= STREAM_SEGMENT_US)) {
+    commit(time);
+    segment = &openSegment();
+  }
+  
+  StreamStep& s = segment->steps[segment->stepCount++];
+  s.time = time;
+  s.position = position;
+  s.slack = (int16_t)slack;
+  s.phase = (uint8_t)phase;
+  s.reserved = 0;
+  lastTime = time;
+}
+
+void StepStream::finish(uint32_t time) {
+  lastTime = time;
+  uint32_t count = committed.load();
+  if (openSegment().stepCount == 0) {
+    finalCount.store(count);
+    return;
+  }
+  // The final count goes first: playback that sees the last segment
+  // committed must also see that it is the last
+  finalCount.store(count + 1);
+  commit(time);
+}
+
+// Close the open segment, its last interval ending at end
+void StepStream::commit(uint32_t end) {
+  uint32_t next = committed.load() + 1;
+  openSegment().end = end;
+  segments[next % STREAM_SEGMENTS].stepCount = 0;
+  committed.store(next);
+}
+
+void StepStream::service() {
+  if (!active) return;
+  uint32_t last = finalCount.load();
+  if (!playing) {
+    if (last == STREAM_NONE && (int32_t)lastTime < STREAM_LOOKAHEAD_US) return;
+    if (committed.load() == 0) return;
+    play();
+  }
+  
+  // Segments past a starved boundary never play
+  uint32_t limit = min(committed.load(), starveAt.load());
+  uint32_t now = elapsed();
+  while (retired < limit && (int32_t)(now - segments[retired % STREAM_SEGMENTS].end) >= 0) {
+    const Segment& segment = segments[retired % STREAM_SEGMENTS];
+    lastPlayed = segment.steps[segment.stepCount - 1];
+    retired++;
+  }
+  
+  // Played out; the channels must be idle before the next stream
+  if (last != STREAM_NONE && retired >= last) {
+    for (int coil = 0; coil < 4; coil++) {
+      if (rmt_tx_wait_all_done(channels[coil], 0) != ESP_OK) return;
+    }
+    playing = false;
+    active = false;
+  }
+}
+
+bool StepStream::isStarved() const {
+  uint32_t limit = starveAt.load();
+  if (!active || limit == STREAM_NONE) return false;
+  return limit == 0 || (int32_t)(elapsed() - segments[(limit - 1) % STREAM_SEGMENTS].end) >= 0;
+}
+
+void StepStream::play() {
+  rmt_sync_reset(sync);
+  rmt_transmit_config_t config = {};
+  config.flags.eot_level = 0;
+  for (int coil = 0; coil < 4; coil++) {
+    rmt_encoder_reset(&encoders[coil].base);
+    // The payload is unused; the encoder reads the ring
+    rmt_transmit(channels[coil], &encoders[coil].base, this, 1, &config);
+  }
+  startMicros = micros();      // No earlier than the real start, so segments retire late
+  playing = true;
+}
+
+StreamStep StepStream::playedAt(uint32_t time) const {
+  StreamStep reached = lastPlayed;
+  if (!playing) return reached;
+  uint32_t limit = min(committed.load(), starveAt.load());
+  for (uint32_t i = retired; i < limit; i++) {
+    const Segment& segment = segments[i % STREAM_SEGMENTS];
+    for (int s = 0; s < segment.stepCount; s++) {
+      if ((int32_t)(time - segment.steps[s].time) < 0) return reached;
+      reached = segment.steps[s];
+    }
+  }
+  return reached;
+}
+
+bool StepStream::abort(StreamStep& reached) {
+  if (!active) return false;
+  reached = played();
+  if (playing) {
+    // Disabling a channel drops its transmission
+    for (int coil = 0; coil < 4; coil++) {
+      rmt_disable(channels[coil]);
+      rmt_enable(channels[coil]);
+    }
+    release();
+  }
+  playing = false;
+  active = false;
+  return true;
+}
+
+// All coils low: one short low symbol on every channel, ending low
+void StepStream::release() {
+  static const uint32_t low = 1 | (1 << 16);
+  rmt_transmit_config_t config = {};
+  config.flags.eot_level = 0;
+  rmt_sync_reset(sync);
+  for (int coil = 0; coil < 4; coil++) {
+    rmt_transmit(channels[coil], releaseEncoder, &low, sizeof(low), &config);
+  }
+  for (int coil = 0; coil < 4; coil++) {
+    rmt_tx_wait_all_done(channels[coil], 10);
+  }
+}
+
+// ----------------------------------------------------------------
+// Coil encoders - run in the RMT interrupt as each channel needs symbols
+// ----------------------------------------------------------------
+
+// Load the next step interval; false when the stream has no more
+bool IRAM_ATTR StepStream::nextInterval(CoilEncoder& coil) {
+  StepStream* stream = coil.stream;
+  for (;;) {
+    uint32_t index = coil.segment;
+    if (index >= stream->finalCount.load() || index >= stream->starveAt.load()) return false;
+    if (index >= stream->committed.load()) {
+      // Not ready: end here, and make every coil end at the same place
+      uint32_t starve = stream->starveAt.load();
+      while (index < starve && !stream->starveAt.compare_exchange_weak(starve, index)) {
+      }
+      return false;
+    }
+    
+    const Segment& segment = stream->segments[index % STREAM_SEGMENTS];
+    if (coil.step < segment.stepCount) {
+      const StreamStep& s = segment.steps[coil.step++];
+      uint32_t end = coil.step < segment.stepCount ? segment.steps[coil.step].time : segment.end;
+      uint32_t duration = end - s.time;
+      if (duration == 0) continue;
+      coil.remaining = duration;
+      coil.piecesLeft = (duration + STREAM_MAX_HALF - 1) / STREAM_MAX_HALF;
+      coil.level = (stream->levels[s.phase] >> coil.coil) & 1;
+      return true;
+    }
+    coil.segment++;
+    coil.step = 0;
+  }
+}
+
+// Fill the scratch buffer with the coil's next halves
+void IRAM_ATTR StepStream::expand(CoilEncoder& coil) {
+  coil.halves = 0;
+  while (coil.halves < 2 * STREAM_SCRATCH_SYMBOLS) {
+    if (coil.piecesLeft == 0 && !nextInterval(coil)) break;
+    uint32_t piece = (coil.remaining + coil.piecesLeft - 1) / coil.piecesLeft;
+    coil.remaining -= piece;
+    coil.piecesLeft--;
+    uint32_t half = piece | (coil.level << 15);
+    uint32_t& word = coil.scratch[coil.halves / 2];
+    word = (coil.halves & 1) ? word | (half << 16) : half;
+    coil.halves++;
+  }
+  if (coil.halves & 1) {
+    uint32_t& word = coil.scratch[coil.halves / 2];
+    uint32_t last = word & 0x7FFF;
+    uint32_t level = word & 0x8000;
+    if (last > 1) {
+      uint32_t second = last / 2;
+      word = (last - second) | level | ((second | level) << 16);
+    } else {
+      word |= 1 << 16;
+    }
+    coil.halves++;
+  }
+}
+
+size_t IRAM_ATTR StepStream::encodeCoil(rmt_encoder_t* encoder, rmt_channel_handle_t channel,
+                                        const void* data, size_t size, rmt_encode_state_t* state) {
+  CoilEncoder* coil = __containerof(encoder, CoilEncoder, base);
+  size_t encoded = 0;
+  for (;;) {
+    if (coil->halves == 0) {
+      expand(*coil);
+      if (coil->halves == 0) {
+        *state = RMT_ENCODING_COMPLETE;
+        return encoded;
+      }
+    }
+    rmt_encode_state_t copyState = RMT_ENCODING_RESET;
+    encoded += coil->copy->encode(coil->copy, channel, coil->scratch,
+                                  coil->halves / 2 * sizeof(uint32_t), &copyState);
+    if (copyState & RMT_ENCODING_COMPLETE) {
+      coil->halves = 0;
+    }
+    if (copyState & RMT_ENCODING_MEM_FULL) {
+      *state = RMT_ENCODING_MEM_FULL;
+      return encoded;
+    }
+  }
+}
+
+esp_err_t StepStream::resetCoil(rmt_encoder_t* encoder) {
+  CoilEncoder* coil = __containerof(encoder, CoilEncoder, base);
+  rmt_encoder_reset(coil->copy);
+  coil->segment = 0;
+  coil->step = 0;
+  coil->piecesLeft = 0;
+  coil->remaining = 0;
+  coil->halves = 0;
+  return ESP_OK;
+}
+
+#endif // STEP_STREAM_H
@@ -0,0 +1,259 @@
+/*
+ * Step Trace - Per-step timing recorder
+ *
+ * While a trace is running the step interrupt logs every step: when it
+ * fired, how late it was against its scheduled deadline, the coil phase
+ * and the direction. The interrupt only writes a small staging ring in
+ * internal RAM; the motion task drains that into the main ring buffer
+ * (PSRAM when the board has it), delta-encoding each step into 8 bytes.
+ * A trace that cannot keep up stops itself rather than leave holes.
+ *
+ * Export format (little-endian), see tools/decode_trace.py:
+ *   header  "STRC", u8 version, u8 record size, u16 flags,
+ *           u32 record count, u32 base time (us), i32 base position
+ *   records u32 interval (us since the previous step), i16 lateness (us),
+ *           u8 coil phase, u8 flags (TRACE_STEP_*)
+ * Base time and position are the state just before the first record
+ * kept, so absolute values are running sums from there.
+ */
+
+#ifndef STEP_TRACE_H
+#define STEP_TRACE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <esp_heap_caps.h>
+#include "Config.h"
+
+#define TRACE_FORMAT_VERSION 1
+
+// Per-record flags
+#define TRACE_STEP_REVERSE 0x01    // Stepped in the - direction
+#define TRACE_STEP_SLACK 0x02      // Took up backlash; position unchanged
+#define TRACE_STEP_FROM_REST 0x04  // Load was at rest before this step
+#define TRACE_STEP_RESYNC 0x08     // Fell over a step behind; schedule reset
+
+// Header flags
+#define TRACE_WRAPPED 0x0001       // Oldest steps were overwritten
+#define TRACE_OVERFLOWED 0x0002    // Stopped early: staging ring filled up
+
+struct StepTraceRecord {
+  uint32_t interval;
+  int16_t lateness;
+  uint8_t phase;
+  uint8_t flags;
+};
+
+struct StepTraceHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t recordSize;
+  uint16_t flags;
+  uint32_t count;
+  uint32_t baseTime;
+  int32_t basePosition;
+};
+
+class StepTrace {
+private:
+  static_assert((TRACE_STAGING_SIZE & (TRACE_STAGING_SIZE - 1)) == 0,
+                "Trace staging size must be a power of two");
+  static_assert(sizeof(StepTraceRecord) == 8, "Trace records must pack to 8 bytes");
+  
+  // Written by the step interrupt, absolute values
+  struct StepSample {
+    uint32_t time;
+    int32_t position;
+    int16_t lateness;
+    uint8_t phase;
+    uint8_t flags;
+  };
+  
+  StepSample staging[TRACE_STAGING_SIZE];
+  std::atomic<uint32_t> stagingHead;
+  std::atomic<uint32_t> stagingTail;
+  std::atomic<bool> capturing;     // Interrupt records steps
+  std::atomic<bool> active;        // Main ring is being written
+  std::atomic<bool> exporting;     // Main ring is being read
+  volatile bool overflowed;
+  
+  // Main ring - motion task writes, exporter reads once inactive
+  StepTraceRecord* records;
+  uint32_t capacity;
+  uint32_t written;
+  uint32_t baseTime;
+  int32_t basePosition;
+  uint32_t lastTime;
+  
+  static int stepDelta(const StepTraceRecord& r) {
+    if (r.flags & TRACE_STEP_SLACK) return 0;
+    return (r.flags & TRACE_STEP_REVERSE) ? -1 : 1;
+  }
+  
+  void drainStaging();
+  
+public:
+  StepTrace() : stagingHead(0), stagingTail(0), capturing(false), active(false),
+                exporting(false), overflowed(false), records(nullptr), capacity(0),
+                written(0), baseTime(0), basePosition(0), lastTime(0) {}
+                
+  // Motion task only. start() allocates the ring on first use and
+  // returns false if that fails or an export is running.
+  bool start();
+  void stop();
+  void service();                  // Once per motion task pass
+  
+  bool isActive() const { return active.load(std::memory_order_acquire); }
+  uint32_t getCapacity() const { return capacity; }
+  
+  // Step interrupt - one call per step
+  void IRAM_ATTR record(uint32_t time, int32_t position, int32_t lateness, uint8_t phase, uint8_t flags) {
+    if (!capturing.load(std::memory_order_relaxed)) return;
+    
+    uint32_t h = stagingHead.load(std::memory_order_relaxed);
+    if (h - stagingTail.load(std::memory_order_acquire) >= TRACE_STAGING_SIZE) {
+      overflowed = true;
+      capturing.store(false, std::memory_order_relaxed);
+      return;
+    }
+    
+    StepSample& s = staging[h & (TRACE_STAGING_SIZE - 1)];
+    s.time = time;
+    s.position = position;
+    s.lateness = (int16_t)constrain(lateness, -32768, 32767);
+    s.phase = phase;
+    s.flags = flags;
+    stagingHead.store(h + 1, std::memory_order_release);
+  }
+  
+  // Export - network task. beginExport() fails while a trace is
+  // running; between it and endExport() the ring stays untouched.
+  // Records are read oldest first in at most two contiguous pieces.
+  bool beginExport() {
+    exporting.store(true);
+    if (active.load()) {
+      exporting.store(false);
+      return false;
+    }
+    return true;
+  }
+  
+  void endExport() {
+    exporting.store(false);
+  }
+  
+  StepTraceHeader header() const;
+  uint32_t piece(int index, const StepTraceRecord*& data) const;
+};
+
+bool StepTrace::start() {
+  if (isActive()) return true;
+  
+  active.store(true);
+  if (exporting.load()) {
+    active.store(false);
+    return false;
+  }
+  
+  if (records == nullptr) {
+    if (psramFound()) {
+      records = (StepTraceRecord*)heap_caps_malloc(TRACE_PSRAM_RECORDS * sizeof(StepTraceRecord),
+                                                   MALLOC_CAP_SPIRAM);
+      capacity = TRACE_PSRAM_RECORDS;
+    }
+    if (records == nullptr) {
+      records = (StepTraceRecord*)malloc(TRACE_RAM_RECORDS * sizeof(StepTraceRecord));
+      capacity = TRACE_RAM_RECORDS;
+    }
+    if (records == nullptr) {
+      capacity = 0;
+      active.store(false);
+      return false;
+    }
+  }
+  
+  written = 0;
+  overflowed = false;
+  stagingTail.store(stagingHead.load(std::memory_order_acquire), std::memory_order_release);
+  capturing.store(true, std::memory_order_release);
+  return true;
+}
+
+void StepTrace::stop() {
+  if (!isActive()) return;
+  
+  capturing.store(false, std::memory_order_release);
+  drainStaging();
+  active.store(false, std::memory_order_release);
+}
+
+void StepTrace::service() {
+  if (!isActive()) return;
+  
+  drainStaging();
+  if (!capturing.load(std::memory_order_acquire)) {
+    active.store(false, std::memory_order_release);   // Overflowed
+  }
+}
+
+void StepTrace::drainStaging() {
+  uint32_t t = stagingTail.load(std::memory_order_relaxed);
+  uint32_t h = stagingHead.load(std::memory_order_acquire);
+  
+  for (; t != h; t++) {
+    const StepSample& s = staging[t & (TRACE_STAGING_SIZE - 1)];
+    StepTraceRecord r = { 0, s.lateness, s.phase, s.flags };
+    
+    if (written == 0) {
+      baseTime = s.time;
+      basePosition = s.position - stepDelta(r);
+    } else {
+      r.interval = s.time - lastTime;
+    }
+    lastTime = s.time;
+    
+    // Overwriting the oldest record folds it into the base
+    StepTraceRecord& slot = records[written % capacity];
+    if (written >= capacity) {
+      baseTime += slot.interval;
+      basePosition += stepDelta(slot);
+    }
+    slot = r;
+    written++;
+  }
+  
+  stagingTail.store(t, std::memory_order_release);
+}
+
+StepTraceHeader StepTrace::header() const {
+  StepTraceHeader h;
+  memcpy(h.magic, "STRC", 4);
+  h.version = TRACE_FORMAT_VERSION;
+  h.recordSize = sizeof(StepTraceRecord);
+  h.flags = (written > capacity ? TRACE_WRAPPED : 0) | (overflowed ? TRACE_OVERFLOWED : 0);
+  h.count = written < capacity ? written : capacity;
+  h.baseTime = baseTime;
+  h.basePosition = basePosition;
+  return h;
+}
+
+// Piece 0 runs from the oldest record to the end of the buffer, piece 1
+// from the start of the buffer to the newest. Returns the record count.
+uint32_t StepTrace::piece(int index, const StepTraceRecord*& data) const {
+  if (records == nullptr || written == 0) return 0;
+  
+  if (written <= capacity) {
+    data = records;
+    return index == 0 ? written : 0;
+  }
+  
+  uint32_t oldest = written % capacity;
+  if (index == 0) {
+    data = records + oldest;
+    return capacity - oldest;
+  }
+  data = records;
+  return oldest;
+}
+
+#endif // STEP_TRACE_H
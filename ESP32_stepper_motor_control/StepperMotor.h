@@ -1,6 +1,46 @@
 /*
  * Stepper Motor Controller Class
  * Handles acceleration, deceleration, and motor control
+ *
+ * Steps are generated from a hardware timer interrupt rather than from a
+ * polling loop, so slow web/OTA/NVS work does not disturb step timing.
+ * Every axis registers with one shared StepScheduler, whose interrupt
+ * calls onStep() when this axis is due; that path owns currentPosition,
+ * sequenceIndex and the coil outputs.
+ *
+ * Each move is planned once in setTargetPosition() into accel / cruise /
+ * decel phases (trapezoidal, or S-curve when a jerk limit is set). The
+ * step path then updates the step period incrementally in fixed point
+ * using p' = p * (1 -/+ q + q^2), q = a * p^2 / F^2 (Eiderman), so no
+ * division is done per step.
+ *
+ * Backlash compensation works on the logical position (what status
+ * reports). In overshoot mode a target that would be approached against
+ * the preferred direction is reached via a point backlashSteps beyond
+ * it, so the final approach always loads the gears the same way. In
+ * slack mode the step timer models the gear gap: after a reversal the
+ * first backlashSteps steps only cross the gap and leave the logical
+ * position unchanged.
+ *
+ * The class is a template over a coil drive policy (DriveMode.h), so
+ * the phase wrap and coil writes in the step path are resolved at
+ * compile time; StepperMotor is the one DRIVE_MODE selects. A step is
+ * one step of that mode. Speed, acceleration and jerk settings stay in
+ * half-steps and are scaled to drive steps by the planner, which also
+ * keeps cruise speeds out of the configured resonance bands.
+ *
+ * A coordinated move is led by the axis with the longest travel, planned
+ * against limits handed in by the caller instead of its own settings.
+ * The other axes follow it DDA style: every leader step advances each
+ * follower's Bresenham accumulator, and the follower steps in the same
+ * interrupt when it overflows, so the axes stay on the straight line to
+ * within a step and arrive together. It goes straight to the target,
+ * without an overshoot leg.
+ *
+ * With STEP_STREAM (StepStream.h) there is no step interrupt: update()
+ * runs onStep() ahead of time on the stream's clock and hands each step
+ * to the RMT waveform, and the axis reports the position the waveform
+ * has reached.
  */
 
 #ifndef STEPPER_MOTOR_H
@@ -8,26 +48,132 @@
 
 #include <Arduino.h>
 #include "Config.h"
+#include "DriveMode.h"
+#include "StepScheduler.h"
+#include "StepTrace.h"
+#include "Metrics.h"
+#if STEP_STREAM
+#include "StepStream.h"
+#endif
 
-class StepperMotor {
+// Speed, acceleration and jerk limits for a move, in drive steps
+struct MoveLimits {
+  float speed;
+  float accel;
+  float jerk;                      // 0 = trapezoid
+};
+
+// Where pos stands against a travel limit of maxSteps either side. The
+// request handlers check against the status snapshot's maxSteps with
+// this, since the motion task owns each motor's settings.
+inline ErrorCode checkPosition(int pos, int maxSteps, int softLimitWarning = SOFT_LIMIT_WARNING) {
+  if (pos < -maxSteps || pos > maxSteps) {
+    return ERROR_HARD_LIMIT;
+  }
+  if (abs(pos) > maxSteps - softLimitWarning) {
+    return ERROR_SOFT_LIMIT_WARNING;
+  }
+  return ERROR_NONE;
+}
+
+template<typename Drive>
+class BasicStepperMotor {
 private:
-  int currentPosition;
-  int targetPosition;
-  int sequenceIndex;
-  unsigned long lastStepTime;
+  // Move profile produced by planMove(), consumed by the step timer
+  struct MotionPlan {
+    int endPosition;               // Where this plan comes to rest
+    int accelSteps;                // Steps spent ramping to peak speed
+    int decelSteps;                // Steps spent ramping down to rest
+    uint32_t startPeriod;          // First step period from rest (us, Q8)
+    uint32_t peakPeriod;           // Cruise step period (us, Q8)
+    uint32_t accelM;               // Ramp rate a * 2^48 / F^2
+    uint32_t decelM;
+    uint32_t accelJerk;            // Ramp rate growth per us, Q16 (0 = trapezoid)
+    uint32_t decelJerk;
+    uint32_t accelTime;            // Ramp durations (us) for jerk shaping
+    uint32_t decelTime;
+  };
+  
+  volatile int currentPosition;
+  volatile int targetPosition;     // Requested (logical) target
+  int legTarget;                   // Where the current leg goes (overshoot point or target)
+  int slack;                       // Gear gap taken up in the + direction (0..backlashSteps)
+  int sequenceIndex;               // Coil phase, 0..Drive::PHASES-1
   
-  MotorState state;
+  volatile MotorState state;
   
   int currentSpeed;
   
   MotorConfig config;
+  Drive drive;
+  
+  // Step timer
+  StepScheduler* scheduler;
+  int slot;                        // This axis in the scheduler
+  portMUX_TYPE stepLock;
+  volatile bool stepping;
+  int64_t nextStepTime;            // Timer count of the next step (us, Q8)
+  
+  // Motion planner state (owned by the step timer while stepping)
+  MotionPlan plan;
+  uint32_t stepPeriod;             // Current step period (us, Q8)
+  uint32_t phaseTime;              // Time since the current ramp began (us)
+  int stepsSincePlan;
+  int moveDirection;               // -1, 0 (at rest) or 1
+  bool decelerating;
+  bool coordinated;                // Planning against moveLimits
+  MoveLimits moveLimits;
+  
+  // Coordinated moves: axes stepping in proportion to this one
+  struct Follower {
+    BasicStepperMotor* motor;
+    int direction;
+    int distance;                  // Follower's steps in the move
+    int error;                     // Bresenham accumulator
+  };
+  Follower followers[AXIS_COUNT];
+  int followerCount;
+  int leadDistance;                // This axis's steps in the move
+  BasicStepperMotor* volatile leader;  // Axis this one follows, or nullptr
   
-  void setStepperPins(int a, int b, int c, int d);
+  StepTrace* trace;                // Per-step recorder, or nullptr
+  Histogram* lateness;             // Step lateness histogram, or nullptr
+#if STEP_STREAM
+  StepStream* stream;              // Plays this axis's steps, or nullptr
+  
+  void startStream();
+  void fillStream();
+#endif
+  
+  void startStepTimer();
+  int64_t onStep(int64_t now);
+  static int64_t stepCallback(void* context, int64_t now);
+  bool takeUpSlack(int direction);
+  void stepFollowers(int64_t now, int32_t late);
+  void followStep(const BasicStepperMotor* from, int direction, int64_t now, int32_t late);
+  void releaseFollowers(bool halt);
+  
+  // A new target ends a latched emergency stop; call under stepLock
+  void clearEmergencyStop() {
+    if (state == STATE_EMERGENCY_STOP) state = STATE_STOPPED;
+  }
+  
+  void planMove(MotionPlan& out) const;
+  void installPlan(const MotionPlan& newPlan);
+  void replan();
+  static float rampSteps(float fromSpeed, float toSpeed, float accel, float jerk, float& time);
+  uint32_t nextStepPeriod();
+  int approachPoint(int target) const;
   
 public:
-  StepperMotor();
+  BasicStepperMotor();
   
-  void begin(const MotorConfig& cfg);
+  void begin(const MotorConfig& cfg, const CoilPins& pins, int axis, StepScheduler& stepScheduler);
+  void setTrace(StepTrace* recorder) { trace = recorder; }
+  void setLatenessHistogram(Histogram* histogram) { lateness = histogram; }
+#if STEP_STREAM
+  void setStream(StepStream* player) { stream = player; }
+#endif
   void update();
   void stepMotor(int direction);
   void stop();
@@ -35,16 +181,45 @@ public:
   
   // Position control
   void setTargetPosition(int pos);
+  
+  // Coordinated move, with every axis at rest: attach each follower with
+  // its target, then start this axis (the leader) against limits
+  void addFollower(BasicStepperMotor& follower, int pos);
+  void setCoordinatedTarget(int pos, const MoveLimits& limits);
   void setCurrentPosition(int pos);
-  int getCurrentPosition() const { return currentPosition; }
+  void restorePosition(int pos, int phase);
+  int getCurrentPosition() const;
+  int getPhase() const;
   int getTargetPosition() const { return targetPosition; }
   
   // Speed control
   void setSpeed(int speed);
   int getSpeed() const { return currentSpeed; }
   
-  // State queries
-  bool isRunning() const { return state != STATE_IDLE && state != STATE_STOPPED; }
+  // Acceleration profile
+  void setAcceleration(int accel);
+  void setJerk(int jerk);
+  int getAcceleration() const { return config.acceleration; }
+  int getJerk() const { return config.jerk; }
+  
+  // This axis's own limits at the current speed setting
+  MoveLimits limits() const;
+  
+  // Highest speed at or below speed (drive steps/s) outside every
+  // resonance band
+  static float avoidResonance(float speed);
+  
+  // Backlash compensation
+  void setBacklashMode(BacklashMode mode);
+  void setBacklashSteps(int steps);
+  void setBacklashDirection(int direction);
+  BacklashMode getBacklashMode() const { return config.backlashMode; }
+  int getBacklashSteps() const { return config.backlashSteps; }
+  int getBacklashDirection() const { return config.backlashDirection; }
+  
+  // State queries. An emergency stop is at rest; its state stays latched
+  // for status until the next target is set.
+  bool isRunning() const { return state == STATE_RUNNING; }
   MotorState getState() const { return state; }
   
   // Configuration
@@ -57,140 +232,770 @@ public:
   ErrorCode validatePosition(int pos) const;
   bool isNearSoftLimit() const;
   int constrainPosition(int pos) const;
+  int constrainSpeed(int speed) const;
 };
 
+// ----------------------------------------------------------------
+// Fixed-point helpers for the step period recurrence
+// ----------------------------------------------------------------
+#define STEP_TIMER_FREQ 1000000.0f     // Step periods are in microseconds
+#define RAMP_M_SCALE 281.474976710656f // 2^48 / F^2
+#define RAMP_JERK_SCALE 18.446744073709f // 2^64 / F^3
+#define STEPS_PER_HALF_STEP (STEPS_PER_FULL_STEP / 2.0f)  // Half-step settings to drive steps
+
+// Ramp rate at time t into a ramp of length total: constant for a
+// trapezoid, rising and falling at the jerk limit for an S-curve.
+static inline uint32_t IRAM_ATTR rampRate(uint32_t m, uint32_t jerk, uint32_t t, uint32_t total) {
+  if (jerk == 0) return m;
+  uint64_t up = ((uint64_t)jerk * t) >> 16;
+  uint64_t down = (t < total) ? ((uint64_t)jerk * (total - t)) >> 16 : 0;
+  uint64_t rate = min((uint64_t)m, min(up, down));
+  // Keep a floor so the ramp still makes progress at its ends
+  return (uint32_t)max(rate, (uint64_t)(m >> 3));
+}
+
+// q = m * p^2 in Q32, clamped to the range where the series is accurate
+static inline uint64_t IRAM_ATTR rampFactor(uint32_t m, uint32_t period) {
+  uint64_t periodUs = period / PERIOD_ONE;
+  uint64_t q = (periodUs * periodUs * m) >> 16;
+  return min(q, (uint64_t)0x40000000);
+}
+
 // ----------------------------------------------------------------
 // Constructor
 // ----------------------------------------------------------------
-StepperMotor::StepperMotor() 
-  : currentPosition(0), targetPosition(0), sequenceIndex(0), 
-    lastStepTime(0), state(STATE_IDLE), currentSpeed(DEFAULT_SPEED) {
+template<typename Drive>
+BasicStepperMotor<Drive>::BasicStepperMotor()
+  : currentPosition(0), targetPosition(0), legTarget(0), slack(0), sequenceIndex(0),
+    state(STATE_IDLE), currentSpeed(DEFAULT_SPEED),
+    scheduler(nullptr), slot(-1), stepLock(portMUX_INITIALIZER_UNLOCKED),
+    stepping(false), nextStepTime(0), plan(), stepPeriod(0),
+    phaseTime(0), stepsSincePlan(0), moveDirection(0), decelerating(false),
+    coordinated(false), moveLimits(), followers(), followerCount(0), leadDistance(0),
+    leader(nullptr), trace(nullptr), lateness(nullptr) {
+#if STEP_STREAM
+  stream = nullptr;
+#endif
 }
 
 // ----------------------------------------------------------------
-// Initialize motor with configuration
+// Initialize motor with configuration, on the given coil pins and step
+// scheduler
 // ----------------------------------------------------------------
-void StepperMotor::begin(const MotorConfig& cfg) {
+template<typename Drive>
+void BasicStepperMotor<Drive>::begin(const MotorConfig& cfg, const CoilPins& pins, int axis,
+                                     StepScheduler& stepScheduler) {
   config = cfg;
-  currentSpeed = config.defaultSpeed;
-  
-  pinMode(PIN_A, OUTPUT);
-  pinMode(PIN_B, OUTPUT);
-  pinMode(PIN_C, OUTPUT);
-  pinMode(PIN_D, OUTPUT);
+  currentSpeed = constrainSpeed(config.defaultSpeed);
+  slack = config.backlashSteps;    // Assume the gears were last loaded moving +
   
+  drive.begin(pins, axis);
+  scheduler = &stepScheduler;
+  slot = scheduler->add(&BasicStepperMotor::stepCallback, this);
   stop();
 }
 
 // ----------------------------------------------------------------
 // Main update loop - call this frequently
+// Stepping itself runs from the step timer; this only re-arms the
+// timer if a target is pending and the timer is not running (at the
+// start of a move, after coming to rest for a reversal, or at an
+// overshoot point). A follower is stepped by its leader instead.
 // ----------------------------------------------------------------
-void StepperMotor::update() {
-  if (currentPosition == targetPosition) {
-    if (state != STATE_IDLE && state != STATE_STOPPED) {
-      stop();
-    }
+template<typename Drive>
+void BasicStepperMotor<Drive>::update() {
+  if (!stepping && leader == nullptr && currentPosition != targetPosition) {
+    legTarget = coordinated ? targetPosition : approachPoint(targetPosition);
+    replan();
+    startStepTimer();
+  }
+#if STEP_STREAM
+  if (stream != nullptr) {
+    fillStream();
+  }
+#endif
+}
+
+// ----------------------------------------------------------------
+// Step timer
+// ----------------------------------------------------------------
+template<typename Drive>
+int64_t IRAM_ATTR BasicStepperMotor<Drive>::stepCallback(void* context, int64_t now) {
+  return static_cast<BasicStepperMotor*>(context)->onStep(now);
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::startStepTimer() {
+#if STEP_STREAM
+  if (stream != nullptr) {
+    startStream();
     return;
   }
+#endif
+  if (scheduler == nullptr) return;
+  
+  portENTER_CRITICAL(&stepLock);
+  bool needStart = !stepping && currentPosition != targetPosition;
+  if (needStart) {
+    stepping = true;
+    state = STATE_RUNNING;
+    nextStepTime = scheduler->now();
+  }
+  int64_t start = nextStepTime;
+  portEXIT_CRITICAL(&stepLock);
+  
+  if (needStart) {
+    scheduler->schedule(slot, start);
+  }
+}
+
+// Called by the scheduler when this axis may be due; returns the next
+// deadline, or STEP_IDLE once at rest
+template<typename Drive>
+int64_t IRAM_ATTR BasicStepperMotor<Drive>::onStep(int64_t now) {
+  portENTER_CRITICAL_ISR(&stepLock);
+  if (!stepping) {
+    portEXIT_CRITICAL_ISR(&stepLock);
+    return STEP_IDLE;
+  }
+  if (nextStepTime > now + STEP_TIMER_MIN_WAIT * PERIOD_ONE) {
+    // Woken by a deadline left over from before a restart
+    int64_t next = nextStepTime;
+    portEXIT_CRITICAL_ISR(&stepLock);
+    return next;
+  }
   
+  if (currentPosition == plan.endPosition) {
+    // At rest. Release the coils if this is the target; after a
+    // reversal keep them energised and let update() plan the next leg.
+    moveDirection = 0;
+    stepping = false;
+    if (currentPosition == targetPosition) {
+      drive.release();
+      state = STATE_STOPPED;
+    }
+    if (followerCount > 0) {
+      releaseFollowers(false);
+    }
+    portEXIT_CRITICAL_ISR(&stepLock);
+    return STEP_IDLE;
+  }
+  
+  int direction = (plan.endPosition > currentPosition) ? 1 : -1;
+  uint8_t traceFlags = (direction < 0 ? TRACE_STEP_REVERSE : 0) |
+                       (moveDirection == 0 ? TRACE_STEP_FROM_REST : 0);
+  stepMotor(direction);
+  
+  bool moved = !takeUpSlack(direction);
+  if (moved) {
+    currentPosition += direction;
+    moveDirection = direction;
+    stepsSincePlan++;
+    stepPeriod = nextStepPeriod();
+  } else {
+    // Crossing the gear gap - the load does not move. Reversals start
+    // from rest, so this runs at the plan's start period.
+    traceFlags |= TRACE_STEP_SLACK;
+  }
+  
+  // Schedule against the previous deadline so latency does not
+  // accumulate; resync if we have fallen more than a step behind.
+  int32_t late = (int32_t)((now - nextStepTime) / PERIOD_ONE);
+  nextStepTime += stepPeriod;
+  if (nextStepTime < now - (int64_t)stepPeriod) {
+    nextStepTime = now;
+    traceFlags |= TRACE_STEP_RESYNC;
+  }
+  if (trace != nullptr) {
+    trace->record((uint32_t)(now / PERIOD_ONE), currentPosition, late, sequenceIndex, traceFlags);
+  }
+  if (lateness != nullptr) {
+    lateness->observe(late > 0 ? late : 0);
+  }
+  if (moved && followerCount > 0) {
+    stepFollowers(now, late);
+  }
+  int64_t next = nextStepTime;
+  portEXIT_CRITICAL_ISR(&stepLock);
+  return next;
+}
+
+#if STEP_STREAM
+// ----------------------------------------------------------------
+// Streamed stepping - nothing else steps this axis, so the planner state
+// is the motion task's own
+// ----------------------------------------------------------------
+
+// Start a leg where the stream's waveform ends: straight on after a
+// reversal, or a fresh stream once the last one has played out
+template<typename Drive>
+void BasicStepperMotor<Drive>::startStream() {
+  if (stepping || currentPosition == targetPosition || !stream->canAppend()) return;
+  if (!stream->isActive()) {
+    stream->start(currentPosition, sequenceIndex, slack);
+  }
+  portENTER_CRITICAL(&stepLock);
+  stepping = true;
   state = STATE_RUNNING;
-  unsigned long stepDelay = 1000000 / currentSpeed; // microseconds
+  nextStepTime = (int64_t)stream->getRestTime() * PERIOD_ONE;
+  portEXIT_CRITICAL(&stepLock);
+}
+
+// Plan steps up to the stream's lookahead. Each onStep() call is made at
+// its own deadline, so none is late.
+template<typename Drive>
+void BasicStepperMotor<Drive>::fillStream() {
+  stream->service();
+  if (stream->isStarved()) {
+    emergencyStop();             // Stopped short; the coils are where played() says
+    return;
+  }
+  
+  while (stepping && stream->hasRoom()) {
+    int64_t now = nextStepTime;
+    uint32_t time = (uint32_t)(now / PERIOD_ONE);
+    if (onStep(now) == STEP_IDLE) {
+      if (currentPosition == targetPosition) {
+        stream->finish(time);
+      } else {
+        stream->rest(time);
+      }
+      break;
+    }
+    stream->step(time, currentPosition, sequenceIndex, slack);
+  }
+  stream->service();             // Playback starts as soon as the lookahead is planned
   
-  if (micros() - lastStepTime >= stepDelay) {
-    lastStepTime = micros();
-    int direction = (targetPosition > currentPosition) ? 1 : -1;
+  // Running until the waveform has played out
+  portENTER_CRITICAL(&stepLock);
+  if (stream->isActive() && state == STATE_STOPPED) {
+    state = STATE_RUNNING;
+  } else if (!stream->isActive() && !stepping && state == STATE_RUNNING &&
+             currentPosition == targetPosition) {
+    state = STATE_STOPPED;
+  }
+  portEXIT_CRITICAL(&stepLock);
+}
+#endif
+  
+// In slack mode, whether a step only crosses the gear gap after a
+// reversal; takes it up if so. Call with the lock held.
+template<typename Drive>
+bool IRAM_ATTR BasicStepperMotor<Drive>::takeUpSlack(int direction) {
+  if (config.backlashMode != BACKLASH_SLACK ||
+      !((direction > 0 && slack < config.backlashSteps) || (direction < 0 && slack > 0))) {
+    return false;
+  }
+  slack += direction;
+  return true;
+}
+
+// ----------------------------------------------------------------
+// Coordinated moves
+// ----------------------------------------------------------------
+
+// One leader step: each follower steps whenever its accumulator
+// overflows. Runs in the step timer with the leader's lock held.
+template<typename Drive>
+void IRAM_ATTR BasicStepperMotor<Drive>::stepFollowers(int64_t now, int32_t late) {
+  for (int i = 0; i < followerCount; i++) {
+    Follower& follower = followers[i];
+    follower.error += follower.distance;
+    if (follower.error >= leadDistance) {
+      follower.error -= leadDistance;
+      follower.motor->followStep(this, follower.direction, now, late);
+    }
+  }
+}
+
+// A step taken on the leader's timing; the leader's lateness is ours
+template<typename Drive>
+void IRAM_ATTR BasicStepperMotor<Drive>::followStep(const BasicStepperMotor* from, int direction,
+                                                    int64_t now, int32_t late) {
+  portENTER_CRITICAL_ISR(&stepLock);
+  if (leader == from && currentPosition != targetPosition) {
+    uint8_t traceFlags = (direction < 0 ? TRACE_STEP_REVERSE : 0);
     stepMotor(direction);
-    currentPosition += direction;
+    if (takeUpSlack(direction)) {
+      traceFlags |= TRACE_STEP_SLACK;
+    } else {
+      currentPosition += direction;
+    }
+    if (trace != nullptr) {
+      trace->record((uint32_t)(now / PERIOD_ONE), currentPosition, late, sequenceIndex, traceFlags);
+    }
+  }
+  portEXIT_CRITICAL_ISR(&stepLock);
+}
+
+// Hand the followers back at the end of the move; one short of its
+// target (slack) finishes under its own timer. halt stops them where
+// they are instead. Call with the leader's lock held.
+template<typename Drive>
+void IRAM_ATTR BasicStepperMotor<Drive>::releaseFollowers(bool halt) {
+  for (int i = 0; i < followerCount; i++) {
+    BasicStepperMotor& follower = *followers[i].motor;
+    portENTER_CRITICAL_SAFE(&follower.stepLock);
+    if (follower.leader == this) {
+      follower.leader = nullptr;
+      if (halt) {
+        follower.targetPosition = follower.currentPosition;
+        follower.legTarget = follower.currentPosition;
+      }
+      if (follower.currentPosition == follower.targetPosition) {
+        follower.drive.release();
+        follower.state = STATE_STOPPED;
+      }
+    }
+    portEXIT_CRITICAL_SAFE(&follower.stepLock);
   }
+  followerCount = 0;
 }
 
 // ----------------------------------------------------------------
-// Step motor one position
+// Motion planner
 // ----------------------------------------------------------------
-void StepperMotor::stepMotor(int direction) {
-  sequenceIndex += direction;
+
+// Steps (and time) needed to change speed between two rates. With a
+// jerk limit the ramp is a symmetric S-curve, so the mean speed is
+// still the midpoint of the two rates.
+template<typename Drive>
+float BasicStepperMotor<Drive>::rampSteps(float fromSpeed, float toSpeed, float accel, float jerk,
+                                          float& time) {
+  float dv = fabsf(toSpeed - fromSpeed);
   
-  if (sequenceIndex >= STEPS_IN_SEQUENCE) {
-    sequenceIndex = 0;
-  } else if (sequenceIndex < 0) {
-    sequenceIndex = STEPS_IN_SEQUENCE - 1;
+  if (dv <= 0.0f || accel <= 0.0f) {
+    time = 0.0f;
+    return 0.0f;
   }
   
-  setStepperPins(
-    stepSequence[sequenceIndex][0],
-    stepSequence[sequenceIndex][1],
-    stepSequence[sequenceIndex][2],
-    stepSequence[sequenceIndex][3]
-  );
+  if (jerk <= 0.0f) {
+    time = dv / accel;
+  } else if (dv >= accel * accel / jerk) {
+    time = dv / accel + accel / jerk;
+  } else {
+    time = 2.0f * sqrtf(dv / jerk);
+  }
+  return (fromSpeed + toSpeed) * 0.5f * time;
+}
+
+template<typename Drive>
+float BasicStepperMotor<Drive>::avoidResonance(float speed) {
+  for (int i = 0; i < RESONANCE_BAND_COUNT; i++) {
+    float low = (float)resonanceBands[i][0] * STEPS_PER_HALF_STEP;
+    float high = (float)resonanceBands[i][1] * STEPS_PER_HALF_STEP;
+    if (low < high && speed > low && speed < high) {
+      speed = low;
+    }
+  }
+  return speed;
+}
+
+// Work out the accel / cruise / decel phases for the current target,
+// starting from the present position and speed. Works in drive steps.
+template<typename Drive>
+void BasicStepperMotor<Drive>::planMove(MotionPlan& out) const {
+  MoveLimits move = coordinated ? moveLimits : limits();
+  float accel = move.accel;
+  float jerk = move.jerk;
+  float maxSpeed = move.speed;
+  float time;
+  
+  int pos = currentPosition;
+  int target = legTarget;
+  int dir = moveDirection;
+  float speed = (dir != 0 && stepPeriod > 0) ? STEP_TIMER_FREQ * PERIOD_ONE / stepPeriod : 0.0f;
+  
+  // First step period from rest
+  float startPeriod = (jerk > 0.0f)
+    ? STEP_TIMER_FREQ * cbrtf(6.0f / jerk)
+    : 0.676f * STEP_TIMER_FREQ * sqrtf(2.0f / accel);
+  
+  out.accelSteps = 0;
+  out.decelSteps = 0;
+  out.accelTime = 0;
+  out.decelTime = 0;
+  out.accelM = (uint32_t)(accel * RAMP_M_SCALE);
+  out.decelM = out.accelM;
+  out.accelJerk = (uint32_t)(jerk * RAMP_JERK_SCALE);
+  out.decelJerk = out.accelJerk;
+  out.startPeriod = (uint32_t)(startPeriod * PERIOD_ONE);
+  
+  int distance = abs(target - pos);
+  int targetDir = (target > pos) ? 1 : (target < pos) ? -1 : 0;
+  float stopSteps = rampSteps(0.0f, speed, accel, jerk, time);
+  
+  if (dir != 0 && targetDir != dir) {
+    // Reversal (or target behind us) - ramp down to rest first
+    out.decelSteps = (int)ceilf(stopSteps);
+    out.decelTime = (uint32_t)(time * STEP_TIMER_FREQ);
+    out.endPosition = pos + dir * out.decelSteps;
+    out.peakPeriod = stepPeriod;
+    return;
+  }
+  
+  out.endPosition = target;
+  
+  if (dir != 0 && stopSteps >= distance) {
+    // Too close to stop at the configured rate - brake over what is left
+    float brake = speed * speed / (2.0f * max(distance, 1));
+    out.decelSteps = distance;
+    out.decelM = (uint32_t)(brake * RAMP_M_SCALE);
+    out.decelJerk = 0;
+    out.peakPeriod = stepPeriod;
+    return;
+  }
+  
+  // Highest peak speed whose ramps fit in the distance
+  float peak = maxSpeed;
+  float upTime, downTime;
+  if (speed < maxSpeed &&
+      rampSteps(speed, maxSpeed, accel, jerk, upTime) + rampSteps(0.0f, maxSpeed, accel, jerk, downTime) > distance) {
+    float lo = speed, hi = maxSpeed;
+    for (int i = 0; i < 24; i++) {
+      float mid = 0.5f * (lo + hi);
+      if (rampSteps(speed, mid, accel, jerk, upTime) + rampSteps(0.0f, mid, accel, jerk, downTime) > distance) {
+        hi = mid;
+      } else {
+        lo = mid;
+      }
+    }
+    peak = lo;
+  }
+  peak = avoidResonance(peak);
+  
+  // Never cruise slower than the first step from rest
+  float peakPeriod = min(STEP_TIMER_FREQ / max(peak, 1.0f), startPeriod);
+  peak = STEP_TIMER_FREQ / peakPeriod;
+  
+  out.accelSteps = (int)(rampSteps(speed, peak, accel, jerk, upTime) + 0.5f);
+  out.decelSteps = (int)(rampSteps(0.0f, peak, accel, jerk, downTime) + 0.5f);
+  if (out.accelSteps + out.decelSteps > distance) {
+    out.decelSteps = min(out.decelSteps, distance);
+    out.accelSteps = distance - out.decelSteps;
+  }
+  out.accelTime = (uint32_t)(upTime * STEP_TIMER_FREQ);
+  out.decelTime = (uint32_t)(downTime * STEP_TIMER_FREQ);
+  out.peakPeriod = (uint32_t)(peakPeriod * PERIOD_ONE);
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::installPlan(const MotionPlan& newPlan) {
+  portENTER_CRITICAL(&stepLock);
+  plan = newPlan;
+  stepsSincePlan = 0;
+  phaseTime = 0;
+  decelerating = false;
+  if (moveDirection == 0) {
+    stepPeriod = plan.startPeriod;
+  }
+  portEXIT_CRITICAL(&stepLock);
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::replan() {
+  MotionPlan newPlan;
+  planMove(newPlan);
+  installPlan(newPlan);
+}
+
+// Period of the next step, from the current phase of the plan.
+// Runs in the step timer with the lock held - integer math only.
+template<typename Drive>
+uint32_t IRAM_ATTR BasicStepperMotor<Drive>::nextStepPeriod() {
+  int remaining = abs(plan.endPosition - currentPosition);
+  uint64_t period = stepPeriod;
+  
+  if (remaining <= plan.decelSteps) {
+    if (!decelerating) {
+      decelerating = true;
+      phaseTime = 0;
+    }
+    uint64_t q = rampFactor(rampRate(plan.decelM, plan.decelJerk, phaseTime, plan.decelTime), stepPeriod);
+    period += (period * q) >> 32;
+    period += (period * ((q * q) >> 32)) >> 32;
+    period = min(period, (uint64_t)max(plan.startPeriod, stepPeriod));
+  } else if (stepsSincePlan < plan.accelSteps && period != plan.peakPeriod) {
+    uint64_t q = rampFactor(rampRate(plan.accelM, plan.accelJerk, phaseTime, plan.accelTime), stepPeriod);
+    uint64_t q2 = (period * ((q * q) >> 32)) >> 32;
+    if (period > plan.peakPeriod) {
+      period = period - ((period * q) >> 32) + q2;
+      period = max(period, (uint64_t)plan.peakPeriod);
+    } else {
+      period = period + ((period * q) >> 32) + q2;
+      period = min(period, (uint64_t)plan.peakPeriod);
+    }
+  } else {
+    period = plan.peakPeriod;
+  }
+  
+  phaseTime += (uint32_t)(period / PERIOD_ONE);
+  return (uint32_t)period;
 }
 
 // ----------------------------------------------------------------
-// Set stepper motor coil states
+// Step motor one position
 // ----------------------------------------------------------------
-void StepperMotor::setStepperPins(int a, int b, int c, int d) {
-  digitalWrite(PIN_A, a);
-  digitalWrite(PIN_B, b);
-  digitalWrite(PIN_C, c);
-  digitalWrite(PIN_D, d);
+template<typename Drive>
+void IRAM_ATTR BasicStepperMotor<Drive>::stepMotor(int direction) {
+  sequenceIndex = (sequenceIndex + direction) & (Drive::PHASES - 1);
+  drive.drive(sequenceIndex);
 }
 
 // ----------------------------------------------------------------
-// Normal stop - turn off coils
+// Normal stop - halt the step timer and turn off coils
 // ----------------------------------------------------------------
-void StepperMotor::stop() {
-  digitalWrite(PIN_A, LOW);
-  digitalWrite(PIN_B, LOW);
-  digitalWrite(PIN_C, LOW);
-  digitalWrite(PIN_D, LOW);
+template<typename Drive>
+void BasicStepperMotor<Drive>::stop() {
+#if STEP_STREAM
+  StreamStep reached;
+  bool rewind = stream != nullptr && stream->abort(reached);
+#endif
+  portENTER_CRITICAL(&stepLock);
+  stepping = false;
+  moveDirection = 0;
+  leader = nullptr;
+  if (followerCount > 0) {
+    releaseFollowers(true);
+  }
+  drive.release();
   state = STATE_STOPPED;
+#if STEP_STREAM
+  if (rewind) {
+    // Back to where the coils got to; the rest of the plan never played
+    currentPosition = reached.position;
+    sequenceIndex = reached.phase;
+    slack = reached.slack;
+  }
+#endif
+  portEXIT_CRITICAL(&stepLock);
 }
 
 // ----------------------------------------------------------------
 // Emergency stop - immediate
 // ----------------------------------------------------------------
-void StepperMotor::emergencyStop() {
-  targetPosition = currentPosition;
+template<typename Drive>
+void BasicStepperMotor<Drive>::emergencyStop() {
   stop();
+  portENTER_CRITICAL(&stepLock);
+  targetPosition = currentPosition;
+  legTarget = currentPosition;
   state = STATE_EMERGENCY_STOP;
+  portEXIT_CRITICAL(&stepLock);
 }
 
 // ----------------------------------------------------------------
 // Position control
 // ----------------------------------------------------------------
-void StepperMotor::setTargetPosition(int pos) {
+template<typename Drive>
+void BasicStepperMotor<Drive>::setTargetPosition(int pos) {
   int constrainedPos = constrainPosition(pos);
+  
+  portENTER_CRITICAL(&stepLock);
   targetPosition = constrainedPos;
+  leader = nullptr;
+  clearEmergencyStop();
+  if (followerCount > 0) {
+    releaseFollowers(false);     // They finish their own moves
+  }
+  portEXIT_CRITICAL(&stepLock);
+  coordinated = false;
+  legTarget = approachPoint(constrainedPos);
   
-  if (targetPosition != currentPosition) {
-    state = STATE_RUNNING;
+  if (stepping || currentPosition != targetPosition) {
+    replan();
   }
+  startStepTimer();
 }
 
-void StepperMotor::setCurrentPosition(int pos) {
+template<typename Drive>
+void BasicStepperMotor<Drive>::addFollower(BasicStepperMotor& follower, int pos) {
+  if (followerCount >= AXIS_COUNT || &follower == this) return;
+  int constrainedPos = follower.constrainPosition(pos);
+  
+  portENTER_CRITICAL(&follower.stepLock);
+  int distance = constrainedPos - follower.currentPosition;
+  follower.targetPosition = constrainedPos;
+  follower.legTarget = constrainedPos;
+  follower.leader = this;
+  follower.clearEmergencyStop();
+  if (distance != 0) {
+    follower.state = STATE_RUNNING;
+  }
+  portEXIT_CRITICAL(&follower.stepLock);
+  
+  portENTER_CRITICAL(&stepLock);
+  Follower& added = followers[followerCount++];
+  added.motor = &follower;
+  added.direction = (distance < 0) ? -1 : 1;
+  added.distance = abs(distance);
+  added.error = 0;
+  portEXIT_CRITICAL(&stepLock);
+}
+
+// The leader of a coordinated move: planned against the given limits and
+// driven straight to the target. Its travel must be the longest.
+template<typename Drive>
+void BasicStepperMotor<Drive>::setCoordinatedTarget(int pos, const MoveLimits& limits) {
+  int constrainedPos = constrainPosition(pos);
+  
+  portENTER_CRITICAL(&stepLock);
+  targetPosition = constrainedPos;
+  leader = nullptr;
+  clearEmergencyStop();
+  leadDistance = abs(constrainedPos - currentPosition);
+  for (int i = 0; i < followerCount; i++) {
+    if (followers[i].distance > leadDistance) leadDistance = 0;
+    followers[i].error = leadDistance / 2;     // Round each follower step to the nearest
+  }
+  if (leadDistance == 0 && followerCount > 0) {
+    releaseFollowers(false);     // Nothing to follow
+  }
+  portEXIT_CRITICAL(&stepLock);
+  coordinated = true;
+  moveLimits = limits;
+  legTarget = constrainedPos;
+  
+  if (stepping || currentPosition != targetPosition) {
+    replan();
+  }
+  startStepTimer();
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::setCurrentPosition(int pos) {
+  stop();
+  portENTER_CRITICAL(&stepLock);
   currentPosition = pos;
   targetPosition = pos;
+  legTarget = pos;
   state = STATE_IDLE;
+  portEXIT_CRITICAL(&stepLock);
+}
+
+// Position and coil phase from before a power cycle
+template<typename Drive>
+void BasicStepperMotor<Drive>::restorePosition(int pos, int phase) {
+  setCurrentPosition(pos);
+  portENTER_CRITICAL(&stepLock);
+  sequenceIndex = (phase >= 0 && phase < Drive::PHASES) ? phase : 0;
+  portEXIT_CRITICAL(&stepLock);
+}
+
+// Where the coils are. A streamed move is planned ahead of them, so
+// while it plays this is the stream's played position instead.
+template<typename Drive>
+int BasicStepperMotor<Drive>::getCurrentPosition() const {
+#if STEP_STREAM
+  if (stream != nullptr && stream->isActive()) return stream->played().position;
+#endif
+  return currentPosition;
+}
+
+template<typename Drive>
+int BasicStepperMotor<Drive>::getPhase() const {
+#if STEP_STREAM
+  if (stream != nullptr && stream->isActive()) return stream->played().phase;
+#endif
+  return sequenceIndex;
 }
 
 // ----------------------------------------------------------------
 // Speed control
 // ----------------------------------------------------------------
-void StepperMotor::setSpeed(int speed) {
-  if (speed < config.minSpeed) speed = config.minSpeed;
-  if (speed > config.maxSpeed) speed = config.maxSpeed;
+template<typename Drive>
+void BasicStepperMotor<Drive>::setSpeed(int speed) {
+  speed = constrainSpeed(speed);
+  portENTER_CRITICAL(&stepLock);
   currentSpeed = speed;
+  portEXIT_CRITICAL(&stepLock);
+  coordinated = false;             // Leave the coordinated profile
+  
+  if (stepping) {
+    replan();
+  }
+}
+
+// ----------------------------------------------------------------
+// Acceleration profile
+// ----------------------------------------------------------------
+template<typename Drive>
+void BasicStepperMotor<Drive>::setAcceleration(int accel) {
+  if (accel > 0) {
+    config.acceleration = accel;
+  }
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::setJerk(int jerk) {
+  if (jerk >= 0) {
+    config.jerk = jerk;
+  }
+}
+
+template<typename Drive>
+MoveLimits BasicStepperMotor<Drive>::limits() const {
+  MoveLimits own;
+  own.speed = (float)currentSpeed * STEPS_PER_HALF_STEP;
+  own.accel = (float)config.acceleration * STEPS_PER_HALF_STEP;
+  own.jerk = (float)config.jerk * STEPS_PER_HALF_STEP;
+  return own;
+}
+
+// ----------------------------------------------------------------
+// Backlash compensation
+// ----------------------------------------------------------------
+
+// First point to drive to for target: in overshoot mode, a target that
+// would be approached against the preferred direction is passed by
+// backlashSteps first.
+template<typename Drive>
+int BasicStepperMotor<Drive>::approachPoint(int target) const {
+  if (config.backlashMode != BACKLASH_OVERSHOOT || config.backlashSteps <= 0) {
+    return target;
+  }
+  int direction = (target > currentPosition) ? 1 : (target < currentPosition) ? -1 : 0;
+  if (direction == 0 || direction == config.backlashDirection) {
+    return target;
+  }
+  return constrainPosition(target - config.backlashDirection * config.backlashSteps);
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::setBacklashMode(BacklashMode mode) {
+  portENTER_CRITICAL(&stepLock);
+  config.backlashMode = mode;
+  portEXIT_CRITICAL(&stepLock);
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::setBacklashSteps(int steps) {
+  if (steps < 0) return;
+  portENTER_CRITICAL(&stepLock);
+  // Stay on whichever side of the gap the gears were nearest
+  slack = (2 * slack >= config.backlashSteps) ? steps : 0;
+  config.backlashSteps = steps;
+  portEXIT_CRITICAL(&stepLock);
+}
+
+template<typename Drive>
+void BasicStepperMotor<Drive>::setBacklashDirection(int direction) {
+  if (direction != 1 && direction != -1) return;
+  config.backlashDirection = direction;
 }
 
 // ----------------------------------------------------------------
 // Configuration
 // ----------------------------------------------------------------
-void StepperMotor::setMaxSteps(int steps) {
+template<typename Drive>
+void BasicStepperMotor<Drive>::setMaxSteps(int steps) {
   if (steps > 0) {
     config.maxSteps = steps;
   }
 }
 
-void StepperMotor::setStepsPerRotation(int steps) {
+template<typename Drive>
+void BasicStepperMotor<Drive>::setStepsPerRotation(int steps) {
   if (steps > 0) {
     config.stepsPerRotation = steps;
   }
@@ -199,24 +1004,30 @@ void StepperMotor::setStepsPerRotation(int steps) {
 // ----------------------------------------------------------------
 // Safety functions
 // ----------------------------------------------------------------
-ErrorCode StepperMotor::validatePosition(int pos) const {
-  if (pos < -config.maxSteps || pos > config.maxSteps) {
-    return ERROR_HARD_LIMIT;
-  }
-  if (abs(pos) > config.maxSteps - config.softLimitWarning) {
-    return ERROR_SOFT_LIMIT_WARNING;
-  }
-  return ERROR_NONE;
+template<typename Drive>
+ErrorCode BasicStepperMotor<Drive>::validatePosition(int pos) const {
+  return checkPosition(pos, config.maxSteps, config.softLimitWarning);
 }
 
-bool StepperMotor::isNearSoftLimit() const {
+template<typename Drive>
+bool BasicStepperMotor<Drive>::isNearSoftLimit() const {
   return abs(currentPosition) > config.maxSteps - config.softLimitWarning;
 }
 
-int StepperMotor::constrainPosition(int pos) const {
+template<typename Drive>
+int BasicStepperMotor<Drive>::constrainPosition(int pos) const {
   if (pos < -config.maxSteps) return -config.maxSteps;
   if (pos > config.maxSteps) return config.maxSteps;
   return pos;
 }
 
+template<typename Drive>
+int BasicStepperMotor<Drive>::constrainSpeed(int speed) const {
+  if (speed < config.minSpeed) return config.minSpeed;
+  if (speed > config.maxSpeed) return config.maxSpeed;
+  return speed;
+}
+
+typedef BasicStepperMotor<SelectedDrive> StepperMotor;
+
 #endif // STEPPER_MOTOR_H
@@ -0,0 +1,76 @@
+/*
+ * Host Sketch - see HostSketch.h
+ */
+
+#include "stepper_motor.ino"
+#include "HostSketch.h"
+
+static int64_t lastMotionPass;
+static bool motionHeld;
+
+// The motion task wakes at once when a handler queued a command
+static void wakeMotion() {
+  if (!motionHeld && hostTakeNotifications(motionTaskHandle) > 0) {
+    motionPass();
+    lastMotionPass = hostMicros();
+  }
+}
+
+void hostSketchBegin() {
+  setup();
+  beginMotion();
+  motionPass();
+  lastMotionPass = hostMicros();
+}
+
+void hostSketchRun(int64_t us) {
+  int64_t end = hostMicros() + us;
+  while (hostMicros() < end) {
+    hostAdvanceTo(min(end, hostMicros() + 1000));
+    if (motionHeld) {
+      // Not woken; notifications wait for the release
+    } else if (hostTakeNotifications(motionTaskHandle) > 0 ||
+               hostMicros() - lastMotionPass >= MOTION_TASK_INTERVAL * 1000) {
+      motionPass();
+      lastMotionPass = hostMicros();
+    }
+    serviceNetwork();
+    wakeMotion();
+  }
+}
+
+bool hostSketchSettle(int64_t timeout) {
+  int64_t end = hostMicros() + timeout;
+  while (hostMicros() < end) {
+    hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+    bool moving = false;
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      MotorStatus status = statusSnapshots[axis].read();
+      moving |= status.running || status.position != status.target || sequenceRunners[axis].isActive();
+    }
+    if (!moving) return true;
+  }
+  return false;
+}
+
+HostResponse hostHttp(const char* method, const char* uri, const char* body, const char* headers) {
+  HostResponse response = server.request(strcmp(method, "GET") == 0 ? HTTP_GET : HTTP_POST, uri, body, headers);
+  wakeMotion();
+  return response;
+}
+
+void hostWsConnect(uint8_t num) { webSocket.connect(num); }
+void hostWsDisconnect(uint8_t num) { webSocket.disconnect(num); }
+
+void hostWsSend(uint8_t num, const char* text) {
+  webSocket.receive(num, text);
+  wakeMotion();
+}
+
+std::vector<HostWsMessage> hostWsTake(uint8_t num) { return webSocket.take(num); }
+
+MotorStatus hostSketchStatus(int axis) { return statusSnapshots[axis].read(); }
+
+bool hostSketchFlushIfQuiet() { return configStore.flushIfQuiet(); }
+
+void hostSketchHoldMotion(bool held) { motionHeld = held; }
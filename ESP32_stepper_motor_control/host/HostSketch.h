@@ -0,0 +1,46 @@
+/*
+ * Host Sketch - stepper_motor.ino running on the host simulator
+ *
+ * HostSketch.cpp is the one translation unit that includes the sketch.
+ * hostSketchBegin() runs setup() and the motion task's start-up; after
+ * that hostSketchRun() plays both tasks on the virtual clock: the
+ * network task every tick, the motion task every MOTION_TASK_INTERVAL or
+ * as soon as a command wakes it, as on the device. Requests and
+ * WebSocket messages go straight to the sketch's handlers.
+ *
+ * The config flush task does not run here; call hostSketchFlushIfQuiet()
+ * where its delay would have run out.
+ */
+
+#ifndef HOST_SKETCH_H
+#define HOST_SKETCH_H
+
+#include <string>
+#include <vector>
+#include <WebServer.h>
+#include <WebSocketsServer.h>
+#include "Config.h"
+
+void hostSketchBegin();
+void hostSketchRun(int64_t us);
+
+// Run until every axis is at rest on its target; false on timeout
+bool hostSketchSettle(int64_t timeout = 120000000);
+
+// An HTTP request, method "GET" or "POST"; uri may carry a query
+HostResponse hostHttp(const char* method, const char* uri, const char* body = "", const char* headers = "");
+
+// WebSocket client num connects, sends text, and reads what it was sent
+void hostWsConnect(uint8_t num);
+void hostWsDisconnect(uint8_t num);
+void hostWsSend(uint8_t num, const char* text);
+std::vector<HostWsMessage> hostWsTake(uint8_t num);
+
+MotorStatus hostSketchStatus(int axis);
+bool hostSketchFlushIfQuiet();
+
+// While held the motion task does not run, as if it were busy, so
+// commands pile up in its queue
+void hostSketchHoldMotion(bool held);
+
+#endif // HOST_SKETCH_H
@@ -0,0 +1,59 @@
+/*
+ * Host Alloc - Counts heap allocations for the benches
+ *
+ * malloc and friends are interposed over glibc's and forward to it;
+ * operator new comes through malloc. Linked into the benches only.
+ */
+
+#include <stddef.h>
+#include <atomic>
+#include "HostBench.h"
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* pointer);
+}
+
+static std::atomic<uint64_t> allocations(0);
+
+uint64_t hostAllocations() { return allocations.load(std::memory_order_relaxed); }
+
+extern "C" {
+void* malloc(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pointer, size_t alignment, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  *pointer = __libc_memalign(alignment, size);
+  return *pointer != nullptr ? 0 : 12;   // ENOMEM
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+void free(void* pointer) {
+  __libc_free(pointer);
+}
+}
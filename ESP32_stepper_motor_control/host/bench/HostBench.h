@@ -0,0 +1,239 @@
+/*
+ * Host Bench - Minimal benchmark registry for the host build
+ *
+ * BENCH(name) { ... } registers a benchmark; its body sets up and
+ * returns hostMeasure(iterations, operation). The operation runs in
+ * rounds and the fastest round counts, as the one least disturbed by
+ * the rest of the machine. Each bench starts from hostReset() unless
+ * the runner is told not to (benches that share a booted sketch).
+ * hostRunBenches() runs them all (or those named on the command line)
+ * and prints the time, heap allocations and GPIO register accesses per
+ * operation; on the chip a GPIO register read stalls on the peripheral
+ * bus, which the host timing does not show. A bench whose result goes
+ * through hostNoAllocations() fails if the operation allocates.
+ *
+ * Options:
+ *   --baseline FILE     fail on a regression against FILE: more
+ *                       allocations than recorded, or a time more than
+ *                       the threshold (and HOST_BENCH_SLACK_NS) over the
+ *                       recorded one
+ *   --threshold PCT     allowed slowdown, default HOST_BENCH_THRESHOLD
+ *                       (or the HOST_BENCH_THRESHOLD environment variable)
+ *   --allocations-only  compare allocations, not times (unoptimised builds)
+ *   --update-baseline   write this run's results into FILE instead
+ *
+ * A baseline holds "name ns allocations" lines for every bench binary;
+ * an update replaces only the lines of the benches that ran. Checked
+ * against a baseline, a bench with no line there fails.
+ */
+
+#ifndef HOST_BENCH_H
+#define HOST_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "HostSim.h"
+
+struct HostBenchResult {
+  double ns;                       // Per operation, fastest round
+  double allocations;              // Per operation
+  double regReads;
+  double regWrites;
+  bool allocationFree;             // Fail if the operation allocates
+};
+
+// Heap allocations so far (HostAlloc.cpp)
+uint64_t hostAllocations();
+
+struct HostBenchCase {
+  const char* name;
+  HostBenchResult (*run)();
+};
+
+static inline std::vector<HostBenchCase>& hostBenches() {
+  static std::vector<HostBenchCase> benches;
+  return benches;
+}
+
+struct HostBenchRegistrar {
+  HostBenchRegistrar(const char* name, HostBenchResult (*run)()) { hostBenches().push_back({ name, run }); }
+};
+
+#define BENCH(name)                                             \
+  static HostBenchResult name();                                \
+  static HostBenchRegistrar name##Registrar(#name, name);       \
+  static HostBenchResult name()
+  
+static const int HOST_BENCH_ROUNDS = 7;
+static const double HOST_BENCH_THRESHOLD = 100;  // Percent: a doubling
+static const double HOST_BENCH_SLACK_NS = 2;     // Allowed on top, for the fastest benches
+
+// Keep a result the compiler would otherwise discard
+template<typename T>
+static inline void hostKeep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// operation(i) for i in [0, iterations), per round
+template<typename Operation>
+static HostBenchResult hostMeasure(int iterations, Operation operation) {
+  HostBenchResult result = { 1e30, 0, 0, 0, false };
+  uint64_t allocationsBefore = hostAllocations();
+  HostRegStats before = hostRegStats();
+  for (int round = 0; round < HOST_BENCH_ROUNDS; round++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) operation(i);
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    result.ns = std::min(result.ns, elapsed.count() / iterations);
+  }
+  HostRegStats after = hostRegStats();
+  double operations = (double)iterations * HOST_BENCH_ROUNDS;
+  result.allocations = (hostAllocations() - allocationsBefore) / operations;
+  result.regReads = (after.reads - before.reads) / operations;
+  result.regWrites = (after.writes - before.writes) / operations;
+  return result;
+}
+
+static inline HostBenchResult hostNoAllocations(HostBenchResult result) {
+  result.allocationFree = true;
+  return result;
+}
+
+// ----------------------------------------------------------------
+// Baselines
+// ----------------------------------------------------------------
+struct HostBaselineEntry {
+  std::string name;
+  double ns;
+  double allocations;
+};
+
+// Entries of a baseline file; comment lines start with '#'
+static inline std::vector<HostBaselineEntry> hostReadBaseline(const char* path, std::vector<std::string>& comments) {
+  std::vector<HostBaselineEntry> entries;
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) return entries;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#') {
+      comments.push_back(line);
+      continue;
+    }
+    char name[128];
+    HostBaselineEntry entry;
+    if (sscanf(line, "%127s %lf %lf", name, &entry.ns, &entry.allocations) == 3) {
+      entry.name = name;
+      entries.push_back(entry);
+    }
+  }
+  fclose(file);
+  return entries;
+}
+
+static inline bool hostWriteBaseline(const char* path, const std::vector<std::string>& comments,
+                                     const std::vector<HostBaselineEntry>& entries) {
+  FILE* file = fopen(path, "w");
+  if (file == nullptr) return false;
+  for (const std::string& comment : comments) fputs(comment.c_str(), file);
+  for (const HostBaselineEntry& entry : entries) {
+    fprintf(file, "%s %.1f %.3f\n", entry.name.c_str(), entry.ns, entry.allocations);
+  }
+  return fclose(file) == 0;
+}
+
+static inline HostBaselineEntry* hostFindBaseline(std::vector<HostBaselineEntry>& entries, const char* name) {
+  for (HostBaselineEntry& entry : entries) {
+    if (entry.name == name) return &entry;
+  }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------
+// Runner
+// ----------------------------------------------------------------
+static inline int hostRunBenches(int argc, char** argv, bool reset = true) {
+  const char* baselinePath = nullptr;
+  const char* envThreshold = getenv("HOST_BENCH_THRESHOLD");
+  double threshold = envThreshold ? atof(envThreshold) : HOST_BENCH_THRESHOLD;
+  bool update = false;
+  bool checkTimes = true;
+  std::vector<const char*> names;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+      threshold = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--update-baseline") == 0) {
+      update = true;
+    } else if (strcmp(argv[i], "--allocations-only") == 0) {
+      checkTimes = false;
+    } else {
+      names.push_back(argv[i]);
+    }
+  }
+  if (update && baselinePath == nullptr) {
+    fprintf(stderr, "--update-baseline needs --baseline FILE\n");
+    return 1;
+  }
+  std::vector<std::string> comments;
+  std::vector<HostBaselineEntry> baseline;
+  if (baselinePath != nullptr) baseline = hostReadBaseline(baselinePath, comments);
+  
+  int run = 0;
+  int failures = 0;
+  for (const HostBenchCase& bench : hostBenches()) {
+    bool wanted = names.empty();
+    for (const char* name : names) wanted |= strcmp(name, bench.name) == 0;
+    if (!wanted) continue;
+    if (reset) hostReset();
+    HostBenchResult result = bench.run();
+    printf("%-28s %10.1f ns %8.3f allocs %6.2f reg reads %6.2f reg writes", bench.name, result.ns,
+           result.allocations, result.regReads, result.regWrites);
+    run++;
+    
+    if (result.allocationFree && result.allocations > 0) {
+      printf("  FAIL: allocates\n");
+      failures++;
+      continue;
+    }
+    HostBaselineEntry* recorded = hostFindBaseline(baseline, bench.name);
+    if (update) {
+      if (recorded == nullptr) {
+        baseline.push_back({ bench.name, 0, 0 });
+        recorded = &baseline.back();
+      }
+      recorded->ns = result.ns;
+      recorded->allocations = result.allocations;
+      printf("\n");
+    } else if (baselinePath == nullptr) {
+      printf("\n");
+    } else if (recorded == nullptr) {
+      printf("  FAIL: no baseline\n");
+      failures++;
+    } else if (result.allocations > recorded->allocations + 0.0005) {
+      printf("  FAIL: %.3f allocs in baseline\n", recorded->allocations);
+      failures++;
+    } else if (checkTimes && result.ns > recorded->ns * (1 + threshold / 100) + HOST_BENCH_SLACK_NS) {
+      printf("  FAIL: %.0f%% over baseline %.1f ns\n", (result.ns / recorded->ns - 1) * 100, recorded->ns);
+      failures++;
+    } else {
+      printf("  %+.0f%%\n", (result.ns / recorded->ns - 1) * 100);
+    }
+  }
+  if (run == 0) {
+    fprintf(stderr, "No benches matched\n");
+    return 1;
+  }
+  if (update && failures == 0 && !hostWriteBaseline(baselinePath, comments, baseline)) {
+    fprintf(stderr, "Cannot write %s\n", baselinePath);
+    return 1;
+  }
+  return failures == 0 ? 0 : 1;
+}
+
+#endif // HOST_BENCH_H
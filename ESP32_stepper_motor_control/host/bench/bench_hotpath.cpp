@@ -0,0 +1,96 @@
+/*
+ * Step path benches - coil writes as the step interrupt makes them, the
+ * interrupt's whole step, and the motion task's motor calls. Pin
+ * logging is off, so what is timed is the firmware and the register
+ * stores, not the simulator's bookkeeping.
+ */
+
+#include "HostBench.h"
+#include "HostTest.h"
+#include "StepperMotor.h"
+
+static const int COIL_WRITES = 1000000;
+static const int MOTOR_CALLS = 100000;
+static const int LONG_TRAVEL = 2000000;
+
+// One axis cruising on a move long enough to outlast the bench
+struct Cruise {
+  StepScheduler scheduler;
+  StepperMotor motor;
+  int64_t interval;                // us per step at cruise
+  
+  Cruise() {
+    motor.begin(hostMotorConfig(LONG_TRAVEL, MAX_SPEED), axisPins[0], 0, scheduler);
+    scheduler.begin();
+    hostPinLogging(false);
+    motor.setTargetPosition(LONG_TRAVEL);
+    interval = (int64_t)(1000000 / (MAX_SPEED * STEPS_PER_HALF_STEP));
+    for (int pass = 0; pass < 400; pass++) {
+      hostAdvance(MOTION_TASK_INTERVAL * 1000);
+      motor.update();
+    }
+  }
+};
+
+// Each step's coils through the axis's set and clear masks
+BENCH(driveSetClear) {
+  SelectedDrive drive;
+  drive.begin(axisPins[0], 0);
+  hostPinLogging(false);
+  return hostNoAllocations(hostMeasure(COIL_WRITES, [&](int i) { drive.drive(i & (SelectedDrive::PHASES - 1)); }));
+}
+
+// The read-modify-write of GPIO_OUT the set and clear masks replaced,
+// for comparison
+BENCH(driveReadModifyWrite) {
+  uint32_t mask = coilMask(axisPins[0]);
+  uint32_t patterns[8];
+  for (int i = 0; i < 8; i++) patterns[i] = coilPattern(axisPins[0], stepSequence[i]);
+  hostPinLogging(false);
+  return hostMeasure(COIL_WRITES, [&](int i) {
+    uint32_t out = REG_READ(GPIO_OUT_REG);
+    REG_WRITE(GPIO_OUT_REG, (out & ~mask) | patterns[i & 7]);
+  });
+}
+
+BENCH(release) {
+  SelectedDrive drive;
+  drive.begin(axisPins[0], 0);
+  hostPinLogging(false);
+  return hostNoAllocations(hostMeasure(COIL_WRITES, [&](int i) { drive.release(); }));
+}
+
+BENCH(stepMotor) {
+  StepScheduler scheduler;
+  StepperMotor motor;
+  motor.begin(hostMotorConfig(LONG_TRAVEL, MAX_SPEED), axisPins[0], 0, scheduler);
+  hostPinLogging(false);
+  return hostNoAllocations(hostMeasure(COIL_WRITES, [&](int i) { motor.stepMotor(1); }));
+}
+
+// A whole step at cruise: the timer interrupt, the scheduler and the
+// axis's onStep(). Includes the simulated timer's dispatch.
+BENCH(stepInterrupt) {
+  Cruise cruise;
+  return hostNoAllocations(hostMeasure(MOTOR_CALLS, [&](int i) {
+    hostAdvance(cruise.interval);
+    if ((i & 127) == 0) cruise.motor.update();
+  }));
+}
+
+// The motion task's pass over a moving axis
+BENCH(motorUpdate) {
+  Cruise cruise;
+  return hostNoAllocations(hostMeasure(MOTOR_CALLS, [&](int i) { cruise.motor.update(); }));
+}
+
+// A new target mid-move: the motion task replans the ramp
+BENCH(motorRetarget) {
+  Cruise cruise;
+  int base = LONG_TRAVEL / 2;
+  return hostNoAllocations(hostMeasure(MOTOR_CALLS, [&](int i) { cruise.motor.setTargetPosition(base + (i & 1023)); }));
+}
+
+int main(int argc, char** argv) {
+  return hostRunBenches(argc, argv);
+}
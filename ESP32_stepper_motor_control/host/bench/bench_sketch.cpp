@@ -0,0 +1,30 @@
+/*
+ * Request benches - REST requests through the whole sketch on the host:
+ * body parsing, the handler, the queued command and the response.
+ * Built only with ArduinoJson; the times depend on its version.
+ */
+
+#include "HostBench.h"
+#include "HostSketch.h"
+
+static const int REQUESTS = 20000;
+
+static HostBenchResult request(const char* method, const char* uri, const char* body) {
+  return hostMeasure(REQUESTS, [&](int i) { hostKeep(hostHttp(method, uri, body).code); });
+}
+
+BENCH(requestStatus) { return request("GET", "/api/status", ""); }
+BENCH(requestPosition) { return request("POST", "/api/position", "{\"position\":0}"); }
+BENCH(requestSpeed) { return request("POST", "/api/speed", "{\"speed\":250}"); }
+BENCH(requestBacklash) {
+  return request("POST", "/api/settings/backlash", "{\"mode\":\"off\",\"steps\":40,\"direction\":1}");
+}
+BENCH(requestSequence) {
+  return request("POST", "/api/sequence",
+                 "{\"tag\":7,\"legs\":[{\"position\":0,\"dwell\":500},{\"steps\":0,\"speed\":300},{\"position\":0}]}");
+}
+
+int main(int argc, char** argv) {
+  hostSketchBegin();
+  return hostRunBenches(argc, argv, false);
+}
@@ -0,0 +1,85 @@
+/*
+ * Network task benches - /api/status JSON and WebSocket status frames
+ * for a moving axis, and the logger, none of which may allocate
+ */
+
+#include "HostBench.h"
+#include "StatusEncoder.h"
+#include "Logger.h"
+
+static const int ENCODES = 200000;
+
+// A status mid-move, stepped on by i so no two encodes are the same
+static MotorStatus movingStatus(int i) {
+  MotorStatus status = {};
+  status.axis = 0;
+  status.position = -12000 + i % 24000;
+  status.target = 12000;
+  status.speed = 400;
+  status.state = STATE_RUNNING;
+  status.running = true;
+  status.maxSteps = 20000;
+  status.stepsPerRotation = 4096;
+  status.nearLimit = false;
+  return status;
+}
+
+BENCH(statusJson) {
+  StatusEncoder encoder;
+  return hostNoAllocations(hostMeasure(ENCODES, [&](int i) { hostKeep(encoder.encode(movingStatus(i))); }));
+}
+
+// Repeated requests while nothing changed
+BENCH(statusJsonUnchanged) {
+  StatusEncoder encoder;
+  MotorStatus status = movingStatus(0);
+  return hostNoAllocations(hostMeasure(ENCODES, [&](int i) { hostKeep(encoder.encode(status)); }));
+}
+
+BENCH(statusFrameFull) {
+  StatusFrameEncoder encoder;
+  return hostNoAllocations(hostMeasure(ENCODES, [&](int i) { hostKeep(encoder.encode(movingStatus(i), nullptr)); }));
+}
+
+BENCH(statusFrameDelta) {
+  StatusFrameEncoder encoder;
+  return hostNoAllocations(hostMeasure(ENCODES, [&](int i) {
+    MotorStatus base = movingStatus(i);
+    hostKeep(encoder.encode(movingStatus(i + 3), &base));
+  }));
+}
+
+// The same JSON built with String concatenation, as the handler did
+// before StatusEncoder, for comparison
+BENCH(statusJsonString) {
+  return hostMeasure(ENCODES, [&](int i) {
+    MotorStatus s = movingStatus(i);
+    String json = String("{\"axis\":") + s.axis + ",\"position\":" + s.position + ",\"target\":" + s.target +
+                  ",\"speed\":" + s.speed + ",\"state\":" + (int)s.state + ",\"running\":" +
+                  (s.running ? "true" : "false") + ",\"maxSteps\":" + s.maxSteps + ",\"stepsPerRot\":" +
+                  s.stepsPerRotation + ",\"nearLimit\":" + (s.nearLimit ? "true" : "false") + "}";
+    hostKeep(json);
+  });
+}
+
+static Logger benchLog;
+
+BENCH(loggerLog) {
+  return hostNoAllocations(hostMeasure(ENCODES, [&](int i) {
+    benchLog.log(i, i + 100, 250, STATE_RUNNING, ERROR_NONE);
+  }));
+}
+
+// A /api/logs line
+BENCH(loggerFormatEntry) {
+  for (int i = 0; i < LOG_BUFFER_SIZE; i++) benchLog.log(i * 1000, i * 1000 + 500, 250, STATE_RUNNING, ERROR_NONE);
+  char line[RESPONSE_LINE_SIZE];
+  return hostNoAllocations(hostMeasure(ENCODES, [&](int i) {
+    const LogEntry* entry = benchLog.getEntry(benchLog.getNextSequence() - 1 - (i % LOG_BUFFER_SIZE));
+    hostKeep(Logger::formatEntry(*entry, line, sizeof(line)));
+  }));
+}
+
+int main(int argc, char** argv) {
+  return hostRunBenches(argc, argv);
+}
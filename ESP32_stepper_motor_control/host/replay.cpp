@@ -0,0 +1,230 @@
+/*
+ * Host replay - a command recording from GET /api/record played into
+ * the sketch on the simulator
+ *
+ *   build/replay commands.ndjson [--trace steptrace.bin] > run.json
+ *
+ * Each record goes to the handler it reached on the device, REST bodies
+ * through the web server and WebSocket messages from the same client
+ * number, once the virtual clock has advanced to its recorded offset.
+ * Recorder and trace controls are skipped, as on a live replay. A step
+ * trace of axis 0 runs throughout; --trace saves it in the GET
+ * /api/trace format. Once every axis settles the driver prints the
+ * commands sent and rejected and the final status as JSON.
+ * tools/replay_commands.py --sim runs this and adds the step statistics.
+ *
+ * Exits 2 on an unreadable recording and 1 if the motors do not settle.
+ */
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <ArduinoJson.h>
+#include "HostSketch.h"
+
+struct ReplayCommand {
+  int64_t offset;                  // us from the first replayed command
+  bool webSocket;
+  uint8_t client;
+  std::string route;               // REST route, or the WebSocket cmd
+  std::string body;
+};
+
+struct ReplayRejection {
+  std::string route;
+  int code;
+  std::string reply;
+};
+
+static bool skippedRoute(const std::string& route) {
+  return route == "/api/record" || route == "/api/trace" || route == "/api/reboot";
+}
+
+static bool skippedCommand(const std::string& cmd) {
+  return cmd.empty() || cmd == "record" || cmd == "trace";
+}
+
+// The recording in arrival order; false if it is not a version 1 one
+static bool loadRecording(const char* path, std::vector<ReplayCommand>& commands) {
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) return false;
+  
+  DynamicJsonDocument doc(4 * RECORDER_MAX_BODY + 512);
+  std::string line;
+  bool header = true;
+  bool started = false;
+  int64_t elapsed = 0;
+  int64_t start = 0;
+  bool haveLast = false;
+  uint32_t last = 0;
+  int c;
+  do {
+    c = fgetc(file);
+    if (c != '\n' && c != EOF) {
+      line += (char)c;
+      continue;
+    }
+    if (line.empty()) continue;
+    if (deserializeJson(doc, line.c_str(), line.size())) {
+      fclose(file);
+      return false;
+    }
+    line.clear();
+    JsonVariantConst record = doc.as<JsonVariantConst>();
+    
+    if (header) {
+      header = false;
+      if ((record["version"] | 0) != 1) {
+        fclose(file);
+        return false;
+      }
+      if ((record["dropped"] | 0) > 0) {
+        fprintf(stderr, "warning: %d oldest commands were dropped\n", record["dropped"].as<int>());
+      }
+      continue;
+    }
+    
+    // micros() wraps every ~71 minutes
+    uint32_t time = record["t"];
+    if (haveLast) elapsed += (uint32_t)(time - last);
+    last = time;
+    haveLast = true;
+    if (record["truncated"] | false) {
+      fprintf(stderr, "warning: command %u was truncated, skipped\n", record["seq"].as<unsigned>());
+      continue;
+    }
+    
+    ReplayCommand command;
+    command.webSocket = strcmp(record["src"] | "", "ws") == 0;
+    command.client = record["client"] | 0;
+    command.body = record["body"] | "";
+    if (command.webSocket) {
+      StaticJsonDocument<RECORDER_MAX_BODY> message;
+      if (!deserializeJson(message, command.body.c_str(), command.body.size())) command.route = message.as<JsonVariantConst>()["cmd"] | "";
+      if (skippedCommand(command.route)) continue;
+    } else {
+      command.route = record["uri"] | "";
+      if (skippedRoute(command.route)) continue;
+    }
+    if (!started) {
+      start = elapsed;
+      started = true;
+    }
+    command.offset = elapsed - start;
+    commands.push_back(command);
+  } while (c != EOF);
+  
+  fclose(file);
+  return !header;
+}
+
+static void printJsonString(const std::string& text) {
+  putchar('"');
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      printf("\\%c", c);
+    } else if ((unsigned char)c < 0x20) {
+      printf("\\u%04x", c);
+    } else {
+      putchar(c);
+    }
+  }
+  putchar('"');
+}
+
+// The code of the last ack among the replies; 200 when there was none
+static int ackCode(const std::vector<HostWsMessage>& replies, std::string& reply) {
+  for (auto message = replies.rbegin(); message != replies.rend(); ++message) {
+    if (message->data.find("\"type\":\"ack\"") == std::string::npos) continue;
+    StaticJsonDocument<256> ack;
+    if (deserializeJson(ack, message->data.c_str(), message->data.size())) return 200;
+    reply = message->data;
+    return ack.as<JsonVariantConst>()["code"] | 200;
+  }
+  return 200;
+}
+
+int main(int argc, char** argv) {
+  const char* recording = nullptr;
+  const char* tracePath = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      tracePath = argv[++i];
+    } else {
+      recording = argv[i];
+    }
+  }
+  if (recording == nullptr) {
+    fprintf(stderr, "usage: %s commands.ndjson [--trace steptrace.bin]\n", argv[0]);
+    return 2;
+  }
+  
+  std::vector<ReplayCommand> commands;
+  if (!loadRecording(recording, commands)) {
+    fprintf(stderr, "%s: not a version 1 command recording\n", recording);
+    return 2;
+  }
+  
+  hostPinLogging(false);
+  hostSketchBegin();
+  if (hostHttp("POST", "/api/trace", "{\"enabled\":true}").code != 200) {
+    fprintf(stderr, "Could not start a step trace\n");
+    return 2;
+  }
+  hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+  
+  bool connected[256] = {};
+  std::vector<ReplayRejection> rejections;
+  int64_t start = hostMicros();
+  for (const ReplayCommand& command : commands) {
+    if (start + command.offset > hostMicros()) hostSketchRun(start + command.offset - hostMicros());
+    
+    int code;
+    std::string reply;
+    if (command.webSocket) {
+      if (!connected[command.client]) {
+        hostWsConnect(command.client);
+        connected[command.client] = true;
+      }
+      hostWsTake(command.client);
+      hostWsSend(command.client, command.body.c_str());
+      code = ackCode(hostWsTake(command.client), reply);
+    } else {
+      HostResponse response = hostHttp("POST", command.route.c_str(), command.body.c_str());
+      code = response.code;
+      reply = response.body;
+    }
+    if (code != 200) rejections.push_back({ command.route, code, reply });
+  }
+  
+  bool settled = hostSketchSettle();
+  hostHttp("POST", "/api/trace", "{\"enabled\":false}");
+  hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+  HostResponse trace = hostHttp("GET", "/api/trace");
+  if (tracePath != nullptr) {
+    FILE* file = fopen(tracePath, "wb");
+    if (file == nullptr || fwrite(trace.body.data(), 1, trace.body.size(), file) != trace.body.size()) {
+      fprintf(stderr, "Cannot write %s\n", tracePath);
+      return 2;
+    }
+    fclose(file);
+  }
+  
+  printf("{\n  \"commands\": {\"sent\": %zu, \"rejected\": %zu, \"rejections\": [", commands.size(), rejections.size());
+  for (size_t i = 0; i < rejections.size(); i++) {
+    printf("%s\n    {\"route\": ", i > 0 ? "," : "");
+    printJsonString(rejections[i].route);
+    printf(", \"code\": %d, \"reply\": ", rejections[i].code);
+    printJsonString(rejections[i].reply);
+    printf("}");
+  }
+  printf("%s]},\n", rejections.empty() ? "" : "\n  ");
+  printf("  \"virtualUs\": %lld,\n", (long long)(hostMicros() - start));
+  printf("  \"final\": %s\n}\n", hostHttp("GET", "/api/status").body.c_str());
+  
+  if (!settled) {
+    fprintf(stderr, "Motors still running after the replay\n");
+    return 1;
+  }
+  return 0;
+}
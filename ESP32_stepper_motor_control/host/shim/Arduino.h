@@ -0,0 +1,233 @@
+/*
+ * Arduino core shim for host builds
+ *
+ * Just enough of the arduino-esp32 3.x core for the firmware headers and
+ * stepper_motor.ino to build on Linux: timing, GPIO, hardware timers,
+ * LEDC, String, Serial, ESP and the FreeRTOS calls they make. Time is
+ * the simulator's virtual clock (HostSim.h); nothing here blocks except
+ * delay(), which advances it.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include "HostSim.h"
+#include "esp_err.h"
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define PROGMEM
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+typedef int gpio_num_t;
+#define GPIO_NUM_0 0
+#define GPIO_NUM_1 1
+#define GPIO_NUM_2 2
+#define GPIO_NUM_3 3
+#define GPIO_NUM_4 4
+#define GPIO_NUM_5 5
+#define GPIO_NUM_6 6
+#define GPIO_NUM_7 7
+#define GPIO_NUM_8 8
+#define GPIO_NUM_9 9
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ----------------------------------------------------------------
+// Time
+// ----------------------------------------------------------------
+static inline unsigned long millis() { return (unsigned long)(hostMicros() / 1000); }
+static inline unsigned long micros() { return (unsigned long)hostMicros(); }
+static inline int64_t esp_timer_get_time() { return hostMicros(); }
+static inline void delay(uint32_t ms) { hostAdvance((int64_t)ms * 1000); }
+static inline void delayMicroseconds(uint32_t us) { hostAdvance(us); }
+
+// ----------------------------------------------------------------
+// GPIO
+// ----------------------------------------------------------------
+#define REG_READ(reg) hostRegRead(reg)
+#define REG_WRITE(reg, value) hostRegWrite((reg), (value))
+
+static inline void pinMode(uint8_t pin, uint8_t mode) {}
+static inline void digitalWrite(uint8_t pin, uint8_t level) { hostDigitalWrite(pin, level); }
+
+// LEDC through the Arduino driver (attach once, then the LL registers)
+static inline bool ledcAttachChannel(uint8_t pin, uint32_t freq, uint8_t resolution, int8_t channel) {
+  return true;
+}
+static inline bool ledcWrite(uint8_t pin, uint32_t duty) { return true; }
+
+// ----------------------------------------------------------------
+// Hardware timers (arduino-esp32 3.x API)
+// ----------------------------------------------------------------
+typedef HostTimer hw_timer_t;
+
+static inline hw_timer_t* timerBegin(uint32_t frequency) { return hostTimerBegin(frequency); }
+static inline void timerAttachInterruptArg(hw_timer_t* timer, void (*isr)(void*), void* arg) {
+  hostTimerAttach(timer, isr, arg);
+}
+static inline uint64_t timerRead(hw_timer_t* timer) { return hostTimerRead(timer); }
+static inline void timerAlarm(hw_timer_t* timer, uint64_t value, bool autoreload, uint64_t reloadCount) {
+  hostTimerAlarm(timer, value);
+}
+
+// ----------------------------------------------------------------
+// FreeRTOS - one thread, so locks are no-ops and tasks never run
+// ----------------------------------------------------------------
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux) ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux) ((void)(mux))
+#define portENTER_CRITICAL_SAFE(mux) ((void)(mux))
+#define portEXIT_CRITICAL_SAFE(mux) ((void)(mux))
+#define portNUM_PROCESSORS 2
+#define portMAX_DELAY 0xffffffffUL
+#define portTICK_PERIOD_MS 1
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define configMAX_PRIORITIES 25
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+static inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack,
+                                                 void* param, unsigned priority, TaskHandle_t* handle,
+                                                 BaseType_t core) {
+  HostTask* task = new HostTask{ function, param, 0 };
+  if (handle != nullptr) *handle = task;
+  return pdPASS;
+}
+static inline void xTaskNotifyGive(TaskHandle_t task) { static_cast<HostTask*>(task)->notifications++; }
+static inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) { return 0; }
+static inline TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+static inline void vTaskDelay(TickType_t ticks) { hostAdvance((int64_t)ticks * 1000); }
+static inline void vTaskDelete(TaskHandle_t task) {}
+
+// ----------------------------------------------------------------
+// String (the parts of WString the firmware and ArduinoJson use)
+// ----------------------------------------------------------------
+class String {
+public:
+  String() {}
+  String(const char* text) { if (text != nullptr) value = text; }
+  String(const std::string& text) : value(text) {}
+  String(char c) : value(1, c) {}
+  String(int n) : value(std::to_string(n)) {}
+  String(unsigned int n) : value(std::to_string(n)) {}
+  String(long n) : value(std::to_string(n)) {}
+  String(unsigned long n) : value(std::to_string(n)) {}
+  
+  String& operator=(const char* text) {
+    value = text != nullptr ? text : "";
+    return *this;
+  }
+  
+  const char* c_str() const { return value.c_str(); }
+  unsigned int length() const { return (unsigned int)value.size(); }
+  bool reserve(unsigned int size) { value.reserve(size); return true; }
+  char operator[](unsigned int index) const { return index < value.size() ? value[index] : 0; }
+  char charAt(unsigned int index) const { return (*this)[index]; }
+  
+  bool concat(const char* text) { if (text != nullptr) value += text; return true; }
+  bool concat(const char* text, unsigned int length) { value.append(text, length); return true; }
+  bool concat(const String& text) { value += text.value; return true; }
+  bool concat(char c) { value += c; return true; }
+  String& operator+=(const char* text) { concat(text); return *this; }
+  String& operator+=(const String& text) { concat(text); return *this; }
+  String& operator+=(char c) { concat(c); return *this; }
+  
+  int indexOf(const char* text) const {
+    size_t at = value.find(text);
+    return at == std::string::npos ? -1 : (int)at;
+  }
+  long toInt() const { return strtol(value.c_str(), nullptr, 10); }
+  bool equals(const char* text) const { return value == (text != nullptr ? text : ""); }
+  bool operator==(const char* text) const { return equals(text); }
+  bool operator!=(const char* text) const { return !equals(text); }
+  bool operator==(const String& other) const { return value == other.value; }
+  bool operator!=(const String& other) const { return value != other.value; }
+  
+private:
+  std::string value;
+};
+
+class StringSumHelper : public String {
+public:
+  StringSumHelper(const String& text) : String(text) {}
+  StringSumHelper(const char* text) : String(text) {}
+};
+
+static inline StringSumHelper operator+(const StringSumHelper& left, const String& right) {
+  StringSumHelper sum(left);
+  sum.concat(right);
+  return sum;
+}
+static inline StringSumHelper operator+(const StringSumHelper& left, const char* right) {
+  StringSumHelper sum(left);
+  sum.concat(right);
+  return sum;
+}
+static inline StringSumHelper operator+(const char* left, const String& right) {
+  return StringSumHelper(left) + right;
+}
+
+// ----------------------------------------------------------------
+// Serial - stderr, or nothing when HOST_QUIET is set in the environment
+// ----------------------------------------------------------------
+class HostSerial {
+public:
+  void begin(unsigned long baud) { quiet = getenv("HOST_QUIET") != nullptr; }
+  void print(const char* text) { if (!quiet) fputs(text, stderr); }
+  void print(const String& text) { print(text.c_str()); }
+  void println(const char* text = "") { print(text); print("\n"); }
+  void println(const String& text) { println(text.c_str()); }
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    if (quiet) return 0;
+    va_list args;
+    va_start(args, format);
+    int n = vfprintf(stderr, format, args);
+    va_end(args);
+    return n;
+  }
+  
+private:
+  bool quiet = getenv("HOST_QUIET") != nullptr;
+};
+
+extern HostSerial Serial;
+
+// ----------------------------------------------------------------
+// ESP
+// ----------------------------------------------------------------
+class HostEsp {
+public:
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getFreeHeap() { return 200000; }
+  void restart();
+};
+
+extern HostEsp ESP;
+
+static inline bool psramFound() { return false; }
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,20 @@
+/*
+ * ElegantOTA shim for host builds - no updates ever arrive
+ */
+
+#ifndef HOST_ELEGANT_OTA_H
+#define HOST_ELEGANT_OTA_H
+
+#include <functional>
+#include "WebServer.h"
+
+class HostElegantOTA {
+public:
+  void begin(WebServer* server) {}
+  void loop() {}
+  void onEnd(std::function<void(bool)> callback) {}
+};
+
+inline HostElegantOTA ElegantOTA;
+
+#endif // HOST_ELEGANT_OTA_H
@@ -0,0 +1,528 @@
+/*
+ * Host Simulator - see HostSim.h
+ */
+
+#include <Arduino.h>
+#include <esp_partition.h>
+#include <driver/rmt_tx.h>
+#include <driver/rmt_encoder.h>
+#include <soc/gpio_reg.h>
+#include <deque>
+#include <map>
+
+HostSerial Serial;
+HostEsp ESP;
+
+// ----------------------------------------------------------------
+// State
+// ----------------------------------------------------------------
+struct HostTimer {
+  uint32_t frequency;
+  void (*isr)(void*);
+  void* arg;
+  bool armed;
+  int64_t alarmTime;               // us
+};
+
+struct rmt_channel_t {
+  int gpio;
+  bool enabled;
+  bool busy;                       // Transmission queued or playing
+  bool started;                    // Playing (a synced one waits for its group)
+  int eotLevel;
+  rmt_encoder_t* encoder;
+  const void* payload;
+  size_t payloadSize;
+  bool encoded;                    // The encoder reported the payload complete
+  std::deque<uint32_t> memory;     // Symbols written but not yet played
+  int playedSinceRefill;
+  int64_t halfStart;               // When the half at the front of memory starts
+  int half;                        // 0: low 16 bits of the front symbol, 1: high
+  rmt_sync_manager_t* sync;
+};
+
+struct rmt_sync_manager_t {
+  std::vector<rmt_channel_t*> channels;
+};
+
+struct HostCopyEncoder {
+  rmt_encoder_t base;
+  size_t offset;
+};
+
+static const size_t RMT_MEM_SYMBOLS = SOC_RMT_MEM_WORDS_PER_CHANNEL;
+
+static int64_t now;
+static int advancing;              // hostAdvanceTo() depth; ISRs may call back in
+static std::vector<HostTimer*> timers;
+
+static uint32_t gpioOut;
+static uint32_t rmtRouted;         // Pins driven by an RMT channel
+static uint32_t rmtLevels;
+static std::vector<HostPinEvent> pinLog;
+static bool pinLogging = true;
+static HostRegStats regStats;
+
+static uint32_t ledcPending[HOST_LEDC_CHANNELS];
+static uint32_t ledcDuty[HOST_LEDC_CHANNELS];
+static std::vector<HostLedcEvent> ledcLog;
+
+static std::vector<rmt_channel_t*> channels;
+static HostRmtStats rmtStats;
+static std::map<int, std::vector<uint32_t>> rmtSymbols;
+static int rmtFailAfter = -1;
+
+static int restarts;
+
+// ----------------------------------------------------------------
+// Pins
+// ----------------------------------------------------------------
+uint32_t hostPins() {
+  return (gpioOut & ~rmtRouted) | (rmtLevels & rmtRouted);
+}
+
+// Log the pins if they changed; changes at one instant collapse into one
+static void logPins() {
+  if (!pinLogging) return;
+  uint32_t pins = hostPins();
+  uint32_t previous = pinLog.empty() ? 0 : pinLog.back().pins;
+  if (!pinLog.empty() && pinLog.back().time == now) {
+    pinLog.back().pins = pins;
+    uint32_t before = pinLog.size() >= 2 ? pinLog[pinLog.size() - 2].pins : 0;
+    if (before == pins) pinLog.pop_back();
+    return;
+  }
+  if (pins != previous) pinLog.push_back({ now, pins });
+}
+
+const std::vector<HostPinEvent>& hostPinLog() { return pinLog; }
+void hostClearPinLog() { pinLog.clear(); }
+
+void hostPinLogging(bool enabled) { pinLogging = enabled; }
+HostRegStats hostRegStats() { return regStats; }
+
+uint32_t hostRegRead(uint32_t reg) {
+  regStats.reads++;
+  return reg == GPIO_OUT_REG ? gpioOut : 0;
+}
+
+void hostRegWrite(uint32_t reg, uint32_t value) {
+  regStats.writes++;
+  if (reg == GPIO_OUT_REG) gpioOut = value;
+  else if (reg == GPIO_OUT_W1TS_REG) gpioOut |= value;
+  else if (reg == GPIO_OUT_W1TC_REG) gpioOut &= ~value;
+  else return;
+  logPins();
+}
+
+void hostDigitalWrite(int pin, int level) {
+  if (pin < 0 || pin >= 32) return;
+  if (level) gpioOut |= 1UL << pin;
+  else gpioOut &= ~(1UL << pin);
+  logPins();
+}
+
+void hostRouteToGpioOut(int pin) {
+  if (pin < 0 || pin >= 32) return;
+  rmtRouted &= ~(1UL << pin);
+  logPins();
+}
+
+// ----------------------------------------------------------------
+// LEDC
+// ----------------------------------------------------------------
+uint32_t hostLedcDuty(int channel) { return channel >= 0 && channel < HOST_LEDC_CHANNELS ? ledcDuty[channel] : 0; }
+
+void hostLedcSetDuty(int channel, uint32_t duty) {
+  if (channel >= 0 && channel < HOST_LEDC_CHANNELS) ledcPending[channel] = duty;
+}
+
+// Log the duties if they changed; as with the pins, updates at one
+// instant collapse into one event
+static void logLedc() {
+  if (!pinLogging) return;
+  static const HostLedcEvent off = {};
+  const uint32_t* previous = ledcLog.empty() ? off.duty : ledcLog.back().duty;
+  if (!ledcLog.empty() && ledcLog.back().time == now) {
+    memcpy(ledcLog.back().duty, ledcDuty, sizeof(ledcDuty));
+    const uint32_t* before = ledcLog.size() >= 2 ? ledcLog[ledcLog.size() - 2].duty : off.duty;
+    if (memcmp(before, ledcDuty, sizeof(ledcDuty)) == 0) ledcLog.pop_back();
+    return;
+  }
+  if (memcmp(previous, ledcDuty, sizeof(ledcDuty)) != 0) {
+    ledcLog.push_back({ now, {} });
+    memcpy(ledcLog.back().duty, ledcDuty, sizeof(ledcDuty));
+  }
+}
+
+void hostLedcUpdate(int channel) {
+  if (channel < 0 || channel >= HOST_LEDC_CHANNELS) return;
+  ledcDuty[channel] = ledcPending[channel];
+  logLedc();
+}
+
+const std::vector<HostLedcEvent>& hostLedcLog() { return ledcLog; }
+
+// ----------------------------------------------------------------
+// RMT
+// ----------------------------------------------------------------
+static void setChannelLevel(rmt_channel_t* channel, int level) {
+  if (channel->gpio < 0 || channel->gpio >= 32) return;
+  if (level) rmtLevels |= 1UL << channel->gpio;
+  else rmtLevels &= ~(1UL << channel->gpio);
+  logPins();
+}
+
+static void writeSymbol(rmt_channel_t* channel, uint32_t symbol) {
+  channel->memory.push_back(symbol);
+  rmtSymbols[channel->gpio].push_back(symbol);
+}
+
+// Let the encoder fill whatever memory is free
+static void refill(rmt_channel_t* channel) {
+  if (channel->encoded || channel->memory.size() >= RMT_MEM_SYMBOLS) return;
+  rmt_encode_state_t state = RMT_ENCODING_RESET;
+  channel->encoder->encode(channel->encoder, channel, channel->payload, channel->payloadSize, &state);
+  if (state & RMT_ENCODING_COMPLETE) channel->encoded = true;
+}
+
+static void endTransmission(rmt_channel_t* channel) {
+  channel->busy = false;
+  channel->started = false;
+  channel->memory.clear();
+  setChannelLevel(channel, channel->eotLevel);
+}
+
+static void startTransmission(rmt_channel_t* channel) {
+  channel->started = true;
+  channel->halfStart = now;
+  channel->half = 0;
+  channel->playedSinceRefill = 0;
+  rmtStats.transmissions++;
+}
+
+// Play the half at the front of the channel's memory
+static void playHalf(rmt_channel_t* channel) {
+  if (channel->memory.empty()) {
+    if (!channel->encoded) rmtStats.underflows++;
+    endTransmission(channel);
+    return;
+  }
+  uint32_t symbol = channel->memory.front();
+  uint32_t half = channel->half ? symbol >> 16 : symbol & 0xffff;
+  uint32_t duration = half & 0x7fff;
+  if (duration == 0) {
+    rmtStats.zeroHalves++;
+    endTransmission(channel);
+    return;
+  }
+  setChannelLevel(channel, half >> 15);
+  channel->halfStart += duration;
+  channel->half ^= 1;
+  if (channel->half == 0) {
+    channel->memory.pop_front();
+    if (++channel->playedSinceRefill == (int)RMT_MEM_SYMBOLS / 2) {
+      channel->playedSinceRefill = 0;
+      if (!channel->encoded) {
+        rmtStats.refills++;
+        refill(channel);
+      }
+    }
+  }
+}
+
+// Play every channel up to time, halves in time order across channels
+static void playRmt(int64_t time) {
+  for (;;) {
+    rmt_channel_t* next = nullptr;
+    for (rmt_channel_t* channel : channels) {
+      if (channel->busy && channel->started && channel->halfStart <= time &&
+          (next == nullptr || channel->halfStart < next->halfStart)) {
+        next = channel;
+      }
+    }
+    if (next == nullptr) return;
+    int64_t at = now;
+    now = next->halfStart;         // Pin changes are logged when they happen
+    playHalf(next);
+    now = max(now, at);
+  }
+}
+
+static size_t copyEncode(rmt_encoder_t* encoder, rmt_channel_handle_t channel, const void* data, size_t size,
+                         rmt_encode_state_t* state) {
+  HostCopyEncoder* copy = __containerof(encoder, HostCopyEncoder, base);
+  const uint8_t* bytes = (const uint8_t*)data;
+  size_t encoded = 0;
+  int result = RMT_ENCODING_RESET;
+  while (copy->offset + sizeof(uint32_t) <= size && channel->memory.size() < RMT_MEM_SYMBOLS) {
+    uint32_t symbol;
+    memcpy(&symbol, bytes + copy->offset, sizeof(symbol));
+    writeSymbol(channel, symbol);
+    copy->offset += sizeof(symbol);
+    encoded++;
+  }
+  if (copy->offset + sizeof(uint32_t) > size) {
+    copy->offset = 0;
+    result |= RMT_ENCODING_COMPLETE;
+  }
+  if (channel->memory.size() >= RMT_MEM_SYMBOLS) result |= RMT_ENCODING_MEM_FULL;
+  *state = (rmt_encode_state_t)result;
+  return encoded;
+}
+
+static esp_err_t copyReset(rmt_encoder_t* encoder) {
+  __containerof(encoder, HostCopyEncoder, base)->offset = 0;
+  return ESP_OK;
+}
+
+static esp_err_t copyDelete(rmt_encoder_t* encoder) {
+  delete __containerof(encoder, HostCopyEncoder, base);
+  return ESP_OK;
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t* config, rmt_encoder_handle_t* ret_encoder) {
+  HostCopyEncoder* copy = new HostCopyEncoder{ { copyEncode, copyReset, copyDelete }, 0 };
+  *ret_encoder = &copy->base;
+  return ESP_OK;
+}
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder) { return encoder->del(encoder); }
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder) { return encoder->reset(encoder); }
+
+void hostRmtFailAfter(int count) { rmtFailAfter = count; }
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t* config, rmt_channel_handle_t* ret_chan) {
+  if (rmtFailAfter == 0 || channels.size() >= SOC_RMT_TX_CANDIDATES_PER_GROUP) return ESP_ERR_NOT_FOUND;
+  if (rmtFailAfter > 0) rmtFailAfter--;
+  rmt_channel_t* channel = new rmt_channel_t();
+  channel->gpio = config->gpio_num;
+  channels.push_back(channel);
+  if (channel->gpio >= 0 && channel->gpio < 32) {
+    rmtRouted |= 1UL << channel->gpio;
+    rmtLevels &= ~(1UL << channel->gpio);
+    logPins();
+  }
+  *ret_chan = channel;
+  return ESP_OK;
+}
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t channel) {
+  if (channel->enabled) return ESP_ERR_INVALID_STATE;
+  for (size_t i = 0; i < channels.size(); i++) {
+    if (channels[i] == channel) channels.erase(channels.begin() + i);
+  }
+  delete channel;
+  return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t channel) {
+  if (channel->enabled) return ESP_ERR_INVALID_STATE;
+  channel->enabled = true;
+  return ESP_OK;
+}
+
+// Disabling drops any transmission; the pin holds its level
+esp_err_t rmt_disable(rmt_channel_handle_t channel) {
+  if (!channel->enabled) return ESP_ERR_INVALID_STATE;
+  playRmt(now);
+  channel->enabled = false;
+  channel->busy = false;
+  channel->started = false;
+  channel->memory.clear();
+  return ESP_OK;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t channel, rmt_encoder_handle_t encoder, const void* payload,
+                       size_t payload_bytes, const rmt_transmit_config_t* config) {
+  if (!channel->enabled) return ESP_ERR_INVALID_STATE;
+  playRmt(now);
+  if (channel->busy) return ESP_ERR_INVALID_STATE;   // Queue depth 1
+  channel->busy = true;
+  channel->started = false;
+  channel->eotLevel = config->flags.eot_level;
+  channel->encoder = encoder;
+  channel->payload = payload;
+  channel->payloadSize = payload_bytes;
+  channel->encoded = false;
+  channel->memory.clear();
+  refill(channel);
+  
+  // A synced channel waits for the rest of its group
+  rmt_sync_manager_t* sync = channel->sync;
+  if (sync == nullptr) {
+    startTransmission(channel);
+    return ESP_OK;
+  }
+  for (rmt_channel_t* member : sync->channels) {
+    if (!member->busy || member->started) return ESP_OK;
+  }
+  for (rmt_channel_t* member : sync->channels) startTransmission(member);
+  return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t channel, int timeout_ms) {
+  playRmt(now);
+  int64_t deadline = now + (int64_t)timeout_ms * 1000;
+  while (channel->busy && channel->started && now < deadline && advancing == 0) {
+    hostAdvanceTo(min(deadline, max(channel->halfStart, now + 1)));
+  }
+  return channel->busy ? ESP_ERR_TIMEOUT : ESP_OK;
+}
+
+esp_err_t rmt_new_sync_manager(const rmt_sync_manager_config_t* config, rmt_sync_manager_handle_t* ret_synchro) {
+  rmt_sync_manager_t* sync = new rmt_sync_manager_t();
+  for (size_t i = 0; i < config->array_size; i++) {
+    sync->channels.push_back(config->tx_channel_array[i]);
+    config->tx_channel_array[i]->sync = sync;
+  }
+  *ret_synchro = sync;
+  return ESP_OK;
+}
+
+esp_err_t rmt_del_sync_manager(rmt_sync_manager_handle_t sync) {
+  for (rmt_channel_t* channel : sync->channels) channel->sync = nullptr;
+  delete sync;
+  return ESP_OK;
+}
+
+esp_err_t rmt_sync_reset(rmt_sync_manager_handle_t sync) { return ESP_OK; }
+
+HostRmtStats hostRmtStats() { return rmtStats; }
+
+const std::vector<uint32_t>& hostRmtSymbols(int gpio) { return rmtSymbols[gpio]; }
+void hostClearRmtSymbols() { rmtSymbols.clear(); }
+
+// ----------------------------------------------------------------
+// Hardware timers
+// ----------------------------------------------------------------
+HostTimer* hostTimerBegin(uint32_t frequency) {
+  HostTimer* timer = new HostTimer{ frequency, nullptr, nullptr, false, 0 };
+  timers.push_back(timer);
+  return timer;
+}
+
+void hostTimerAttach(HostTimer* timer, void (*isr)(void*), void* arg) {
+  timer->isr = isr;
+  timer->arg = arg;
+}
+
+uint64_t hostTimerRead(HostTimer* timer) {
+  return (uint64_t)now * timer->frequency / 1000000;
+}
+
+// An alarm already passed fires straight away, as on the chip
+void hostTimerAlarm(HostTimer* timer, uint64_t count) {
+  int64_t at = (int64_t)((count * 1000000 + timer->frequency - 1) / timer->frequency);
+  timer->alarmTime = max(at, now);
+  timer->armed = true;
+}
+
+// ----------------------------------------------------------------
+// Clock
+// ----------------------------------------------------------------
+int64_t hostMicros() { return now; }
+
+void hostAdvance(int64_t us) { hostAdvanceTo(now + us); }
+
+void hostAdvanceTo(int64_t time) {
+  advancing++;
+  for (;;) {
+    HostTimer* due = nullptr;
+    for (HostTimer* timer : timers) {
+      if (timer->armed && timer->isr != nullptr && timer->alarmTime <= time &&
+          (due == nullptr || timer->alarmTime < due->alarmTime)) {
+        due = timer;
+      }
+    }
+    int64_t until = due != nullptr ? due->alarmTime : time;
+    playRmt(until);
+    now = max(now, until);
+    if (due == nullptr) break;
+    due->armed = false;
+    due->isr(due->arg);
+  }
+  advancing--;
+}
+
+void hostReset() {
+  for (HostTimer* timer : timers) delete timer;
+  timers.clear();
+  for (rmt_channel_t* channel : channels) delete channel;
+  channels.clear();
+  now = 0;
+  gpioOut = 0;
+  rmtRouted = 0;
+  rmtLevels = 0;
+  pinLog.clear();
+  pinLogging = true;
+  regStats = HostRegStats();
+  memset(ledcPending, 0, sizeof(ledcPending));
+  memset(ledcDuty, 0, sizeof(ledcDuty));
+  ledcLog.clear();
+  rmtStats = HostRmtStats();
+  rmtSymbols.clear();
+  rmtFailAfter = -1;
+  restarts = 0;
+}
+
+// ----------------------------------------------------------------
+// Tasks and restarts
+// ----------------------------------------------------------------
+uint32_t hostTakeNotifications(void* task) {
+  if (task == nullptr) return 0;
+  HostTask* host = static_cast<HostTask*>(task);
+  uint32_t count = host->notifications;
+  host->notifications = 0;
+  return count;
+}
+
+void HostEsp::restart() { restarts++; }
+int hostRestarts() { return restarts; }
+
+// ----------------------------------------------------------------
+// Flash partition
+// ----------------------------------------------------------------
+static const esp_partition_t journalPartition = {
+  ESP_PARTITION_TYPE_DATA, 0x3E0000, 0x10000, 4096, "poslog"
+};
+
+static std::vector<uint8_t>& flash() {
+  static std::vector<uint8_t> bytes(journalPartition.size, 0xff);
+  return bytes;
+}
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label) {
+  if (type != ESP_PARTITION_TYPE_DATA || label == nullptr || strcmp(label, journalPartition.label) != 0) {
+    return nullptr;
+  }
+  return &journalPartition;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* dst, size_t size) {
+  if (offset + size > partition->size) return ESP_ERR_INVALID_ARG;
+  memcpy(dst, flash().data() + offset, size);
+  return ESP_OK;
+}
+
+// NOR flash: a write only clears bits
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* src, size_t size) {
+  if (offset + size > partition->size) return ESP_ERR_INVALID_ARG;
+  const uint8_t* bytes = (const uint8_t*)src;
+  for (size_t i = 0; i < size; i++) flash()[offset + i] &= bytes[i];
+  return ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size) {
+  if (offset % partition->erase_size != 0 || size % partition->erase_size != 0 ||
+      offset + size > partition->size) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  memset(flash().data() + offset, 0xff, size);
+  return ESP_OK;
+}
+
+void hostErasePartition() {
+  std::fill(flash().begin(), flash().end(), 0xff);
+}
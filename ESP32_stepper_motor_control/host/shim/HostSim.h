@@ -0,0 +1,119 @@
+/*
+ * Host Simulator - Virtual time and I/O behind the Arduino/ESP32 shim
+ *
+ * Nothing moves on its own: hostAdvance() runs the virtual microsecond
+ * clock forward and, on the way, fires hardware timer alarms at their
+ * exact counts and plays RMT transmissions symbol by symbol. Pin levels
+ * are logged whenever they change, whether GPIO_OUT or an RMT channel
+ * drives them, and LEDC duties likewise, so a test can read back when
+ * each coil pattern appeared.
+ * A 20000-step move costs a few milliseconds of real time.
+ *
+ * NVS contents and the flash partition survive hostReset(), as they
+ * would a reboot; the clock, timers, pins and RMT channels do not.
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Pin levels (GPIO 0..31, bit n = GPIO n) from time on
+struct HostPinEvent {
+  int64_t time;
+  uint32_t pins;
+};
+
+// ----------------------------------------------------------------
+// Clock
+// ----------------------------------------------------------------
+int64_t hostMicros();
+void hostAdvance(int64_t us);
+void hostAdvanceTo(int64_t time);
+
+// Back to power-on: clock at 0, pins low, timers and RMT channels freed
+void hostReset();
+
+// ----------------------------------------------------------------
+// GPIO
+// ----------------------------------------------------------------
+uint32_t hostPins();
+const std::vector<HostPinEvent>& hostPinLog();
+void hostClearPinLog();
+
+void hostPinLogging(bool enabled);   // Off for benches; on after hostReset()
+
+// GPIO register accesses since hostReset()
+struct HostRegStats {
+  uint32_t reads;
+  uint32_t writes;
+};
+HostRegStats hostRegStats();
+
+uint32_t hostRegRead(uint32_t reg);
+void hostRegWrite(uint32_t reg, uint32_t value);
+void hostDigitalWrite(int pin, int level);
+void hostRouteToGpioOut(int pin);     // Pin follows GPIO_OUT again
+
+// Coil bits (A = bit 0) of an axis's four pins at a pin state
+static inline int hostCoils(uint32_t pins, uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+  return ((pins >> a) & 1) | (((pins >> b) & 1) << 1) | (((pins >> c) & 1) << 2) | (((pins >> d) & 1) << 3);
+}
+
+// ----------------------------------------------------------------
+// LEDC
+// ----------------------------------------------------------------
+#define HOST_LEDC_CHANNELS 16
+
+// Channel duties (channel n at duty[n]) from time on, logged with the
+// pins while pin logging is on
+struct HostLedcEvent {
+  int64_t time;
+  uint32_t duty[HOST_LEDC_CHANNELS];
+};
+
+uint32_t hostLedcDuty(int channel);
+void hostLedcSetDuty(int channel, uint32_t duty);
+void hostLedcUpdate(int channel);
+const std::vector<HostLedcEvent>& hostLedcLog();
+
+// ----------------------------------------------------------------
+// Hardware timers (timerBegin() and friends)
+// ----------------------------------------------------------------
+struct HostTimer;
+HostTimer* hostTimerBegin(uint32_t frequency);
+void hostTimerAttach(HostTimer* timer, void (*isr)(void*), void* arg);
+uint64_t hostTimerRead(HostTimer* timer);
+void hostTimerAlarm(HostTimer* timer, uint64_t count);
+
+// ----------------------------------------------------------------
+// RMT statistics
+// ----------------------------------------------------------------
+struct HostRmtStats {
+  uint32_t transmissions;
+  uint32_t refills;                // Half-memory refill interrupts
+  uint32_t underflows;             // Memory ran dry mid-transmission
+  uint32_t zeroHalves;             // Zero-length halves (end markers) played
+};
+HostRmtStats hostRmtStats();
+
+// Every symbol the encoders wrote to the channel on pin gpio, in order
+const std::vector<uint32_t>& hostRmtSymbols(int gpio);
+void hostClearRmtSymbols();
+
+// ----------------------------------------------------------------
+// FreeRTOS tasks are never run; the host driver calls the work itself
+// ----------------------------------------------------------------
+struct HostTask {
+  void (*function)(void*);
+  void* param;
+  uint32_t notifications;
+};
+uint32_t hostTakeNotifications(void* task);
+
+// ESP.restart() calls made
+int hostRestarts();
+
+#endif // HOST_SIM_H
@@ -0,0 +1,86 @@
+/*
+ * Preferences shim for host builds
+ *
+ * NVS in memory: one store shared by every Preferences instance, keyed
+ * by namespace and key, that outlives them (and hostReset()), as flash
+ * outlives a reboot. Writes are counted so tests can see when the
+ * firmware touches flash.
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class Preferences {
+private:
+  std::string space;
+  bool readOnly = true;
+  
+  static std::map<std::string, std::vector<uint8_t>>& store() {
+    static std::map<std::string, std::vector<uint8_t>> values;
+    return values;
+  }
+  
+  std::string path(const char* key) const { return space + "/" + key; }
+  
+  size_t put(const char* key, const void* value, size_t length) {
+    if (space.empty() || readOnly || key == nullptr) return 0;
+    const uint8_t* bytes = (const uint8_t*)value;
+    store()[path(key)].assign(bytes, bytes + length);
+    writes()++;
+    return length;
+  }
+  
+  const std::vector<uint8_t>* find(const char* key) const {
+    auto it = store().find(path(key));
+    return it == store().end() ? nullptr : &it->second;
+  }
+  
+public:
+  // Writes made through any instance
+  static uint32_t& writes() {
+    static uint32_t count = 0;
+    return count;
+  }
+  
+  // Erase everything, as a fresh chip
+  static void eraseAll() { store().clear(); }
+  
+  bool begin(const char* name, bool readOnlyMode = false) {
+    space = name;
+    readOnly = readOnlyMode;
+    return true;
+  }
+  void end() { space.clear(); }
+  
+  bool isKey(const char* key) const { return find(key) != nullptr; }
+  
+  size_t putInt(const char* key, int32_t value) { return put(key, &value, sizeof(value)); }
+  int32_t getInt(const char* key, int32_t fallback = 0) const {
+    const std::vector<uint8_t>* stored = find(key);
+    int32_t value;
+    if (stored == nullptr || stored->size() != sizeof(value)) return fallback;
+    memcpy(&value, stored->data(), sizeof(value));
+    return value;
+  }
+  
+  size_t putBytes(const char* key, const void* value, size_t length) { return put(key, value, length); }
+  size_t getBytesLength(const char* key) const {
+    const std::vector<uint8_t>* stored = find(key);
+    return stored == nullptr ? 0 : stored->size();
+  }
+  size_t getBytes(const char* key, void* buffer, size_t length) const {
+    const std::vector<uint8_t>* stored = find(key);
+    if (stored == nullptr || stored->size() > length) return 0;
+    memcpy(buffer, stored->data(), stored->size());
+    return stored->size();
+  }
+};
+
+#endif // HOST_PREFERENCES_H
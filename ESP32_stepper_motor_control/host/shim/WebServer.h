@@ -0,0 +1,172 @@
+/*
+ * WebServer shim for host builds
+ *
+ * Routes register as on the device; requests come from request() instead
+ * of a socket, run the matching handler at once and return what it sent.
+ * Query arguments are parsed from the URI and the body is the "plain"
+ * argument, as the real server presents them.
+ */
+
+#ifndef HOST_WEB_SERVER_H
+#define HOST_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WiFiClient {
+public:
+  bool connected() { return true; }
+};
+
+// What a handler sent back
+struct HostResponse {
+  int code;
+  std::string type;
+  std::string body;
+  std::vector<std::pair<std::string, std::string>> headers;
+};
+
+class WebServer {
+public:
+  typedef std::function<void()> THandlerFunction;
+  
+private:
+  struct Route {
+    std::string uri;
+    HTTPMethod method;
+    THandlerFunction handler;
+  };
+  
+  std::vector<Route> routes;
+  std::vector<std::pair<std::string, std::string>> args;
+  std::vector<std::pair<std::string, std::string>> requestHeaders;
+  std::vector<std::pair<std::string, std::string>> pendingHeaders;
+  HostResponse response;
+  WiFiClient connection;
+  
+  static int hexValue(char c) {
+    return c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : 0;
+  }
+  
+  static std::string decode(const std::string& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); i++) {
+      if (text[i] == '+') {
+        out += ' ';
+      } else if (text[i] == '%' && i + 2 < text.size()) {
+        out += (char)(hexValue(text[i + 1]) * 16 + hexValue(text[i + 2]));
+        i += 2;
+      } else {
+        out += text[i];
+      }
+    }
+    return out;
+  }
+  
+  const std::string* find(const std::vector<std::pair<std::string, std::string>>& list, const String& name) const {
+    for (const auto& entry : list) {
+      if (entry.first == name.c_str()) return &entry.second;
+    }
+    return nullptr;
+  }
+  
+public:
+  explicit WebServer(int port = 80) {}
+  
+  void begin() {}
+  void handleClient() {}
+  void enableCORS(bool enable) {}
+  void collectHeaders(const char* keys[], size_t count) {}
+  
+  void on(const char* uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+  void on(const char* uri, HTTPMethod method, THandlerFunction handler) {
+    routes.push_back({ uri, method, handler });
+  }
+  
+  // Request side, for handlers
+  String arg(const String& name) const {
+    const std::string* value = find(args, name);
+    return value != nullptr ? String(*value) : String();
+  }
+  bool hasArg(const String& name) const { return find(args, name) != nullptr; }
+  String header(const String& name) const {
+    const std::string* value = find(requestHeaders, name);
+    return value != nullptr ? String(*value) : String();
+  }
+  WiFiClient& client() { return connection; }
+  
+  // Response side
+  void sendHeader(const String& name, const String& value, bool first = false) {
+    pendingHeaders.push_back({ name.c_str(), value.c_str() });
+  }
+  void setContentLength(size_t length) {}
+  void send(int code, const char* type = nullptr, const String& content = String()) {
+    send(code, type, content.c_str(), content.length());
+  }
+  void send(int code, const char* type, const char* content, size_t length) {
+    response.code = code;
+    response.type = type != nullptr ? type : "";
+    response.body.assign(content, length);
+    response.headers = pendingHeaders;
+  }
+  void send_P(int code, const char* type, const char* content, size_t length) { send(code, type, content, length); }
+  void sendContent(const char* content, size_t length) { response.body.append(content, length); }
+  void sendContent(const String& content) { response.body.append(content.c_str(), content.length()); }
+  
+  // Host side: run one request through the routes. uri may carry a
+  // query string; headers are "Name: value" lines.
+  HostResponse request(HTTPMethod method, const char* uri, const char* body = "", const char* headers = "") {
+    std::string path = uri;
+    std::string query;
+    size_t mark = path.find('?');
+    if (mark != std::string::npos) {
+      query = path.substr(mark + 1);
+      path.resize(mark);
+    }
+    
+    args.clear();
+    size_t at = 0;
+    while (at < query.size()) {
+      size_t next = query.find('&', at);
+      if (next == std::string::npos) next = query.size();
+      std::string pair = query.substr(at, next - at);
+      size_t equals = pair.find('=');
+      if (!pair.empty()) {
+        args.push_back({ decode(pair.substr(0, equals)), equals == std::string::npos ? "" : decode(pair.substr(equals + 1)) });
+      }
+      at = next + 1;
+    }
+    if (body != nullptr && *body != 0) args.push_back({ "plain", body });
+    
+    requestHeaders.clear();
+    for (const char* line = headers; line != nullptr && *line != 0;) {
+      const char* end = strchr(line, '\n');
+      std::string text = end != nullptr ? std::string(line, end) : std::string(line);
+      size_t colon = text.find(':');
+      if (colon != std::string::npos) {
+        size_t value = text.find_first_not_of(' ', colon + 1);
+        requestHeaders.push_back({ text.substr(0, colon), value == std::string::npos ? "" : text.substr(value) });
+      }
+      line = end != nullptr ? end + 1 : nullptr;
+    }
+    
+    pendingHeaders.clear();
+    response = HostResponse{ 404, "text/plain", "Not found", {} };
+    for (Route& route : routes) {
+      if (route.uri == path && (route.method == HTTP_ANY || route.method == method)) {
+        route.handler();
+        break;
+      }
+    }
+    return response;
+  }
+};
+
+#endif // HOST_WEB_SERVER_H
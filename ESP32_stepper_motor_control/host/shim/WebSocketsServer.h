@@ -0,0 +1,90 @@
+/*
+ * WebSocketsServer shim for host builds
+ *
+ * Clients connect, send text and disconnect through the host-side
+ * methods, which raise the same events the real server does; everything
+ * the firmware sends is kept per client until taken.
+ */
+
+#ifndef HOST_WEB_SOCKETS_SERVER_H
+#define HOST_WEB_SOCKETS_SERVER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "IPAddress.h"
+
+#define WEBSOCKETS_SERVER_CLIENT_MAX 5
+
+typedef enum {
+  WStype_ERROR,
+  WStype_DISCONNECTED,
+  WStype_CONNECTED,
+  WStype_TEXT,
+  WStype_BIN
+} WStype_t;
+
+// A message the firmware sent to a client
+struct HostWsMessage {
+  bool binary;
+  std::string data;
+};
+
+class WebSocketsServer {
+public:
+  typedef std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)> WebSocketServerEvent;
+  
+private:
+  WebSocketServerEvent event;
+  bool connected[WEBSOCKETS_SERVER_CLIENT_MAX] = {};
+  std::vector<HostWsMessage> outbox[WEBSOCKETS_SERVER_CLIENT_MAX];
+  
+  bool deliver(uint8_t num, bool binary, const char* data, size_t length) {
+    if (num >= WEBSOCKETS_SERVER_CLIENT_MAX || !connected[num]) return false;
+    outbox[num].push_back({ binary, std::string(data, length) });
+    return true;
+  }
+  
+public:
+  explicit WebSocketsServer(uint16_t port) {}
+  
+  void begin() {}
+  void loop() {}
+  void onEvent(WebSocketServerEvent callback) { event = callback; }
+  
+  bool sendTXT(uint8_t num, const char* payload, size_t length = 0) {
+    return deliver(num, false, payload, length != 0 ? length : strlen(payload));
+  }
+  bool sendTXT(uint8_t num, const String& payload) { return deliver(num, false, payload.c_str(), payload.length()); }
+  bool sendBIN(uint8_t num, const uint8_t* payload, size_t length) {
+    return deliver(num, true, (const char*)payload, length);
+  }
+  bool broadcastTXT(const char* payload, size_t length = 0) {
+    if (length == 0) length = strlen(payload);
+    for (uint8_t num = 0; num < WEBSOCKETS_SERVER_CLIENT_MAX; num++) deliver(num, false, payload, length);
+    return true;
+  }
+  IPAddress remoteIP(uint8_t num) { return IPAddress(127, 0, 0, 1); }
+  
+  // Host side
+  void connect(uint8_t num) {
+    connected[num] = true;
+    if (event) event(num, WStype_CONNECTED, nullptr, 0);
+  }
+  void disconnect(uint8_t num) {
+    connected[num] = false;
+    if (event) event(num, WStype_DISCONNECTED, nullptr, 0);
+  }
+  void receive(uint8_t num, const char* text) {
+    std::string copy(text);
+    if (event) event(num, WStype_TEXT, (uint8_t*)&copy[0], copy.size());
+  }
+  std::vector<HostWsMessage> take(uint8_t num) {
+    std::vector<HostWsMessage> messages;
+    messages.swap(outbox[num]);
+    return messages;
+  }
+};
+
+#endif // HOST_WEB_SOCKETS_SERVER_H
@@ -0,0 +1,27 @@
+/*
+ * WiFi shim for host builds - always connected
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_CONNECTED = 3,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+class HostWiFi {
+public:
+  wl_status_t status() { return WL_CONNECTED; }
+  IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+  String SSID() { return String("host"); }
+  bool reconnect() { return true; }
+};
+
+inline HostWiFi WiFi;
+
+#endif // HOST_WIFI_H
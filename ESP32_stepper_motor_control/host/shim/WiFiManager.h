@@ -0,0 +1,16 @@
+/*
+ * WiFiManager shim for host builds - connects at once, no portal
+ */
+
+#ifndef HOST_WIFI_MANAGER_H
+#define HOST_WIFI_MANAGER_H
+
+#include <Arduino.h>
+
+class WiFiManager {
+public:
+  void setConfigPortalTimeout(unsigned long seconds) {}
+  bool autoConnect(const char* apName, const char* apPassword) { return true; }
+};
+
+#endif // HOST_WIFI_MANAGER_H
@@ -0,0 +1,56 @@
+/*
+ * RMT encoder API shim for host builds (IDF 5 driver/rmt_encoder.h)
+ *
+ * Encoders work as in IDF: the channel calls encode() whenever it has
+ * free symbol memory, and the copy encoder moves rmt_symbol_word_t
+ * symbols from the payload into it until the payload ends or memory is
+ * full, resuming where it stopped on the next call.
+ */
+
+#ifndef HOST_DRIVER_RMT_ENCODER_H
+#define HOST_DRIVER_RMT_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "soc/soc_caps.h"
+
+#ifndef __containerof
+#define __containerof(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+#endif
+
+typedef struct rmt_channel_t* rmt_channel_handle_t;
+
+typedef enum {
+  RMT_ENCODING_RESET = 0,
+  RMT_ENCODING_COMPLETE = (1 << 0),
+  RMT_ENCODING_MEM_FULL = (1 << 1),
+} rmt_encode_state_t;
+
+typedef union {
+  struct {
+    uint16_t duration0 : 15;
+    uint16_t level0 : 1;
+    uint16_t duration1 : 15;
+    uint16_t level1 : 1;
+  };
+  uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct rmt_encoder_t rmt_encoder_t;
+struct rmt_encoder_t {
+  size_t (*encode)(rmt_encoder_t* encoder, rmt_channel_handle_t channel, const void* primary_data,
+                   size_t data_size, rmt_encode_state_t* ret_state);
+  esp_err_t (*reset)(rmt_encoder_t* encoder);
+  esp_err_t (*del)(rmt_encoder_t* encoder);
+};
+typedef rmt_encoder_t* rmt_encoder_handle_t;
+
+typedef struct {
+} rmt_copy_encoder_config_t;
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t* config, rmt_encoder_handle_t* ret_encoder);
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t encoder);
+esp_err_t rmt_encoder_reset(rmt_encoder_handle_t encoder);
+
+#endif // HOST_DRIVER_RMT_ENCODER_H
@@ -0,0 +1,18 @@
+/*
+ * esp_cpu.h shim for host builds - a 240 MHz cycle count from the
+ * real (not virtual) monotonic clock, so profiler figures are host time
+ */
+
+#ifndef HOST_ESP_CPU_H
+#define HOST_ESP_CPU_H
+
+#include <stdint.h>
+#include <time.h>
+
+static inline uint32_t esp_cpu_get_cycle_count() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)((uint64_t)now.tv_sec * 240000000ULL + (uint64_t)now.tv_nsec * 240 / 1000);
+}
+
+#endif // HOST_ESP_CPU_H
@@ -0,0 +1,17 @@
+/*
+ * esp_heap_caps.h shim for host builds - there is no PSRAM, and
+ * psramFound() says so, but SPIRAM requests still succeed from the heap
+ */
+
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+static inline void* heap_caps_malloc(size_t size, uint32_t caps) { return malloc(size); }
+
+#endif // HOST_ESP_HEAP_CAPS_H
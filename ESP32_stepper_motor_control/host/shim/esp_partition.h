@@ -0,0 +1,37 @@
+/*
+ * esp_partition.h shim for host builds
+ *
+ * One data partition, JOURNAL_PARTITION_LABEL's 64 KB from
+ * partitions.csv, held in memory with NOR flash rules: erase sets a
+ * sector to 0xFF and a write can only clear bits. Its contents survive
+ * hostReset(), as flash survives a reboot.
+ */
+
+#ifndef HOST_ESP_PARTITION_H
+#define HOST_ESP_PARTITION_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef enum { ESP_PARTITION_TYPE_APP = 0, ESP_PARTITION_TYPE_DATA = 1 } esp_partition_type_t;
+typedef enum { ESP_PARTITION_SUBTYPE_ANY = 0xff } esp_partition_subtype_t;
+
+typedef struct {
+  esp_partition_type_t type;
+  uint32_t address;
+  uint32_t size;
+  uint32_t erase_size;
+  const char* label;
+} esp_partition_t;
+
+const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char* label);
+esp_err_t esp_partition_read(const esp_partition_t* partition, size_t offset, void* dst, size_t size);
+esp_err_t esp_partition_write(const esp_partition_t* partition, size_t offset, const void* src, size_t size);
+esp_err_t esp_partition_erase_range(const esp_partition_t* partition, size_t offset, size_t size);
+
+// Wipe the partition to erased flash (all 0xFF)
+void hostErasePartition();
+
+#endif // HOST_ESP_PARTITION_H
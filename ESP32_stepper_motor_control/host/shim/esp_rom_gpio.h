@@ -0,0 +1,17 @@
+/*
+ * esp_rom_gpio.h shim for host builds - only routing a pin back to
+ * GPIO_OUT is modelled (the RMT driver routes pins to itself)
+ */
+
+#ifndef HOST_ESP_ROM_GPIO_H
+#define HOST_ESP_ROM_GPIO_H
+
+#include <stdint.h>
+#include "HostSim.h"
+#include "soc/gpio_sig_map.h"
+
+static inline void esp_rom_gpio_connect_out_signal(uint32_t gpio, uint32_t signal, bool outInv, bool oenInv) {
+  if (signal == SIG_GPIO_OUT_IDX) hostRouteToGpioOut(gpio);
+}
+
+#endif // HOST_ESP_ROM_GPIO_H
@@ -0,0 +1,22 @@
+/*
+ * esp_task_wdt.h shim for host builds - nothing to watch
+ */
+
+#ifndef HOST_ESP_TASK_WDT_H
+#define HOST_ESP_TASK_WDT_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef struct {
+  uint32_t timeout_ms;
+  uint32_t idle_core_mask;
+  bool trigger_panic;
+} esp_task_wdt_config_t;
+
+static inline esp_err_t esp_task_wdt_init(const esp_task_wdt_config_t* config) { return ESP_OK; }
+static inline esp_err_t esp_task_wdt_deinit() { return ESP_OK; }
+static inline esp_err_t esp_task_wdt_add(void* task) { return ESP_OK; }
+static inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
+
+#endif // HOST_ESP_TASK_WDT_H
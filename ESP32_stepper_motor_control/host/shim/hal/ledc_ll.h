@@ -0,0 +1,28 @@
+/*
+ * LEDC low-level shim for host builds - duties land in the simulator,
+ * taking effect on ledc_ll_ls_channel_update() as on the chip
+ */
+
+#ifndef HOST_HAL_LEDC_LL_H
+#define HOST_HAL_LEDC_LL_H
+
+#include <stdint.h>
+#include "HostSim.h"
+
+typedef enum { LEDC_LOW_SPEED_MODE = 0 } ledc_mode_t;
+typedef int ledc_channel_t;
+
+struct ledc_dev_t {};
+static ledc_dev_t LEDC;
+
+static inline void ledc_ll_set_duty_int_part(ledc_dev_t* hw, ledc_mode_t mode, ledc_channel_t channel,
+                                             uint32_t duty) {
+  hostLedcSetDuty(channel, duty);
+}
+static inline void ledc_ll_set_duty_start(ledc_dev_t* hw, ledc_mode_t mode, ledc_channel_t channel,
+                                          bool start) {}
+static inline void ledc_ll_ls_channel_update(ledc_dev_t* hw, ledc_mode_t mode, ledc_channel_t channel) {
+  hostLedcUpdate(channel);
+}
+
+#endif // HOST_HAL_LEDC_LL_H
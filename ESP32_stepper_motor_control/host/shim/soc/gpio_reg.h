@@ -0,0 +1,14 @@
+/*
+ * GPIO register addresses (ESP32-S3) for host builds; REG_READ and
+ * REG_WRITE on them go to the simulator's GPIO_OUT
+ */
+
+#ifndef HOST_SOC_GPIO_REG_H
+#define HOST_SOC_GPIO_REG_H
+
+#define DR_REG_GPIO_BASE 0x60004000
+#define GPIO_OUT_REG (DR_REG_GPIO_BASE + 0x0004)
+#define GPIO_OUT_W1TS_REG (DR_REG_GPIO_BASE + 0x0008)
+#define GPIO_OUT_W1TC_REG (DR_REG_GPIO_BASE + 0x000c)
+
+#endif // HOST_SOC_GPIO_REG_H
@@ -0,0 +1,10 @@
+/*
+ * GPIO matrix signal numbers for host builds
+ */
+
+#ifndef HOST_SOC_GPIO_SIG_MAP_H
+#define HOST_SOC_GPIO_SIG_MAP_H
+
+#define SIG_GPIO_OUT_IDX 256
+
+#endif // HOST_SOC_GPIO_SIG_MAP_H
@@ -0,0 +1,11 @@
+/*
+ * SoC capabilities (ESP32-S3) for host builds
+ */
+
+#ifndef HOST_SOC_SOC_CAPS_H
+#define HOST_SOC_SOC_CAPS_H
+
+#define SOC_RMT_TX_CANDIDATES_PER_GROUP 4
+#define SOC_RMT_MEM_WORDS_PER_CHANNEL 48
+
+#endif // HOST_SOC_SOC_CAPS_H
@@ -0,0 +1,145 @@
+/*
+ * Host stream waveform - the coil waveforms StepStream's own encoders
+ * produce for a move, written for tools/step_waveform.py verify
+ *
+ *   build/stream_wave [--steps N] [--speed S] [--accel A] move.wave
+ *
+ * Built with STEP_STREAM set. Axis 0 makes one move from 0 with a step
+ * trace running; the RMT shim keeps every symbol the encoders wrote.
+ * The .wave file (format in step_waveform.py) holds the planned steps
+ * from the trace, where the stream said it ends, and those symbols, so
+ * verify checks the firmware's expansion rather than the tool's copy
+ * of it. Speed and acceleration are in half-steps, as in the API.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "HostTest.h"
+#include "StepperMotor.h"
+
+static_assert(STEP_STREAM, "Build stream_wave with STEP_STREAM=1");
+
+struct WaveHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t drive;
+  uint16_t flags;
+  uint16_t maxHalf;
+  uint32_t stepCount;
+  uint32_t symbolCount;
+  uint32_t lookahead;
+  uint32_t end;
+} __attribute__((packed));
+
+struct WaveStep {
+  uint32_t time;
+  int32_t position;
+  uint8_t phase;
+  uint8_t pad[3];
+} __attribute__((packed));
+
+// The trace's steps with absolute times and positions (as decode_trace.py)
+static std::vector<WaveStep> traceSteps(const StepTrace& trace) {
+  StepTraceHeader header = trace.header();
+  uint32_t time = header.baseTime;
+  int32_t position = header.basePosition;
+  std::vector<WaveStep> steps;
+  for (int p = 0; p < 2; p++) {
+    const StepTraceRecord* data = nullptr;
+    uint32_t count = trace.piece(p, data);
+    for (uint32_t i = 0; i < count; i++) {
+      const StepTraceRecord& r = data[i];
+      time += r.interval;
+      if (!(r.flags & TRACE_STEP_SLACK)) position += (r.flags & TRACE_STEP_REVERSE) ? -1 : 1;
+      steps.push_back({ time, position, r.phase, {} });
+    }
+  }
+  return steps;
+}
+
+int main(int argc, char** argv) {
+  int distance = 3000;
+  int speed = MAX_SPEED;
+  int accel = DEFAULT_ACCELERATION;
+  const char* path = nullptr;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+      distance = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+      speed = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--accel") == 0 && i + 1 < argc) {
+      accel = atoi(argv[++i]);
+    } else {
+      path = argv[i];
+    }
+  }
+  if (path == nullptr || distance <= 0 || distance > DEFAULT_MAX_STEPS || speed <= 0 || accel <= 0) {
+    fprintf(stderr, "usage: %s [--steps 1..%d] [--speed S] [--accel A] move.wave\n", argv[0], DEFAULT_MAX_STEPS);
+    return 2;
+  }
+  
+  MotorConfig config = hostMotorConfig(DEFAULT_MAX_STEPS, speed);
+  config.acceleration = accel;
+  
+  hostPinLogging(false);
+  StepScheduler scheduler;
+  StepStream stream;
+  StepTrace trace;
+  StepperMotor motor;
+  motor.begin(config, axisPins[0], 0, scheduler);
+  scheduler.begin();
+  if (!stream.begin(axisPins[0], SelectedDrive::SEQUENCE) || !trace.start()) {
+    fprintf(stderr, "Could not set up the stream and trace\n");
+    return 2;
+  }
+  motor.setStream(&stream);
+  motor.setTrace(&trace);
+  hostClearRmtSymbols();           // The release begin() played
+  
+  // The motion task's loop, until the waveform has played out
+  motor.setTargetPosition(distance);
+  int64_t timeout = hostMicros() + 600000000;
+  while (hostMicros() < timeout && (motor.isRunning() || stream.isActive())) {
+    hostAdvance(MOTION_TASK_INTERVAL * 1000);
+    motor.update();
+    trace.service();
+  }
+  trace.stop();
+  if (stream.isActive() || motor.getCurrentPosition() != distance) {
+    fprintf(stderr, "Move did not finish: at %d of %d\n", motor.getCurrentPosition(), distance);
+    return 1;
+  }
+  if (trace.header().flags != 0) {
+    fprintf(stderr, "Trace lost steps; use at most %u\n", trace.getCapacity());
+    return 1;
+  }
+  
+  const CoilPins& pins = axisPins[0];
+  const std::vector<uint32_t>* coils[4] = { &hostRmtSymbols(pins.a), &hostRmtSymbols(pins.b),
+                                            &hostRmtSymbols(pins.c), &hostRmtSymbols(pins.d) };
+  for (const std::vector<uint32_t>* symbols : coils) {
+    if (symbols->size() != coils[0]->size()) {
+      fprintf(stderr, "Coils were sent different symbol counts\n");
+      return 1;
+    }
+  }
+  std::vector<WaveStep> steps = traceSteps(trace);
+  WaveHeader header = { { 'S', 'W', 'A', 'V' }, 1, DRIVE_MODE, 0, STREAM_MAX_HALF, (uint32_t)steps.size(),
+                        (uint32_t)coils[0]->size(), STREAM_LOOKAHEAD_US, stream.getRestTime() };
+                        
+  FILE* file = fopen(path, "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "Cannot write %s\n", path);
+    return 2;
+  }
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(steps.data(), sizeof(WaveStep), steps.size(), file);
+  for (const std::vector<uint32_t>* symbols : coils) fwrite(symbols->data(), sizeof(uint32_t), symbols->size(), file);
+  if (fclose(file) != 0) {
+    fprintf(stderr, "Cannot write %s\n", path);
+    return 2;
+  }
+  fprintf(stderr, "%zu steps, %.3f s, %zu symbols per coil\n", steps.size(), header.end / 1e6, coils[0]->size());
+  return 0;
+}
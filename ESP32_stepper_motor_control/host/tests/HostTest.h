@@ -0,0 +1,89 @@
+/*
+ * Host Test - Minimal test registry for the host build
+ *
+ * TEST(name) { ... } registers a test; CHECK() records a failure and
+ * carries on. Each test starts from hostReset() unless told otherwise.
+ * hostRunTests() runs them all (or those named on the command line) and
+ * returns the exit code for ctest. hostMotorConfig() is the motor setup
+ * the tests, benches and stream_wave start from.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "HostSim.h"
+#include "Config.h"
+
+struct HostTestCase {
+  const char* name;
+  void (*run)();
+};
+
+static inline std::vector<HostTestCase>& hostTests() {
+  static std::vector<HostTestCase> tests;
+  return tests;
+}
+
+static inline int& hostTestFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+struct HostTestRegistrar {
+  HostTestRegistrar(const char* name, void (*run)()) { hostTests().push_back({ name, run }); }
+};
+
+#define TEST(name)                                              \
+  static void name();                                           \
+  static HostTestRegistrar name##Registrar(#name, name);        \
+  static void name()
+  
+#define CHECK(condition)                                                               \
+  do {                                                                                 \
+    if (!(condition)) {                                                                \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);    \
+      hostTestFailures()++;                                                            \
+    }                                                                                  \
+  } while (0)
+  
+// The default settings, with no backlash compensation
+static inline MotorConfig hostMotorConfig(int maxSteps = DEFAULT_MAX_STEPS, int speed = DEFAULT_SPEED) {
+  MotorConfig config;
+  config.maxSteps = maxSteps;
+  config.stepsPerRotation = DEFAULT_STEPS_PER_ROTATION;
+  config.defaultSpeed = speed;
+  config.minSpeed = MIN_SPEED;
+  config.maxSpeed = MAX_SPEED;
+  config.softLimitWarning = SOFT_LIMIT_WARNING;
+  config.acceleration = DEFAULT_ACCELERATION;
+  config.jerk = DEFAULT_JERK;
+  config.backlashMode = BACKLASH_OFF;
+  config.backlashSteps = 0;
+  config.backlashDirection = 1;
+  return config;
+}
+
+// reset = false keeps state between tests (one booted sketch)
+static inline int hostRunTests(int argc, char** argv, bool reset = true) {
+  int run = 0;
+  for (const HostTestCase& test : hostTests()) {
+    bool wanted = argc < 2;
+    for (int i = 1; i < argc; i++) wanted |= strcmp(argv[i], test.name) == 0;
+    if (!wanted) continue;
+    int before = hostTestFailures();
+    if (reset) hostReset();
+    test.run();
+    printf("%s %s\n", hostTestFailures() == before ? "PASS" : "FAIL", test.name);
+    run++;
+  }
+  if (run == 0) {
+    fprintf(stderr, "No tests matched\n");
+    return 1;
+  }
+  return hostTestFailures() == 0 ? 0 : 1;
+}
+
+#endif // HOST_TEST_H
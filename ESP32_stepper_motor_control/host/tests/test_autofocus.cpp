@@ -0,0 +1,129 @@
+/*
+ * Autofocus tests - sweeps over a synthetic V-curve, with the engine
+ * driving a simulated motor the way serviceAutofocus() does
+ */
+
+#include "HostTest.h"
+#include "StepperMotor.h"
+#include "Autofocus.h"
+
+// ----------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------
+static MotorStatus statusOf(const StepperMotor& motor) {
+  MotorStatus status = {};
+  status.position = motor.getCurrentPosition();
+  status.target = motor.getTargetPosition();
+  status.speed = motor.getSpeed();
+  status.state = motor.getState();
+  status.running = motor.isRunning();
+  status.maxSteps = motor.getMaxSteps();
+  return status;
+}
+
+// HFR of a star at this focuser position: a hyperbola around focus
+static float hfrAt(int position, double focus) {
+  double offset = (position - focus) / 1000.0;
+  return (float)sqrt(4.0 * offset * offset + 1.5);
+}
+
+struct Run {
+  std::vector<AutofocusEvent> events;
+  bool finished;
+};
+
+// Run the engine against one motor; stopAtSample >= 0 emergency-stops
+// the motor once that sample's move is under way
+static Run runAutofocus(StepperMotor& motor, const AutofocusParams& params, double focus, int stopAtSample = -1) {
+  AutofocusEngine engine;
+  Run run = { {}, false };
+  engine.start(params);
+  for (int pass = 0; pass < 200000 && engine.isActive(); pass++) {
+    hostAdvance(MOTION_TASK_INTERVAL * 1000);
+    motor.update();
+    unsigned long now = millis();
+    int target;
+    if (engine.pendingMove(target)) {
+      motor.setTargetPosition(target);
+      engine.moveSent(now);
+    }
+    if (stopAtSample >= 0 && motor.isRunning() && (int)run.events.size() == stopAtSample) {
+      motor.emergencyStop();
+      stopAtSample = -1;
+    }
+    AutofocusEvent event;
+    if (!engine.poll(statusOf(motor), now, event)) continue;
+    run.events.push_back(event);
+    if (event.type == AF_EVENT_SAMPLE) {
+      CommandResult result = engine.addMetric(event.index, hfrAt(event.position, focus));
+      CHECK(result.code == 200);
+    }
+  }
+  run.finished = !engine.isActive();
+  return run;
+}
+
+static AutofocusParams sweep(int start, int step, int count) {
+  AutofocusParams params;
+  params.axis = 0;
+  params.start = start;
+  params.step = step;
+  params.count = count;
+  params.metric = METRIC_HFR;
+  params.settle = 0;
+  params.backlash = AUTOFOCUS_BACKLASH_STEPS;
+  return params;
+}
+
+// ----------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------
+TEST(findsFocusInSweep) {
+  StepScheduler scheduler;
+  StepperMotor motor;
+  motor.begin(hostMotorConfig(20000, MAX_SPEED), axisPins[0], 0, scheduler);
+  scheduler.begin();
+  Run run = runAutofocus(motor, sweep(-2400, 600, 9), 310.0);
+  CHECK(run.finished);
+  CHECK(run.events.size() == 10);
+  const AutofocusEvent& done = run.events.back();
+  CHECK(done.type == AF_EVENT_DONE);
+  CHECK(done.haveEstimate && abs(done.estimate - 310) <= 2);
+  CHECK(motor.getCurrentPosition() == done.estimate);
+}
+
+// A vertex just past the first sample, with the sweep against the travel
+// limit, is taken as the first sample rather than a move the limit clamps
+TEST(focusPastSweepEndAtLimit) {
+  const int limit = 8000;
+  StepScheduler scheduler;
+  StepperMotor motor;
+  motor.begin(hostMotorConfig(limit, MAX_SPEED), axisPins[0], 0, scheduler);
+  scheduler.begin();
+  int start = -limit + AUTOFOCUS_BACKLASH_STEPS;
+  Run run = runAutofocus(motor, sweep(start, 500, 7), start - 0.3 * 500);
+  CHECK(run.finished);
+  CHECK(!run.events.empty() && run.events.back().type == AF_EVENT_DONE);
+  CHECK(!run.events.empty() && run.events.back().estimate == start);
+  CHECK(motor.getCurrentPosition() == start);
+}
+
+// An emergency stop mid-sweep fails the run instead of leaving it waiting
+TEST(emergencyStopFailsRun) {
+  StepScheduler scheduler;
+  StepperMotor motor;
+  motor.begin(hostMotorConfig(20000, MAX_SPEED), axisPins[0], 0, scheduler);
+  scheduler.begin();
+  Run run = runAutofocus(motor, sweep(-2400, 600, 9), 310.0, 3);
+  CHECK(run.finished);
+  CHECK(run.events.size() == 4);
+  const AutofocusEvent& failed = run.events.back();
+  CHECK(failed.type == AF_EVENT_FAILED);
+  CHECK(failed.message != nullptr && strcmp(failed.message, "Emergency stop") == 0);
+  CHECK(failed.position == motor.getCurrentPosition());
+  CHECK(hostMicros() < 60 * 1000000LL);
+}
+
+int main(int argc, char** argv) {
+  return hostRunTests(argc, argv);
+}
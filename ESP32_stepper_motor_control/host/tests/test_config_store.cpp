@@ -0,0 +1,231 @@
+/*
+ * Persistence and plumbing tests - ConfigStore against the in-memory
+ * NVS, PositionJournal against the simulated flash partition, and the
+ * lock-free queues between the tasks
+ */
+
+#include <esp_partition.h>
+#include "HostTest.h"
+#include "ConfigStore.h"
+#include "PositionJournal.h"
+#include "MotionControl.h"
+
+// Version 3 blob layout, as ConfigStore writes it
+struct StoredBlob {
+  uint16_t version;
+  uint16_t size;
+  int32_t maxSteps;
+  int32_t stepsPerRotation;
+  int32_t speed;
+  int32_t acceleration;
+  int32_t jerk;
+  int32_t backlashMode;
+  int32_t backlashSteps;
+  int32_t backlashDirection;
+  int32_t stepsPerFullStep;
+  int32_t driveMode;
+};
+
+// ----------------------------------------------------------------
+// ConfigStore
+// ----------------------------------------------------------------
+TEST(configDefaultsOnBlankChip) {
+  Preferences::eraseAll();
+  Preferences::writes() = 0;
+  ConfigStore store;
+  store.begin();
+  MotorConfig config = store.get(0);
+  CHECK(config.maxSteps == DEFAULT_MAX_STEPS);
+  CHECK(config.stepsPerRotation == DEFAULT_STEPS_PER_ROTATION);
+  CHECK(config.defaultSpeed == DEFAULT_SPEED);
+  CHECK(config.acceleration == DEFAULT_ACCELERATION);
+  CHECK(config.backlashMode == DEFAULT_BACKLASH_MODE);
+  CHECK(!store.unitsChanged(0));
+  CHECK(Preferences::writes() == AXIS_COUNT);   // Each axis's blob created once
+}
+
+// set() only touches RAM; the blob is written by flush()
+TEST(configWriteBehind) {
+  Preferences::eraseAll();
+  ConfigStore store;
+  store.begin();
+  Preferences::writes() = 0;
+  for (int speed = 200; speed < 300; speed += 10) store.set(0, &MotorConfig::defaultSpeed, speed);
+  store.set(0, &MotorConfig::maxSteps, 30000);
+  CHECK(store.get(0).defaultSpeed == 290);
+  CHECK(Preferences::writes() == 0);
+  store.flush();
+  CHECK(Preferences::writes() == 1);
+  store.flush();
+  CHECK(Preferences::writes() == 1);            // Nothing changed since
+  
+  ConfigStore rebooted;
+  rebooted.begin();
+  CHECK(rebooted.get(0).defaultSpeed == 290);
+  CHECK(rebooted.get(0).maxSteps == 30000);
+}
+
+static bool quiet;
+static bool isQuiet() { return quiet; }
+
+// The flush task's write waits while an axis moves and goes through at
+// the next quiet check
+TEST(configFlushWaitsForRest) {
+  Preferences::eraseAll();
+  ConfigStore store;
+  store.begin(isQuiet);
+  Preferences::writes() = 0;
+  store.set(0, &MotorConfig::defaultSpeed, 250);
+  quiet = false;
+  CHECK(!store.flushIfQuiet());
+  CHECK(!store.flushIfQuiet());
+  CHECK(Preferences::writes() == 0);
+  quiet = true;
+  CHECK(store.flushIfQuiet());
+  CHECK(Preferences::writes() == 1);
+  
+  quiet = false;
+  store.set(0, &MotorConfig::defaultSpeed, 260);
+  store.flush();                                // Before a restart, regardless
+  CHECK(Preferences::writes() == 2);
+}
+
+// Older firmware's per-key settings become axis 0's blob
+TEST(configMigratesLegacyKeys) {
+  Preferences::eraseAll();
+  Preferences legacy;
+  legacy.begin(CONFIG_NAMESPACE, false);
+  legacy.putInt("maxSteps", 12000);
+  legacy.putInt("speed", 321);
+  legacy.putInt("blMode", BACKLASH_SLACK);
+  legacy.putInt("blSteps", 40);
+  ConfigStore store;
+  store.begin();
+  MotorConfig config = store.get(0);
+  CHECK(config.maxSteps == 12000 * STEPS_PER_FULL_STEP / 2);
+  CHECK(config.defaultSpeed == 321);
+  CHECK(config.backlashMode == BACKLASH_SLACK);
+  CHECK(config.backlashSteps == 40 * STEPS_PER_FULL_STEP / 2);
+  
+  StoredBlob blob;
+  CHECK(legacy.getBytes(CONFIG_BLOB_KEY, &blob, sizeof(blob)) == sizeof(blob));
+  CHECK(blob.version == CONFIG_SCHEMA_VERSION);
+}
+
+// A blob saved under full-step drive is rescaled to this build's steps
+TEST(configRescalesDriveMode) {
+  Preferences::eraseAll();
+  StoredBlob blob = { CONFIG_SCHEMA_VERSION, sizeof(StoredBlob), 5000, 2048, 150, 2000, 0,
+                      BACKLASH_OFF, 10, 1, 1, DRIVE_FULL_STEP };
+  Preferences prefs;
+  prefs.begin(CONFIG_NAMESPACE, false);
+  prefs.putBytes(CONFIG_BLOB_KEY, &blob, sizeof(blob));
+  ConfigStore store;
+  store.begin();
+  CHECK(store.get(0).maxSteps == 5000 * STEPS_PER_FULL_STEP);
+  CHECK(store.get(0).backlashSteps == 10 * STEPS_PER_FULL_STEP);
+  CHECK(store.unitsChanged(0) == (DRIVE_MODE != DRIVE_FULL_STEP));
+}
+
+// A saved speed outside MIN_SPEED..MAX_SPEED loads as the default
+TEST(configRejectsStoredSpeed) {
+  const int speeds[] = { 0, -5, MAX_SPEED + 1, 50000 };
+  for (int speed : speeds) {
+    Preferences::eraseAll();
+    StoredBlob blob = { CONFIG_SCHEMA_VERSION, sizeof(StoredBlob), 5000, 2048, speed, 2000, 0,
+                        BACKLASH_OFF, 10, 1, STEPS_PER_FULL_STEP, DRIVE_MODE };
+    Preferences prefs;
+    prefs.begin(CONFIG_NAMESPACE, false);
+    prefs.putBytes(CONFIG_BLOB_KEY, &blob, sizeof(blob));
+    ConfigStore store;
+    store.begin();
+    CHECK(store.get(0).defaultSpeed == DEFAULT_SPEED);
+  }
+}
+
+// ----------------------------------------------------------------
+// PositionJournal
+// ----------------------------------------------------------------
+TEST(journalRestoresNewest) {
+  hostErasePartition();
+  PositionJournal journal;
+  CHECK(!journal.begin());
+  CHECK(journal.isReady());
+  CHECK(journal.append(0, 100, 3));
+  CHECK(journal.append(0, 250, 5));
+  
+  PositionJournal rebooted;
+  CHECK(rebooted.begin());
+  int position = 0, phase = 0;
+  CHECK(rebooted.saved(0, position, phase));
+  CHECK(position == 250 && phase == 5);
+}
+
+// Writes wrap around the partition, erasing a sector at a time
+TEST(journalWraps) {
+  hostErasePartition();
+  PositionJournal journal;
+  journal.begin();
+  const int records = 3 * 0x10000 / 16;
+  for (int i = 1; i <= records; i++) journal.append(0, i, i & 7);
+  
+  PositionJournal rebooted;
+  CHECK(rebooted.begin());
+  int position = 0, phase = 0;
+  CHECK(rebooted.saved(0, position, phase));
+  CHECK(position == records && phase == (records & 7));
+}
+
+// ----------------------------------------------------------------
+// Queues between the tasks
+// ----------------------------------------------------------------
+TEST(commandQueueFifo) {
+  CommandQueue queue;
+  MotionCommand command;
+  CHECK(!queue.pop(command));
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < COMMAND_QUEUE_SIZE; i++) CHECK(queue.push({ CMD_SET_TARGET, round * 100 + i, 0 }));
+    CHECK(!queue.push({ CMD_SET_TARGET, -1, 0 }));
+    CHECK(!queue.hasRoom());
+    for (int i = 0; i < COMMAND_QUEUE_SIZE; i++) {
+      CHECK(queue.pop(command));
+      CHECK(command.value == round * 100 + i);
+    }
+    CHECK(!queue.pop(command));
+  }
+}
+
+TEST(commandQueueRoom) {
+  CommandQueue queue;
+  MotionCommand command;
+  CHECK(queue.hasRoom(COMMAND_QUEUE_SIZE));
+  CHECK(!queue.hasRoom(COMMAND_QUEUE_SIZE + 1));
+  for (int i = 0; i < COMMAND_QUEUE_SIZE - 2; i++) queue.push({ CMD_SET_TARGET, i, 0 });
+  CHECK(queue.hasRoom(2));
+  CHECK(!queue.hasRoom(3));
+  queue.pop(command);
+  CHECK(queue.hasRoom(3));
+}
+
+TEST(statusSnapshotAndHandoff) {
+  StatusSnapshot snapshot;
+  MotorStatus status = {};
+  status.position = 42;
+  status.state = STATE_RUNNING;
+  snapshot.publish(status);
+  CHECK(sameStatus(snapshot.read(), status));
+  
+  HandoffSlot<int> slot;
+  int value = 0;
+  CHECK(!slot.take(value));
+  CHECK(slot.offer(1));
+  CHECK(!slot.offer(2));
+  CHECK(slot.take(value) && value == 1);
+  CHECK(slot.offer(3));
+  slot.withdraw();
+  CHECK(!slot.take(value));
+}
+
+int main(int argc, char** argv) {
+  return hostRunTests(argc, argv);
+}
@@ -0,0 +1,437 @@
+/*
+ * Motion tests - full moves through StepperMotor and StepScheduler on
+ * the virtual clock, checked against the coil changes the simulator
+ * recorded on the pins
+ */
+
+#include <chrono>
+#include "HostTest.h"
+#include "StepperMotor.h"
+#include "MotionSequence.h"
+
+// ----------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------
+// The motion task's share: every axis and the scheduler, updated each
+// MOTION_TASK_INTERVAL
+struct Rig {
+  StepScheduler scheduler;
+  StepperMotor motors[AXIS_COUNT];
+  
+  explicit Rig(const MotorConfig& config = hostMotorConfig()) {
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      motors[axis].begin(config, axisPins[axis], axis, scheduler);
+    }
+    scheduler.begin();
+  }
+  
+  void run(int64_t us) {
+    int64_t end = hostMicros() + us;
+    while (hostMicros() < end) {
+      hostAdvance(MOTION_TASK_INTERVAL * 1000);
+      for (StepperMotor& motor : motors) motor.update();
+    }
+  }
+  
+  // Run until every axis is at rest on its target; false on timeout
+  bool settle(int64_t timeout = 120000000) {
+    int64_t end = hostMicros() + timeout;
+    while (hostMicros() < end) {
+      hostAdvance(MOTION_TASK_INTERVAL * 1000);
+      bool moving = false;
+      for (StepperMotor& motor : motors) {
+        motor.update();
+        moving |= motor.isRunning() || motor.getCurrentPosition() != motor.getTargetPosition();
+      }
+      if (!moving) return true;
+    }
+    return false;
+  }
+};
+
+struct CoilChange {
+  int64_t time;
+  int phase;                       // Drive phase the coils show, or -1
+  bool on;                         // Any coil energised
+};
+
+#if DRIVE_MODE == DRIVE_MICROSTEP
+// Duties of coils A..D in a phase, worked out afresh from the angle:
+// winding A/C follows cos and B/D sin
+static void phaseDuties(int phase, uint32_t duty[4]) {
+  const float maxDuty = (1 << PWM_RESOLUTION) - 1;
+  float angle = phase * 2 * (float)M_PI / SelectedDrive::PHASES;
+  long cosine = lroundf(cosf(angle) * maxDuty);
+  long sine = lroundf(sinf(angle) * maxDuty);
+  duty[0] = cosine > 0 ? cosine : 0;
+  duty[1] = sine > 0 ? sine : 0;
+  duty[2] = cosine < 0 ? -cosine : 0;
+  duty[3] = sine < 0 ? -sine : 0;
+}
+
+// Phase with these duties (within a count of rounding), or -1
+static int phaseOf(const uint32_t duty[4]) {
+  for (int phase = 0; phase < SelectedDrive::PHASES; phase++) {
+    uint32_t expected[4];
+    phaseDuties(phase, expected);
+    bool match = true;
+    for (int coil = 0; coil < 4; coil++) match &= labs((long)duty[coil] - (long)expected[coil]) <= 1;
+    if (match) return phase;
+  }
+  return -1;
+}
+
+// Every change of an axis's coil duties, in order
+static std::vector<CoilChange> coilChanges(int axis) {
+  const int first = axis * PWM_CHANNELS_PER_AXIS;
+  const int channels[4] = { first + PWM_CHANNEL_A, first + PWM_CHANNEL_B, first + PWM_CHANNEL_C, first + PWM_CHANNEL_D };
+  std::vector<CoilChange> changes;
+  uint32_t last[4] = {};
+  for (const HostLedcEvent& event : hostLedcLog()) {
+    uint32_t duty[4];
+    bool changed = false;
+    bool on = false;
+    for (int coil = 0; coil < 4; coil++) {
+      duty[coil] = event.duty[channels[coil]];
+      changed |= duty[coil] != last[coil];
+      on |= duty[coil] != 0;
+      last[coil] = duty[coil];
+    }
+    if (changed) changes.push_back({ event.time, on ? phaseOf(duty) : -1, on });
+  }
+  return changes;
+}
+#else
+// Phase of the drive sequence with these coils on, or -1
+static int phaseOf(int coils) {
+  for (int phase = 0; phase < SelectedDrive::PHASES; phase++) {
+    const int* row = SelectedDrive::SEQUENCE[phase];
+    if (coils == (row[0] | (row[1] << 1) | (row[2] << 2) | (row[3] << 3))) return phase;
+  }
+  return -1;
+}
+
+// Every change of an axis's coil outputs, in order
+static std::vector<CoilChange> coilChanges(int axis) {
+  const CoilPins& pins = axisPins[axis];
+  std::vector<CoilChange> changes;
+  int last = 0;
+  for (const HostPinEvent& event : hostPinLog()) {
+    int coils = hostCoils(event.pins, pins.a, pins.b, pins.c, pins.d);
+    if (coils != last) changes.push_back({ event.time, phaseOf(coils), coils != 0 });
+    last = coils;
+  }
+  return changes;
+}
+#endif
+
+struct MoveRecord {
+  std::vector<int64_t> times;      // When each step's coils came on
+  bool adjacent;                   // Each step moved one phase the right way
+  bool released;                   // Coils off once the move ended
+};
+
+// The steps an axis made from fromPhase, moving direction
+static MoveRecord recordMove(int axis, int fromPhase, int direction) {
+  MoveRecord move = { {}, true, false };
+  int phase = fromPhase;
+  for (const CoilChange& change : coilChanges(axis)) {
+    move.released = !change.on;
+    if (!change.on) continue;
+    phase = (phase + direction) & (SelectedDrive::PHASES - 1);
+    move.adjacent &= change.phase == phase;
+    move.times.push_back(change.time);
+  }
+  return move;
+}
+
+// Scales the half-step tests' distances so their moves keep the same
+// shape in microsteps, whose ramps take MICROSTEPS times the steps
+static const int HALF_STEP = STEPS_PER_FULL_STEP > 2 ? STEPS_PER_FULL_STEP / 2 : 1;
+
+static std::vector<int64_t> intervals(const std::vector<int64_t>& times) {
+  std::vector<int64_t> gaps;
+  for (size_t i = 1; i < times.size(); i++) gaps.push_back(times[i] - times[i - 1]);
+  return gaps;
+}
+
+// ----------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------
+
+// Ramps up, cruises at the set speed, ramps down, lands on the target
+TEST(fullMoveStepTimes) {
+  Rig rig;
+  StepperMotor& motor = rig.motors[0];
+  motor.setSpeed(500);
+  int64_t start = hostMicros();
+  motor.setTargetPosition(2000 * HALF_STEP);
+  CHECK(rig.settle());
+  CHECK(motor.getCurrentPosition() == 2000 * HALF_STEP);
+  CHECK(motor.getState() == STATE_STOPPED);
+  CHECK(!motor.isRunning());
+  CHECK(hostRegStats().reads == 0);     // Coils set and cleared, never read back
+  
+  MoveRecord move = recordMove(0, 0, 1);
+  CHECK(move.times.size() == 2000 * HALF_STEP);
+  CHECK(move.adjacent);
+  CHECK(move.released);
+  CHECK(move.times.front() >= start);
+  
+  std::vector<int64_t> gaps = intervals(move.times);
+  const int64_t cruise = 1000000 / (500 * STEPS_PER_HALF_STEP);
+  int64_t shortest = *std::min_element(gaps.begin(), gaps.end());
+  CHECK(shortest >= cruise - 1);
+  CHECK(gaps.front() > 2 * cruise);
+  CHECK(gaps.back() > 2 * cruise);
+  CHECK(llabs(gaps[gaps.size() / 2] - cruise) <= 1);
+  for (size_t i = 1; i < gaps.size() / 2; i++) CHECK(gaps[i] <= gaps[i - 1] + 1);
+  for (size_t i = gaps.size() / 2 + 1; i < gaps.size(); i++) CHECK(gaps[i] + 1 >= gaps[i - 1]);
+}
+
+// Without a jerk limit the ramp is v^2 / 2a steps long
+TEST(trapezoidRampLength) {
+  MotorConfig config = hostMotorConfig();
+  config.jerk = 0;
+  Rig rig(config);
+  StepperMotor& motor = rig.motors[0];
+  motor.setSpeed(500);
+  motor.setTargetPosition(1000);
+  CHECK(rig.settle());
+  
+  MoveRecord move = recordMove(0, 0, 1);
+  std::vector<int64_t> gaps = intervals(move.times);
+  const int64_t cruise = 1000000 / (500 * STEPS_PER_HALF_STEP);
+  int ramp = 0;
+  while (ramp < (int)gaps.size() && gaps[ramp] > cruise + 1) ramp++;
+  float expected = 500.0f * 500.0f / (2.0f * DEFAULT_ACCELERATION) * STEPS_PER_HALF_STEP;
+  CHECK(fabsf(ramp - expected) <= 3);
+}
+
+TEST(reverseMove) {
+  Rig rig;
+  StepperMotor& motor = rig.motors[0];
+  motor.setTargetPosition(-300);
+  CHECK(rig.settle());
+  CHECK(motor.getCurrentPosition() == -300);
+  
+  MoveRecord move = recordMove(0, 0, -1);
+  CHECK(move.times.size() == 300);
+  CHECK(move.adjacent);
+  CHECK(move.released);
+}
+
+// A new target against the motion decelerates to rest, then reverses
+TEST(retargetReverses) {
+  Rig rig;
+  StepperMotor& motor = rig.motors[0];
+  motor.setSpeed(400);
+  motor.setTargetPosition(3000 * HALF_STEP);
+  rig.run(1500000);
+  int reached = motor.getCurrentPosition();
+  CHECK(reached > 200 * HALF_STEP && reached < 2500 * HALF_STEP);
+  motor.setTargetPosition(100 * HALF_STEP);
+  CHECK(rig.settle());
+  CHECK(motor.getCurrentPosition() == 100 * HALF_STEP);
+  
+  const int64_t cruise = 1000000 / (400 * STEPS_PER_HALF_STEP);
+  int64_t last = -1;
+  int phase = 0;
+  int previous = -1;
+  int turns = 0;
+  bool adjacent = true;
+  for (const CoilChange& change : coilChanges(0)) {
+    if (!change.on) continue;
+    int next = change.phase;
+    int direction = ((next - phase) & (SelectedDrive::PHASES - 1)) == 1 ? 1 : -1;
+    adjacent &= ((phase + direction) & (SelectedDrive::PHASES - 1)) == next;
+    if (previous != -1 && direction != previous) turns++;
+    if (last >= 0) CHECK(change.time - last >= cruise - 1);
+    previous = direction;
+    phase = next;
+    last = change.time;
+  }
+  CHECK(adjacent);
+  CHECK(turns == 1);
+}
+
+// An emergency stop ends stepping at once and is at rest, not running;
+// the latch clears with the next target
+TEST(emergencyStopIsAtRest) {
+  Rig rig;
+  StepperMotor& motor = rig.motors[0];
+  motor.setTargetPosition(3000);
+  rig.run(1000000);
+  motor.emergencyStop();
+  int64_t stoppedAt = hostMicros();
+  int stoppedPosition = motor.getCurrentPosition();
+  CHECK(stoppedPosition > 0 && stoppedPosition < 3000);
+  CHECK(motor.getState() == STATE_EMERGENCY_STOP);
+  CHECK(!motor.isRunning());
+  CHECK(motor.getTargetPosition() == stoppedPosition);
+  rig.run(500000);
+  
+  MoveRecord move = recordMove(0, 0, 1);
+  CHECK((int)move.times.size() == stoppedPosition);
+  CHECK(move.adjacent);
+  CHECK(move.released);
+  CHECK(move.times.back() <= stoppedAt);
+  CHECK(coilChanges(0).back().time == stoppedAt);
+  
+  motor.setTargetPosition(stoppedPosition);
+  CHECK(motor.getState() == STATE_STOPPED);
+  motor.setTargetPosition(stoppedPosition + 100);
+  CHECK(rig.settle());
+  CHECK(motor.getCurrentPosition() == stoppedPosition + 100);
+}
+
+// A leg that goes nowhere completes, after an emergency stop too
+TEST(zeroLengthLegCompletes) {
+  Rig rig;
+  StepperMotor& motor = rig.motors[0];
+  motor.setTargetPosition(400);
+  rig.run(300000);
+  motor.emergencyStop();
+  
+  MotionSequence sequence = {};
+  sequence.tag = 5;
+  sequence.count = 2;
+  sequence.legs[0] = { true, 0, 0, 0 };
+  sequence.legs[1] = { false, 50, 0, 0 };
+  SequenceRunner runner;
+  runner.start(sequence, motor);
+  SequenceEvent event;
+  std::vector<SequenceEvent> events;
+  for (int pass = 0; pass < 2000 && runner.isActive(); pass++) {
+    rig.run(MOTION_TASK_INTERVAL * 1000);
+    if (runner.poll(motor, millis(), event)) events.push_back(event);
+  }
+  CHECK(!runner.isActive());
+  CHECK(events.size() == 3);
+  CHECK(events.size() == 3 && events[0].type == SEQUENCE_LEG_DONE && events[0].leg == 0);
+  CHECK(events.size() == 3 && events[2].type == SEQUENCE_COMPLETE && events[2].position == 50);
+  CHECK(motor.getState() == STATE_STOPPED);
+}
+
+// A saved speed outside the limits is clamped at begin() as setSpeed()
+// would, and a move at it still finishes
+TEST(beginClampsSpeed) {
+  MotorConfig config = hostMotorConfig();
+  config.defaultSpeed = 0;
+  Rig slow(config);
+  CHECK(slow.motors[0].getSpeed() == MIN_SPEED);
+  slow.motors[0].setTargetPosition(100);
+  CHECK(slow.settle());
+  CHECK(slow.motors[0].getCurrentPosition() == 100);
+  
+  config.defaultSpeed = 50000;
+  Rig fast(config);
+  CHECK(fast.motors[0].getSpeed() == MAX_SPEED);
+}
+
+// The request this build exists for: a long move simulates in
+// milliseconds of real time
+TEST(longMoveIsFast) {
+  MotorConfig config = hostMotorConfig();
+  config.maxSteps = 40000;
+  Rig rig(config);
+  StepperMotor& motor = rig.motors[0];
+  motor.setSpeed(MAX_SPEED);
+  
+  auto begin = std::chrono::steady_clock::now();
+  motor.setTargetPosition(20000);
+  CHECK(rig.settle());
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+  
+  CHECK(motor.getCurrentPosition() == 20000);
+  MoveRecord move = recordMove(0, 0, 1);
+  CHECK(move.times.size() == 20000);
+  CHECK(move.adjacent);
+  printf("20000 steps: %.1f s simulated in %lld ms\n", (double)hostMicros() / 1e6, (long long)elapsed.count());
+  CHECK(elapsed.count() < 2000);
+}
+
+#if DRIVE_MODE == DRIVE_MICROSTEP
+// Every MICROSTEPS-th phase energises the coils the half-step table
+// does: one coil at full duty, or two at equal duty
+TEST(microstepMatchesHalfStep) {
+  Rig rig;
+  StepperMotor& motor = rig.motors[0];
+  motor.setTargetPosition(2 * SelectedDrive::PHASES);
+  CHECK(rig.settle());
+  
+  const uint32_t maxDuty = (1 << PWM_RESOLUTION) - 1;
+  const uint32_t diagonal = lroundf(maxDuty * sqrtf(0.5f));
+  int phase = 0;
+  int checked = 0;
+  uint32_t last[4] = {};
+  for (const HostLedcEvent& event : hostLedcLog()) {
+    const uint32_t* duty = &event.duty[PWM_CHANNEL_A];
+    if (memcmp(duty, last, sizeof(last)) == 0) continue;
+    memcpy(last, duty, sizeof(last));
+    if (duty[0] == 0 && duty[1] == 0 && duty[2] == 0 && duty[3] == 0) continue;
+    phase = (phase + 1) & (SelectedDrive::PHASES - 1);
+    if (phase % MICROSTEPS != 0) continue;
+    
+    const int* row = stepSequence[phase / MICROSTEPS];
+    int coils = row[0] + row[1] + row[2] + row[3];
+    for (int coil = 0; coil < 4; coil++) {
+      CHECK((duty[coil] != 0) == (row[coil] != 0));
+      if (row[coil]) CHECK(duty[coil] == (coils == 1 ? maxDuty : diagonal));
+    }
+    checked++;
+  }
+  CHECK(checked == 2 * 8);
+}
+#endif
+
+#if AXIS_COUNT > 1
+// Independent moves on two axes, each on its own schedule
+TEST(twoAxesIndependent) {
+  Rig rig;
+  rig.motors[0].setSpeed(500);
+  rig.motors[1].setSpeed(300);
+  rig.motors[0].setTargetPosition(1200);
+  rig.motors[1].setTargetPosition(-700);
+  CHECK(rig.settle());
+  CHECK(rig.motors[0].getCurrentPosition() == 1200);
+  CHECK(rig.motors[1].getCurrentPosition() == -700);
+  
+  MoveRecord first = recordMove(0, 0, 1);
+  MoveRecord second = recordMove(1, 0, -1);
+  CHECK(first.times.size() == 1200 && first.adjacent && first.released);
+  CHECK(second.times.size() == 700 && second.adjacent && second.released);
+  std::vector<int64_t> gaps = intervals(second.times);
+  CHECK(llabs(gaps[gaps.size() / 2] - 1000000 / (300 * STEPS_PER_HALF_STEP)) <= 1);
+}
+
+// A coordinated move keeps the follower on the line; both arrive together
+TEST(coordinatedArriveTogether) {
+  Rig rig;
+  StepperMotor& lead = rig.motors[0];
+  lead.addFollower(rig.motors[1], 500);
+  lead.setCoordinatedTarget(2000, lead.limits());
+  CHECK(rig.settle());
+  CHECK(lead.getCurrentPosition() == 2000);
+  CHECK(rig.motors[1].getCurrentPosition() == 500);
+  
+  MoveRecord leader = recordMove(0, 0, 1);
+  MoveRecord follower = recordMove(1, 0, 1);
+  CHECK(leader.adjacent && follower.adjacent);
+  CHECK(follower.times.size() == 500);
+  CHECK(follower.times.back() <= leader.times.back());
+  CHECK(leader.times.back() - follower.times.back() <= 4 * (leader.times.back() - leader.times[leader.times.size() - 2]));
+  // Each follower step lands on a leader step
+  size_t at = 0;
+  bool onLeader = true;
+  for (int64_t time : follower.times) {
+    while (at < leader.times.size() && leader.times[at] < time) at++;
+    onLeader &= at < leader.times.size() && leader.times[at] == time;
+  }
+  CHECK(onLeader);
+}
+#endif
+
+int main(int argc, char** argv) {
+  return hostRunTests(argc, argv);
+}
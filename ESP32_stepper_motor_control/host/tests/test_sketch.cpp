@@ -0,0 +1,169 @@
+/*
+ * Sketch tests - the whole firmware booted once on the simulator and
+ * driven through its REST and WebSocket handlers
+ */
+
+#include <Preferences.h>
+#include "HostTest.h"
+#include "HostSketch.h"
+
+// Coil changes of axis 0 that energised a coil, from index on in the pin log
+static size_t stepsSince(size_t index) {
+  const CoilPins& pins = axisPins[0];
+  const std::vector<HostPinEvent>& log = hostPinLog();
+  int last = index > 0 && index <= log.size() ? hostCoils(log[index - 1].pins, pins.a, pins.b, pins.c, pins.d) : 0;
+  size_t steps = 0;
+  for (size_t i = index; i < log.size(); i++) {
+    int coils = hostCoils(log[i].pins, pins.a, pins.b, pins.c, pins.d);
+    if (coils != last && coils != 0) steps++;
+    last = coils;
+  }
+  return steps;
+}
+
+static bool contains(const std::string& text, const char* part) {
+  return text.find(part) != std::string::npos;
+}
+
+TEST(bootStatus) {
+  HostResponse response = hostHttp("GET", "/api/status");
+  CHECK(response.code == 200);
+  CHECK(response.type == "application/json");
+  CHECK(contains(response.body, "\"position\":0"));
+  CHECK(contains(response.body, "\"running\":false"));
+  CHECK(hostHttp("GET", "/api/status?axis=9").code == 400);
+}
+
+// A REST move runs to completion with one coil change per step
+TEST(restMove) {
+  size_t logStart = hostPinLog().size();
+  HostResponse response = hostHttp("POST", "/api/position", "{\"position\":1500}");
+  CHECK(response.code == 200);
+  CHECK(hostSketchStatus(0).target == 1500);
+  hostSketchRun(200000);
+  CHECK(hostSketchStatus(0).running);
+  CHECK(hostSketchSettle());
+  MotorStatus status = hostSketchStatus(0);
+  CHECK(status.position == 1500);
+  CHECK(!status.running);
+  CHECK(stepsSince(logStart) == 1500);
+  CHECK(contains(hostHttp("GET", "/api/status").body, "\"position\":1500"));
+}
+
+TEST(rejectsBadRequests) {
+  HostResponse response = hostHttp("POST", "/api/position", "{\"position\":");
+  CHECK(response.code == 400);
+  CHECK(contains(response.body, "\"errorCode\":3"));
+  CHECK(hostHttp("POST", "/api/position", "{\"speed\":5}").code == 400);
+  CHECK(hostHttp("POST", "/api/position", "{\"position\":99999999}").code == 400);
+  response = hostHttp("POST", "/api/speed", "{\"speed\":0}");
+  CHECK(response.code == 400);
+  CHECK(contains(response.body, "\"errorCode\":2"));
+  CHECK(hostHttp("POST", "/api/speed", "{\"speed\":50000}").code == 400);
+  CHECK(hostHttp("GET", "/api/nothing").code == 404);
+}
+
+// WebSocket commands are acknowledged with their id, and status follows
+TEST(webSocketNudge) {
+  int before = hostSketchStatus(0).position;
+  hostWsConnect(0);
+  std::vector<HostWsMessage> hello = hostWsTake(0);
+  CHECK(hello.size() == 1 && contains(hello[0].data, "\"position\""));
+  
+  hostWsSend(0, "{\"cmd\":\"nudge\",\"steps\":-200,\"id\":7}");
+  std::vector<HostWsMessage> replies = hostWsTake(0);
+  CHECK(!replies.empty() && contains(replies.back().data, "\"type\":\"ack\""));
+  CHECK(!replies.empty() && contains(replies.back().data, "\"id\":7"));
+  CHECK(hostSketchSettle());
+  CHECK(hostSketchStatus(0).position == before - 200);
+  std::vector<HostWsMessage> updates = hostWsTake(0);
+  CHECK(updates.size() >= 2);
+  char final[32];
+  snprintf(final, sizeof(final), "\"position\":%d", before - 200);
+  CHECK(!updates.empty() && contains(updates.back().data, final));
+  hostWsDisconnect(0);
+}
+
+// The logger records the moves above; the API pages through it
+TEST(logsDuringMoves) {
+  hostHttp("POST", "/api/position", "{\"position\":0}");
+  CHECK(hostSketchSettle());
+  HostResponse response = hostHttp("GET", "/api/logs?limit=5");
+  CHECK(response.code == 200);
+  CHECK(contains(response.body, "{\"entries\":[{"));
+  CHECK(contains(response.body, "\"more\":"));
+}
+
+// A backlash update that does not all fit in the motion queue changes
+// nothing
+TEST(backlashAllOrNothing) {
+  const char* update = "{\"mode\":\"slack\",\"steps\":40,\"direction\":-1}";
+  std::string before = hostHttp("GET", "/api/settings/backlash").body;
+  CHECK(!contains(before, "\"slack\""));
+  
+  hostSketchHoldMotion(true);
+  char speed[32];
+  snprintf(speed, sizeof(speed), "{\"speed\":%d}", hostSketchStatus(0).speed);
+  for (int i = 0; i < COMMAND_QUEUE_SIZE - 2; i++) CHECK(hostHttp("POST", "/api/speed", speed).code == 200);
+  CHECK(hostHttp("POST", "/api/settings/backlash", update).code == 503);
+  hostSketchHoldMotion(false);
+  hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+  CHECK(hostHttp("GET", "/api/settings/backlash").body == before);
+  
+  CHECK(hostHttp("POST", "/api/settings/backlash", update).code == 200);
+  hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+  CHECK(hostHttp("GET", "/api/settings/backlash").body == "{\"mode\":\"slack\",\"steps\":40,\"direction\":-1}");
+  CHECK(hostHttp("POST", "/api/settings/backlash", "{\"mode\":\"off\",\"steps\":0,\"direction\":1}").code == 200);
+  CHECK(hostSketchSettle());
+}
+
+// Handlers check limits against the published maxSteps, so a new limit
+// applies once the motion task has taken it
+TEST(limitsFollowSnapshot) {
+  CHECK(hostHttp("POST", "/api/position", "{\"position\":0}").code == 200);
+  CHECK(hostSketchSettle());
+  int maxSteps = hostSketchStatus(0).maxSteps;
+  CHECK(hostHttp("POST", "/api/settings/max", "{\"maxSteps\":1000}").code == 200);
+  hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+  CHECK(hostSketchStatus(0).maxSteps == 1000);
+  CHECK(hostHttp("POST", "/api/position", "{\"position\":1200}").code == 400);
+  CHECK(hostHttp("POST", "/api/nudge", "{\"steps\":-1200}").code == 400);
+  CHECK(hostHttp("POST", "/api/settings/backlash", "{\"steps\":1001}").code == 400);
+  
+  char restore[40];
+  snprintf(restore, sizeof(restore), "{\"maxSteps\":%d}", maxSteps);
+  CHECK(hostHttp("POST", "/api/settings/max", restore).code == 200);
+  hostSketchRun(MOTION_TASK_INTERVAL * 1000);
+  CHECK(hostHttp("POST", "/api/position", "{\"position\":1200}").code == 200);
+  CHECK(hostHttp("POST", "/api/position", "{\"position\":0}").code == 200);
+  CHECK(hostSketchSettle());
+}
+
+// Settings changed mid-move reach NVS only once the motor has stopped
+TEST(settingsWrittenAtRest) {
+  Preferences::writes() = 0;
+  CHECK(hostHttp("POST", "/api/position", "{\"position\":800}").code == 200);
+  hostSketchRun(100000);
+  CHECK(hostSketchStatus(0).running);
+  CHECK(hostHttp("POST", "/api/speed", "{\"speed\":333}").code == 200);
+  CHECK(!hostSketchFlushIfQuiet());
+  hostSketchRun(100000);
+  CHECK(!hostSketchFlushIfQuiet());
+  CHECK(Preferences::writes() == 0);
+  CHECK(hostSketchSettle());
+  CHECK(hostSketchFlushIfQuiet());
+  CHECK(Preferences::writes() == 1);
+  hostHttp("POST", "/api/position", "{\"position\":0}");
+  CHECK(hostSketchSettle());
+}
+
+TEST(metricsCountDroppedEvents) {
+  HostResponse response = hostHttp("GET", "/api/metrics");
+  CHECK(response.code == 200);
+  CHECK(contains(response.body, "focuser_sequence_events_dropped_total 0\n"));
+}
+
+int main(int argc, char** argv) {
+  hostSketchBegin();
+  return hostRunTests(argc, argv, false);
+}
@@ -0,0 +1,112 @@
+/*
+ * Stream tests - StepStream's coil encoders playing through the RMT
+ * shim, with STEP_STREAM set
+ */
+
+#include "HostTest.h"
+#include "StepperMotor.h"
+
+static_assert(STEP_STREAM, "Build the stream tests with STEP_STREAM=1");
+
+// The halves played on a coil pin, in order
+static std::vector<uint32_t> halvesOf(int gpio) {
+  std::vector<uint32_t> halves;
+  for (uint32_t symbol : hostRmtSymbols(gpio)) {
+    halves.push_back(symbol & 0xFFFF);
+    halves.push_back(symbol >> 16);
+  }
+  return halves;
+}
+
+static uint32_t totalTicks(const std::vector<uint32_t>& halves) {
+  uint32_t ticks = 0;
+  for (uint32_t half : halves) ticks += half & 0x7FFF;
+  return ticks;
+}
+
+// ----------------------------------------------------------------
+// Tests
+// ----------------------------------------------------------------
+
+// A move played from the stream lands on its target with one coil
+// change per step and no early end
+TEST(streamedMove) {
+  StepScheduler scheduler;
+  StepStream stream;
+  StepperMotor motor;
+  motor.begin(hostMotorConfig(DEFAULT_MAX_STEPS, MAX_SPEED), axisPins[0], 0, scheduler);
+  scheduler.begin();
+  CHECK(stream.begin(axisPins[0], SelectedDrive::SEQUENCE));
+  motor.setStream(&stream);
+  
+  motor.setTargetPosition(3000);
+  int64_t end = hostMicros() + 60000000;
+  while (hostMicros() < end && (motor.isRunning() || stream.isActive())) {
+    hostAdvance(MOTION_TASK_INTERVAL * 1000);
+    motor.update();
+  }
+  CHECK(motor.getCurrentPosition() == 3000);
+  CHECK(!stream.isActive());
+  
+  const CoilPins& pins = axisPins[0];
+  int last = 0;
+  int steps = 0;
+  for (const HostPinEvent& event : hostPinLog()) {
+    int coils = hostCoils(event.pins, pins.a, pins.b, pins.c, pins.d);
+    if (coils != last && coils != 0) steps++;
+    last = coils;
+  }
+  CHECK(steps == 3000);
+  CHECK(hostRmtStats().zeroHalves == 0);
+  CHECK(hostRmtStats().underflows == 0);
+}
+
+// An odd last half of one tick cannot split; a 1-tick low half pads it
+// instead of a zero-length one that would end the transmission there
+TEST(oneTickLastHalf) {
+  StepStream stream;
+  CHECK(stream.begin(axisPins[0], SelectedDrive::SEQUENCE));
+  hostClearRmtSymbols();           // The release begin() played
+  stream.start(0, 0, 0);
+  stream.step(0, 1, 1, 0);
+  stream.step(STREAM_MAX_HALF * 2, 2, 2, 0);
+  stream.finish(STREAM_MAX_HALF * 2 + 1);
+  for (int i = 0; i < 100 && stream.isActive(); i++) {
+    hostAdvance(MOTION_TASK_INTERVAL * 1000);
+    stream.service();
+  }
+  CHECK(!stream.isActive());
+  CHECK(hostRmtStats().zeroHalves == 0);
+  
+  // Coil B is on in phase 2
+  std::vector<uint32_t> halves = halvesOf(axisPins[0].b);
+  CHECK(SelectedDrive::SEQUENCE[2][1] == 1);
+  CHECK(halves.size() == 4);
+  CHECK(totalTicks(halves) == STREAM_MAX_HALF * 2 + 2);
+  CHECK(halves.size() == 4 && halves[2] == (1 | 0x8000));
+  CHECK(halves.size() == 4 && halves[3] == 1);
+}
+
+// An odd last half of more than one tick splits in two
+TEST(oddLastHalfSplits) {
+  StepStream stream;
+  CHECK(stream.begin(axisPins[0], SelectedDrive::SEQUENCE));
+  hostClearRmtSymbols();           // The release begin() played
+  stream.start(0, 0, 0);
+  stream.step(0, 1, 1, 0);
+  stream.step(STREAM_MAX_HALF * 2, 2, 2, 0);
+  stream.finish(STREAM_MAX_HALF * 2 + 7);
+  for (int i = 0; i < 100 && stream.isActive(); i++) {
+    hostAdvance(MOTION_TASK_INTERVAL * 1000);
+    stream.service();
+  }
+  CHECK(hostRmtStats().zeroHalves == 0);
+  std::vector<uint32_t> halves = halvesOf(axisPins[0].a);
+  CHECK(halves.size() == 4);
+  CHECK(totalTicks(halves) == STREAM_MAX_HALF * 2 + 7);
+  CHECK(halves.size() == 4 && (halves[2] & 0x7FFF) == 4 && (halves[3] & 0x7FFF) == 3);
+}
+
+int main(int argc, char** argv) {
+  return hostRunTests(argc, argv);
+}
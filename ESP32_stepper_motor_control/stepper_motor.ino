@@ -13,6 +13,7 @@
  * - GPIO2 -> ULN2003 IN2
  * - GPIO3 -> ULN2003 IN3
  * - GPIO4 -> ULN2003 IN4
+ * Further axes (AXIS_COUNT in Config.h) use the pins in axisPins.
  */
 
 #include <WiFi.h>
@@ -25,8 +26,24 @@
 #include <esp_task_wdt.h>
 #include "Config.h"
 #include "StepperMotor.h"
+#include "StepScheduler.h"
+#if STEP_STREAM
+#include "StepStream.h"
+#endif
+#include "MotionControl.h"
+#include "MotionSequence.h"
+#include "Autofocus.h"
+#include "StepTrace.h"
+#include "CommandRecorder.h"
+#include "Metrics.h"
+#include "Profiler.h"
+#include "PositionJournal.h"
+#include "ConfigStore.h"
+#include "StatusPublisher.h"
+#include "StatusEncoder.h"
 #include "Logger.h"
-#include "web_interface.h"
+#include "ChunkedResponse.h"
+#include "web_interface_gz.h"       // Generated from web_interface.h
 
 // ----------------------------------------------------------------
 // Global Objects
@@ -34,16 +51,40 @@
 WebServer server(80);
 WebSocketsServer webSocket(81);
 Preferences preferences;
-StepperMotor motor;
+StepperMotor motors[AXIS_COUNT];
+StepScheduler stepScheduler;
+#if STEP_STREAM
+StepStream stepStream;
+#endif
 Logger logger;
 WiFiManager wifiManager;
+CommandQueue commandQueue;
+StatusSnapshot statusSnapshots[AXIS_COUNT];
+StatusPublisher statusPublisher;
+StatusEncoder statusEncoders[AXIS_COUNT];
+StatusFrameEncoder statusFrameEncoder;
+SequenceSlot sequenceSlot;
+SequenceRunner sequenceRunners[AXIS_COUNT];
+MoveSlot moveSlot;
+SequenceEventQueue sequenceEvents;
+AutofocusEngine autofocus;
+StepTrace stepTrace;
+CommandRecorder commandRecorder;
+Metrics metrics;
+#if ENABLE_PROFILER
+LoopProfiler profiler;
+#endif
+PositionJournal positionJournal;
+ConfigStore configStore;
+TaskHandle_t motionTaskHandle = nullptr;
+TaskHandle_t networkTaskHandle = nullptr;
 
 // ----------------------------------------------------------------
 // Global State
 // ----------------------------------------------------------------
 bool wifiConnected = false;
-unsigned long lastPositionSave = 0;
-unsigned long lastStatusUpdate = 0;
+int lastSavedPosition[AXIS_COUNT];
+int lastSavedPhase[AXIS_COUNT];
 unsigned long lastWiFiCheck = 0;
 unsigned long lastLogEntry = 0;
 
@@ -53,8 +94,26 @@ unsigned long lastLogEntry = 0;
 void setupWiFi();
 void setupWebServer();
 void setupWebSocket();
+void motionTask(void* param);
+void beginMotion();
+void motionPass();
+void networkTask(void* param);
+void serviceNetwork();
+void applyMotionCommand(const MotionCommand& cmd);
+void startCoordinatedMove(const CoordinatedMove& move);
+void publishMotorStatus();
+bool motorsAtRest();
+void cancelSequence(int axis);
+void postSequenceEvent(const SequenceEvent& event);
+bool sendMotionCommand(MotionCommandType type, int value = 0, int axis = 0);
 void handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
 void broadcastStatus();
+void sendStatus(uint8_t num, const MotorStatus& status, unsigned long now);
+void broadcastSequenceEvents();
+void serviceAutofocus(unsigned long now);
+void broadcastAutofocusEvent(const AutofocusEvent& event);
+void cancelAutofocus(int axis);
+void addApiRoute(const char* uri, HTTPMethod method, void (*handler)());
 void handleRoot();
 void handleGetStatus();
 void handleSetPosition();
@@ -65,12 +124,52 @@ void handleReboot();
 void handleSetMaxSteps();
 void handleSetStepsPerRotation();
 void handleEmergencyStop();
+void handleMove();
 void handleSetProfile();
 void handleGetLogs();
-String createStatusJSON();
+void handleRunSequence();
+void handleSetBacklash();
+void handleGetBacklash();
+void handleAutofocus();
+void handleAutofocusMetric();
+void handleAutofocusCancel();
+void handleSetTrace();
+void handleGetTrace();
+void handleSetRecord();
+void handleGetRecord();
+void handleGetMetrics();
+void handleGetProfile();
+void handleGetBench();
+const char* createStatusJSON(const MotorStatus& status);
 ErrorCode parseJSONRequest(const String& body, JsonDocument& doc);
+ErrorCode parseOptionalJSONRequest(const String& body, JsonDocument& doc);
+bool readAxis(JsonVariantConst args, int& axis, int fallback = 0);
+bool readAxisArg(int& axis);
+const char* positionKey(int axis, char* buffer);
 void sendJSONResponse(int code, const char* status, const char* message = nullptr, ErrorCode error = ERROR_NONE);
+void sendCommandResult(const CommandResult& result);
+void sendWebSocketAck(uint8_t num, JsonVariantConst id, const CommandResult& result);
+CommandResult runSetPosition(JsonVariantConst args);
+CommandResult runSetSpeed(JsonVariantConst args);
+CommandResult runNudge(JsonVariantConst args);
+CommandResult runZero(JsonVariantConst args);
+CommandResult runEmergencyStop(JsonVariantConst args);
+CommandResult runMove(JsonVariantConst args);
+CommandResult runSetMaxSteps(JsonVariantConst args);
+CommandResult runSetStepsPerRotation(JsonVariantConst args);
+CommandResult runSequence(JsonVariantConst args);
+CommandResult runSetBacklash(JsonVariantConst args);
+CommandResult runAutofocus(JsonVariantConst args);
+CommandResult runAutofocusMetric(JsonVariantConst args);
+CommandResult runAutofocusCancel();
+CommandResult runSetTrace(JsonVariantConst args);
+CommandResult runSetRecord(JsonVariantConst args);
+CommandResult runSetStatusRate(uint8_t num, JsonVariantConst args);
+CommandResult runSetStatusFormat(uint8_t num, JsonVariantConst args);
+CommandResult runSetStatusAxes(uint8_t num, JsonVariantConst args);
+CommandResult runWebSocketCommand(uint8_t num, const char* cmd, JsonVariantConst args);
 void checkAndReconnectWiFi();
+void restorePosition(int axis, bool journalFound);
 bool validateAndSavePosition();
 
 // ----------------------------------------------------------------
@@ -86,33 +185,29 @@ void setup() {
 
   // Note: Watchdog will be configured AFTER WiFi setup to avoid timeout during WiFiManager
   
-  // Initialize preferences
+  // Initialize preferences (the position fallback lives here; motor
+  // settings are in the config store)
   preferences.begin("stepper", false);
+  configStore.begin(motorsAtRest);
   
-  // Load motor configuration
-  MotorConfig motorConfig;
-  motorConfig.maxSteps = preferences.getInt("maxSteps", DEFAULT_MAX_STEPS);
-  motorConfig.stepsPerRotation = preferences.getInt("stepsPerRot", DEFAULT_STEPS_PER_ROTATION);
-  motorConfig.defaultSpeed = preferences.getInt("speed", DEFAULT_SPEED);
-  motorConfig.minSpeed = MIN_SPEED;
-  motorConfig.maxSpeed = MAX_SPEED;
-  motorConfig.softLimitWarning = SOFT_LIMIT_WARNING;
-  
-  // Initialize motor
-  motor.begin(motorConfig);
-  
-  // Load and validate saved position
-  int savedPosition = preferences.getInt("position", 0);
-  ErrorCode posError = motor.validatePosition(savedPosition);
+  // Initialize the motors, each with its own configuration and pins
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    motors[axis].begin(configStore.get(axis), axisPins[axis], axis, stepScheduler);
+    motors[axis].setLatenessHistogram(&metrics.stepLateness);
+  }
+  motors[0].setTrace(&stepTrace);
   
-  if (posError == ERROR_NONE || posError == ERROR_SOFT_LIMIT_WARNING) {
-    motor.setCurrentPosition(savedPosition);
-    Serial.println("✓ Position restored: " + String(savedPosition));
-  } else {
-    Serial.println("✗ Saved position corrupted, resetting to 0");
-    motor.setCurrentPosition(0);
-    logger.log(0, 0, 0, STATE_IDLE, ERROR_POSITION_CORRUPTED);
+  // Load and validate saved positions: newest journal record, or the
+  // NVS key older firmware wrote
+  bool journalFound = positionJournal.begin();
+  if (!positionJournal.isReady()) {
+    Serial.println("✗ No position journal partition, saving to NVS");
   }
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    restorePosition(axis, journalFound);
+  }
+  publishMotorStatus();
+  validateAndSavePosition();       // Positions rescaled from another drive mode
   
   // Setup WiFi with WiFiManager
   setupWiFi();
@@ -125,6 +220,9 @@ void setup() {
 
   // Initialize ElegantOTA
   ElegantOTA.begin(&server);
+  ElegantOTA.onEnd([](bool success) {
+    configStore.flush();           // Device restarts straight after an update
+  });
   Serial.println("✓ ElegantOTA initialized");
   
   // Start web server
@@ -147,56 +245,379 @@ void setup() {
     .trigger_panic = true
   };
   esp_task_wdt_init(&wdt_config);
-  esp_task_wdt_add(NULL);
   Serial.println("✓ Watchdog timer configured");
+  
+  // Motion control on core 1, web serving on core 0 (each task
+  // subscribes itself to the watchdog)
+  xTaskCreatePinnedToCore(motionTask, "motion", MOTION_TASK_STACK, nullptr,
+                          MOTION_TASK_PRIORITY, &motionTaskHandle, MOTION_TASK_CORE);
+  xTaskCreatePinnedToCore(networkTask, "network", NETWORK_TASK_STACK, nullptr,
+                          NETWORK_TASK_PRIORITY, &networkTaskHandle, NETWORK_TASK_CORE);
+  Serial.println("✓ Motion and network tasks started");
+}
+
+// Restore one axis's position and coil phase from before the reboot
+void restorePosition(int axis, bool journalFound) {
+  StepperMotor& motor = motors[axis];
+  int savedPosition = 0;
+  int savedPhase = 0;
+  bool fromJournal = journalFound && positionJournal.saved(axis, savedPosition, savedPhase);
+  if (!fromJournal) {
+    char key[16];
+    savedPosition = preferences.getInt(positionKey(axis, key), 0);
+  }
+  if (configStore.unitsChanged(axis)) {
+    // Saved under another drive mode
+    savedPosition = configStore.toCurrentUnits(axis, savedPosition);
+    savedPhase = configStore.toCurrentPhase(axis, savedPhase);
+  }
+  ErrorCode posError = motor.validatePosition(savedPosition);
+  
+  if (posError == ERROR_NONE || posError == ERROR_SOFT_LIMIT_WARNING) {
+    if (fromJournal) {
+      motor.restorePosition(savedPosition, savedPhase);
+    } else {
+      motor.setCurrentPosition(savedPosition);
+    }
+    Serial.printf("✓ Axis %d position restored: %d\n", axis, savedPosition);
+  } else {
+    Serial.printf("✗ Axis %d saved position corrupted, resetting to 0\n", axis);
+    motor.setCurrentPosition(0);
+    logger.log(0, 0, 0, STATE_IDLE, ERROR_POSITION_CORRUPTED);
+  }
+  lastSavedPosition[axis] = motor.getCurrentPosition();
+  // Journal it once if it came from NVS or another drive mode (the
+  // settings were already rescaled)
+  bool journalled = fromJournal && !configStore.unitsChanged(axis);
+  lastSavedPhase[axis] = journalled ? motor.getPhase() : -1;
 }
 
 // ----------------------------------------------------------------
 // Main Loop
+// All work runs in the motion and network tasks
 // ----------------------------------------------------------------
 void loop() {
-  // Reset watchdog
-  esp_task_wdt_reset();
+  vTaskDelete(NULL);
+}
+
+// ----------------------------------------------------------------
+// Motion Task - owns the motor; pinned to MOTION_TASK_CORE
+// ----------------------------------------------------------------
+void motionTask(void* param) {
+  esp_task_wdt_add(NULL);
+  beginMotion();
   
-  // Handle clients
-  server.handleClient();
-  webSocket.loop();
-  ElegantOTA.loop();
+  for (;;) {
+    esp_task_wdt_reset();
+    motionPass();
+    
+    // Woken early by sendMotionCommand()
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MOTION_TASK_INTERVAL));
+  }
+}
+
+// Start-up on the motion task's core
+void beginMotion() {
+  // Step interrupt is allocated on this core
+  stepScheduler.begin();
+#if STEP_STREAM
+  // So are the RMT refill interrupts. Without the RMT, axis 0 steps from
+  // the interrupt as usual.
+  if (stepStream.begin(axisPins[0], SelectedDrive::SEQUENCE)) {
+    motors[0].setLatenessHistogram(nullptr);   // Streamed steps are never late
+    motors[0].setStream(&stepStream);
+    Serial.println("✓ Axis 0 steps streamed through the RMT");
+  } else {
+    Serial.println("✗ RMT step stream unavailable, using the step interrupt");
+  }
+#endif
+}
   
-  // Update motor
-  motor.update();
+// One pass: commands, sequences, motors, then the published status
+void motionPass() {
+  uint32_t passStart = micros();
+  MotionCommand cmd;
+  SequenceEvent event;
+    
+  while (commandQueue.pop(cmd)) {
+    applyMotionCommand(cmd);
+  }
   
-  // Periodic tasks
-  unsigned long now = millis();
+  // A runner only advances while its event has room, so a backed-up
+  // queue delays a sequence instead of losing its progress
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    if (sequenceEvents.hasRoom() && sequenceRunners[axis].poll(motors[axis], millis(), event)) {
+      postSequenceEvent(event);
+    }
+  }
+    
+  PROFILE(PROFILE_MOTOR_UPDATE, {
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      motors[axis].update();
+    }
+  });
+  stepTrace.service();
+  publishMotorStatus();
+  metrics.motionPass.observe(micros() - passStart);
+}
+
+void applyMotionCommand(const MotionCommand& cmd) {
+  if (cmd.axis == ALL_AXES) {
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      MotionCommand each = cmd;
+      each.axis = axis;
+      applyMotionCommand(each);
+    }
+    return;
+  }
+  if (cmd.axis < 0 || cmd.axis >= AXIS_COUNT) return;
+  
+  StepperMotor& motor = motors[cmd.axis];
+  switch (cmd.type) {
+    case CMD_SET_TARGET:
+      cancelSequence(cmd.axis);
+      motor.setTargetPosition(cmd.value);
+      break;
+    case CMD_NUDGE:
+      cancelSequence(cmd.axis);
+      motor.setTargetPosition(motor.getCurrentPosition() + cmd.value);
+      break;
+    case CMD_SET_SPEED:
+      motor.setSpeed(cmd.value);
+      sequenceRunners[cmd.axis].setBaseSpeed(motor.getSpeed());
+      break;
+    case CMD_SET_POSITION:
+      cancelSequence(cmd.axis);
+      motor.setCurrentPosition(cmd.value);
+      break;
+    case CMD_EMERGENCY_STOP:
+      motor.emergencyStop();
+      cancelSequence(cmd.axis);
+      break;
+    case CMD_SET_MAX_STEPS:
+      motor.setMaxSteps(cmd.value);
+      break;
+    case CMD_SET_STEPS_PER_ROT:
+      motor.setStepsPerRotation(cmd.value);
+      break;
+    case CMD_SET_BACKLASH_MODE:
+      motor.setBacklashMode((BacklashMode)cmd.value);
+      break;
+    case CMD_SET_BACKLASH_STEPS:
+      motor.setBacklashSteps(cmd.value);
+      break;
+    case CMD_SET_BACKLASH_DIRECTION:
+      motor.setBacklashDirection(cmd.value);
+      break;
+    case CMD_RUN_SEQUENCE: {
+      MotionSequence sequence;
+      if (sequenceSlot.take(sequence)) {
+        cancelSequence(sequence.axis);
+        sequenceRunners[sequence.axis].start(sequence, motors[sequence.axis]);
+      }
+      break;
+    }
+    case CMD_SET_TRACE:
+      if (cmd.value == 0) {
+        stepTrace.stop();
+        break;
+      }
+      // The trace follows one axis at a time
+      for (int axis = 0; axis < AXIS_COUNT; axis++) {
+        motors[axis].setTrace(axis == cmd.axis ? &stepTrace : nullptr);
+      }
+      if (!stepTrace.start()) {
+        Serial.println("ERROR: Step trace could not start");
+      }
+      break;
+    case CMD_MOVE_COORDINATED: {
+      CoordinatedMove move;
+      if (moveSlot.take(move)) {
+        startCoordinatedMove(move);
+      }
+      break;
+    }
+  }
+}
+
+// Coordinated move: the axis with the longest travel leads and the
+// others step in proportion to it, so they track a straight line and
+// arrive together. The leader's speed, acceleration and jerk are the
+// tightest of every axis's limits scaled to its share of the move. Axes
+// that are still moving cannot be coordinated; then each one just goes
+// to its target on its own.
+void startCoordinatedMove(const CoordinatedMove& move) {
+  int targets[AXIS_COUNT];
+  float distances[AXIS_COUNT];
+  int lead = -1;
+  bool moving = false;
+  
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    distances[axis] = 0.0f;
+    if (!(move.mask & (1 << axis))) continue;
+    
+    StepperMotor& motor = motors[axis];
+    cancelSequence(axis);
+    int from = motor.getCurrentPosition();
+    targets[axis] = motor.constrainPosition(move.relative[axis] ? from + move.targets[axis]
+                                                                : move.targets[axis]);
+    distances[axis] = (float)abs(targets[axis] - from);
+    moving = moving || motor.getState() == STATE_RUNNING;
+    if (lead < 0 || distances[axis] > distances[lead]) lead = axis;
+  }
+  if (lead < 0) return;
+  
+  if (moving || distances[lead] == 0.0f) {
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      if (move.mask & (1 << axis)) motors[axis].setTargetPosition(targets[axis]);
+    }
+    return;
+  }
   
-  // Save position periodically
-  if (now - lastPositionSave > POSITION_SAVE_INTERVAL) {
-    lastPositionSave = now;
-    if (validateAndSavePosition()) {
-      // Position saved successfully
+  // Limits per step of travel, so kSpeed * distance is an axis's speed
+  float kSpeed = INFINITY;
+  float kAccel = INFINITY;
+  float kJerk = INFINITY;
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    if (distances[axis] == 0.0f) continue;
+    MoveLimits own = motors[axis].limits();
+    kSpeed = min(kSpeed, own.speed / distances[axis]);
+    kAccel = min(kAccel, own.accel / distances[axis]);
+    kJerk = min(kJerk, own.jerk / distances[axis]);   // Any trapezoid axis makes all trapezoids
+  }
+  
+  // Slow the whole move until no axis cruises in a resonance band
+  for (int pass = 0; pass < AXIS_COUNT; pass++) {
+    for (int axis = 0; axis < AXIS_COUNT; axis++) {
+      if (distances[axis] > 0.0f) {
+        kSpeed = min(kSpeed, StepperMotor::avoidResonance(kSpeed * distances[axis]) / distances[axis]);
+      }
+    }
+  }
+  
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    if (axis != lead && distances[axis] > 0.0f) {
+      motors[lead].addFollower(motors[axis], targets[axis]);
+    }
+  }
+  float distance = distances[lead];
+  MoveLimits limits = { kSpeed * distance, kAccel * distance, kJerk * distance };
+  motors[lead].setCoordinatedTarget(targets[lead], limits);
+}
+
+// Every axis's published status at rest; the config store only writes
+// NVS then
+bool motorsAtRest() {
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    MotorStatus status = statusSnapshots[axis].read();
+    if (status.running || status.position != status.target) return false;
+  }
+  return true;
+}
+
+// Manual moves, zeroing and emergency stop abandon a running sequence
+void cancelSequence(int axis) {
+  if (axis == ALL_AXES) {
+    for (int each = 0; each < AXIS_COUNT; each++) {
+      cancelSequence(each);
     }
+    return;
+  }
+  
+  SequenceEvent event;
+  if (sequenceRunners[axis].cancel(motors[axis], event)) {
+    postSequenceEvent(event);
+  }
+}
+
+// Motion task only. A cancellation cannot wait for room; one that does
+// not fit is counted in /api/metrics.
+void postSequenceEvent(const SequenceEvent& event) {
+  if (!sequenceEvents.push(event)) {
+    metrics.sequenceEventsDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void publishMotorStatus() {
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    const StepperMotor& motor = motors[axis];
+    MotorStatus status;
+    status.position = motor.getCurrentPosition();
+    status.target = motor.getTargetPosition();
+    status.speed = motor.getSpeed();
+    status.state = motor.getState();
+    status.running = motor.isRunning();
+    status.maxSteps = motor.getMaxSteps();
+    status.stepsPerRotation = motor.getStepsPerRotation();
+    status.nearLimit = motor.isNearSoftLimit();
+    status.phase = motor.getPhase();
+    status.axis = axis;
+    statusSnapshots[axis].publish(status);
+  }
+}
+
+// Queue a command for the motion task - never blocks
+bool sendMotionCommand(MotionCommandType type, int value, int axis) {
+  MotionCommand cmd = { type, value, axis };
+  if (!commandQueue.push(cmd)) {
+    return false;
+  }
+  if (motionTaskHandle != nullptr) {
+    xTaskNotifyGive(motionTaskHandle);
   }
+  return true;
+}
+
+// ----------------------------------------------------------------
+// Network Task - web, WebSocket, OTA and persistence; pinned to
+// NETWORK_TASK_CORE
+// ----------------------------------------------------------------
+void networkTask(void* param) {
+  esp_task_wdt_add(NULL);
   
-  // Broadcast status via WebSocket
-  if (now - lastStatusUpdate > STATUS_UPDATE_INTERVAL) {
-    lastStatusUpdate = now;
-    broadcastStatus();
+  for (;;) {
+    esp_task_wdt_reset();
+    uint32_t passStart = micros();
+    PROFILE(PROFILE_NETWORK_PASS, serviceNetwork());
+    metrics.networkPass.observe(micros() - passStart);
+    vTaskDelay(1);
   }
+}
+
+void serviceNetwork() {
+  // Handle clients
+  PROFILE(PROFILE_HANDLE_CLIENT, server.handleClient());
+  PROFILE(PROFILE_WEBSOCKET, webSocket.loop());
+  PROFILE(PROFILE_OTA, ElegantOTA.loop());
+  
+  // Periodic tasks
+  unsigned long now = millis();
+  
+  // Save position once the motor settles somewhere new
+  PROFILE(PROFILE_SAVE_POSITION, validateAndSavePosition());
+  
+  // Push status to WebSocket clients that are due an update
+  PROFILE(PROFILE_BROADCAST, broadcastStatus());
+  PROFILE(PROFILE_EVENTS, {
+    broadcastSequenceEvents();
+    serviceAutofocus(now);
+  });
   
   // Log state periodically (every second)
   if (now - lastLogEntry > 1000) {
     lastLogEntry = now;
-    if (motor.isRunning() || motor.isNearSoftLimit()) {
-      ErrorCode error = motor.isNearSoftLimit() ? ERROR_SOFT_LIMIT_WARNING : ERROR_NONE;
-      logger.log(motor.getCurrentPosition(), motor.getTargetPosition(), 
-                 motor.getSpeed(), motor.getState(), error);
+    MotorStatus status = statusSnapshots[0].read();
+    if (status.running || status.nearLimit) {
+      ErrorCode error = status.nearLimit ? ERROR_SOFT_LIMIT_WARNING : ERROR_NONE;
+      logger.log(status.position, status.target, 
+                 status.speed, status.state, error);
     }
   }
   
   // Check WiFi connection
   if (now - lastWiFiCheck > WIFI_CHECK_INTERVAL) {
     lastWiFiCheck = now;
-    checkAndReconnectWiFi();
+    PROFILE(PROFILE_WIFI_CHECK, checkAndReconnectWiFi());
   }
 }
 
@@ -261,32 +682,49 @@ void handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t l
   switch (type) {
     case WStype_DISCONNECTED:
       Serial.printf("WebSocket [%u] Disconnected\n", num);
+      statusPublisher.disconnect(num);
       break;
       
     case WStype_CONNECTED: {
       IPAddress ip = webSocket.remoteIP(num);
       Serial.printf("WebSocket [%u] Connected from %s\n", num, ip.toString().c_str());
-      // Send initial status
-      String statusJSON = createStatusJSON();
-      webSocket.sendTXT(num, statusJSON);
+      // Send initial status (axis 0 until the client asks for others)
+      MotorStatus status = statusSnapshots[0].read();
+      webSocket.sendTXT(num, createStatusJSON(status));
+      statusPublisher.connect(num);
+      statusPublisher.markSent(num, status, millis());
       break;
     }
     
     case WStype_TEXT: {
-      // Handle incoming WebSocket commands
-      StaticJsonDocument<200> doc;
+      commandRecorder.record(COMMAND_SOURCE_WEBSOCKET, num, nullptr, (const char*)payload, length);
+      
+      // Handle incoming WebSocket commands: {"cmd": ..., "id": ..., args}
+      StaticJsonDocument<SEQUENCE_JSON_SIZE> doc;
       DeserializationError error = deserializeJson(doc, payload, length);
       
       if (error) {
         Serial.println("WebSocket JSON parse error");
+        sendWebSocketAck(num, JsonVariantConst(), { 400, "error", "Invalid JSON", ERROR_INVALID_JSON });
         return;
       }
       
       const char* cmd = doc["cmd"];
-      if (cmd) {
-        Serial.printf("WebSocket command: %s\n", cmd);
-        // Commands can be added here if needed
+      JsonVariantConst id = doc["id"];
+      if (!cmd) {
+        sendWebSocketAck(num, id, { 400, "error", "Missing cmd", ERROR_NONE });
+        return;
       }
+      
+      CommandResult result = runWebSocketCommand(num, cmd, doc.as<JsonVariantConst>());
+      if (strcmp(cmd, "status") == 0) {
+        for (int axis = 0; axis < AXIS_COUNT; axis++) {
+          if (statusPublisher.follows(num, axis)) {
+            sendStatus(num, statusSnapshots[axis].read(), millis());
+          }
+        }
+      }
+      sendWebSocketAck(num, id, result);
       break;
     }
     
@@ -296,37 +734,117 @@ void handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t l
 }
 
 // ----------------------------------------------------------------
-// Broadcast Status to All WebSocket Clients
+// Send Status to WebSocket Clients that are Due an Update
 // ----------------------------------------------------------------
 void broadcastStatus() {
-  String status = createStatusJSON();
-  webSocket.broadcastTXT(status);
+  unsigned long now = millis();
+  
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    MotorStatus status = statusSnapshots[axis].read();
+    for (uint8_t num = 0; num < STATUS_MAX_CLIENTS; num++) {
+      if (statusPublisher.isDue(num, status, now)) {
+        sendStatus(num, status, now);
+      }
+    }
+  }
+}
+
+// Send one client its status in the format it asked for. The JSON
+// encoder caches its output, so an unchanged status is serialized once
+// per pass however many clients need it.
+void sendStatus(uint8_t num, const MotorStatus& status, unsigned long now) {
+  if (statusPublisher.getFormat(num) == STATUS_FORMAT_BINARY) {
+    size_t length = statusFrameEncoder.encode(status, statusPublisher.deltaBase(num, status.axis, now));
+    webSocket.sendBIN(num, statusFrameEncoder.data(), length);
+  } else {
+    webSocket.sendTXT(num, createStatusJSON(status));
+  }
+  statusPublisher.markSent(num, status, now);
 }
 
 // ----------------------------------------------------------------
-// Create Status JSON String
+// Forward Sequence Progress from the Motion Task to all Clients
+// ----------------------------------------------------------------
+void broadcastSequenceEvents() {
+  static const char* const eventNames[] = { "leg", "complete", "cancelled", "failed" };
+  SequenceEvent event;
+  
+  while (sequenceEvents.pop(event)) {
+    StaticJsonDocument<200> doc;
+    doc["type"] = "sequence";
+    doc["event"] = eventNames[event.type];
+    doc["axis"] = event.axis;
+    doc["tag"] = event.tag;
+    doc["leg"] = event.leg;
+    doc["position"] = event.position;
+    
+    if (event.error != ERROR_NONE) {
+      doc["errorCode"] = event.error;
+    }
+    
+    char output[160];
+    size_t length = serializeJson(doc, output, sizeof(output));
+    webSocket.broadcastTXT(output, length);
+  }
+}
+
 // ----------------------------------------------------------------
-String createStatusJSON() {
-  StaticJsonDocument<512> doc;
+// Autofocus - queue the engine's moves and forward its events
+// ----------------------------------------------------------------
+void serviceAutofocus(unsigned long now) {
+  if (!autofocus.isActive()) return;
   
-  doc["position"] = motor.getCurrentPosition();
-  doc["target"] = motor.getTargetPosition();
-  doc["speed"] = motor.getSpeed();
-  doc["state"] = motor.getState();
-  doc["running"] = motor.isRunning();
-  doc["maxSteps"] = motor.getMaxSteps();
-  doc["stepsPerRot"] = motor.getStepsPerRotation();
-  doc["nearLimit"] = motor.isNearSoftLimit();
+  int target;
+  int axis = autofocus.getAxis();
+  if (autofocus.pendingMove(target) && sendMotionCommand(CMD_SET_TARGET, target, axis)) {
+    autofocus.moveSent(now);
+  }
   
-  // Calculate percentage
-  float rangeWidth = 2.0 * (float)motor.getMaxSteps();
-  float position = ((float)motor.getCurrentPosition() + (float)motor.getMaxSteps()) / rangeWidth;
-  position = constrain(position, 0.0, 1.0);
-  doc["percentage"] = position * 100.0;
+  AutofocusEvent event;
+  if (autofocus.poll(statusSnapshots[axis].read(), now, event)) {
+    broadcastAutofocusEvent(event);
+  }
+}
+
+void broadcastAutofocusEvent(const AutofocusEvent& event) {
+  static const char* const eventNames[] = { "sample", "done", "failed", "cancelled" };
+  StaticJsonDocument<200> doc;
+  doc["type"] = "autofocus";
+  doc["event"] = eventNames[event.type];
+  doc["axis"] = event.axis;
+  doc["position"] = event.position;
   
-  String output;
-  serializeJson(doc, output);
-  return output;
+  if (event.type == AF_EVENT_SAMPLE) {
+    doc["index"] = event.index;
+  }
+  if (event.haveEstimate) {
+    doc["best"] = event.estimate;
+  }
+  if (event.message) {
+    doc["message"] = event.message;
+  }
+  
+  char output[200];
+  size_t length = serializeJson(doc, output, sizeof(output));
+  webSocket.broadcastTXT(output, length);
+}
+
+// Manual moves, zeroing, sequences and emergency stop on the autofocus
+// axis end a run
+void cancelAutofocus(int axis) {
+  AutofocusEvent event;
+  if (axis != ALL_AXES && axis != autofocus.getAxis()) return;
+  if (autofocus.cancel(event)) {
+    broadcastAutofocusEvent(event);
+  }
+}
+
+// ----------------------------------------------------------------
+// Create Status JSON String
+// Encoded into a reusable buffer; valid until the next call
+// ----------------------------------------------------------------
+const char* createStatusJSON(const MotorStatus& status) {
+  return statusEncoders[status.axis].encode(status);
 }
 
 // ----------------------------------------------------------------
@@ -336,29 +854,81 @@ void setupWebServer() {
   // Enable CORS
   server.enableCORS(true);
   
+  // Request headers handlers need to see
+  static const char* headerKeys[] = { "If-None-Match" };
+  server.collectHeaders(headerKeys, 1);
+  
   // Routes
   server.on("/", handleRoot);
-  server.on("/api/status", HTTP_GET, handleGetStatus);
-  server.on("/api/position", HTTP_POST, handleSetPosition);
-  server.on("/api/speed", HTTP_POST, handleSetSpeed);
-  server.on("/api/nudge", HTTP_POST, handleNudge);
-  server.on("/api/zero", HTTP_POST, handleZero);
-  server.on("/api/stop", HTTP_POST, handleEmergencyStop);
-  server.on("/api/reboot", HTTP_POST, handleReboot);
-  server.on("/api/settings/max", HTTP_POST, handleSetMaxSteps);
-  server.on("/api/settings/stepsperrot", HTTP_POST, handleSetStepsPerRotation);
-  server.on("/api/logs", HTTP_GET, handleGetLogs);
+  addApiRoute("/api/status", HTTP_GET, handleGetStatus);
+  addApiRoute("/api/position", HTTP_POST, handleSetPosition);
+  addApiRoute("/api/speed", HTTP_POST, handleSetSpeed);
+  addApiRoute("/api/nudge", HTTP_POST, handleNudge);
+  addApiRoute("/api/zero", HTTP_POST, handleZero);
+  addApiRoute("/api/stop", HTTP_POST, handleEmergencyStop);
+  addApiRoute("/api/move", HTTP_POST, handleMove);
+  addApiRoute("/api/reboot", HTTP_POST, handleReboot);
+  addApiRoute("/api/settings/max", HTTP_POST, handleSetMaxSteps);
+  addApiRoute("/api/settings/stepsperrot", HTTP_POST, handleSetStepsPerRotation);
+  addApiRoute("/api/settings/backlash", HTTP_POST, handleSetBacklash);
+  addApiRoute("/api/settings/backlash", HTTP_GET, handleGetBacklash);
+  addApiRoute("/api/logs", HTTP_GET, handleGetLogs);
+  addApiRoute("/api/sequence", HTTP_POST, handleRunSequence);
+  addApiRoute("/api/autofocus", HTTP_POST, handleAutofocus);
+  addApiRoute("/api/autofocus/metric", HTTP_POST, handleAutofocusMetric);
+  addApiRoute("/api/autofocus/cancel", HTTP_POST, handleAutofocusCancel);
+  addApiRoute("/api/trace", HTTP_POST, handleSetTrace);
+  addApiRoute("/api/trace", HTTP_GET, handleGetTrace);
+  addApiRoute("/api/record", HTTP_POST, handleSetRecord);
+  addApiRoute("/api/record", HTTP_GET, handleGetRecord);
+  addApiRoute("/api/metrics", HTTP_GET, handleGetMetrics);
+  addApiRoute("/api/profile", HTTP_GET, handleGetProfile);
+  addApiRoute("/api/profile/bench", HTTP_GET, handleGetBench);
+}
+
+// Register an /api route with its own request duration histogram; POST
+// bodies also go to the command recorder while it runs
+void addApiRoute(const char* uri, HTTPMethod method, void (*handler)()) {
+  int route = metrics.addRoute(uri, method == HTTP_GET ? "GET" : "POST");
+  server.on(uri, method, [route, uri, method, handler]() {
+    uint32_t start = micros();
+    if (method == HTTP_POST && commandRecorder.isRecording()) {
+      String body = server.arg("plain");
+      commandRecorder.record(COMMAND_SOURCE_REST, 0, uri, body.c_str(), body.length());
+    }
+    handler();
+    metrics.observeRequest(route, micros() - start);
+  });
 }
 
 // ----------------------------------------------------------------
 // Web Server Handlers
 // ----------------------------------------------------------------
+// Precompressed page straight from flash; browsers revalidate with the
+// ETag and get a 304 until the firmware's UI changes
 void handleRoot() {
-  server.send(200, "text/html", getHTML());
+  server.sendHeader("ETag", HTML_PAGE_ETAG);
+  server.sendHeader("Cache-Control", "no-cache");
+  
+  if (server.header("If-None-Match").indexOf(HTML_PAGE_ETAG) >= 0) {
+    server.send(304);
+    return;
+  }
+  
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, "text/html", (const char*)HTML_PAGE_GZ, HTML_PAGE_GZ_SIZE);
 }
 
+// GET /api/status?axis=n (axis 0 by default)
 void handleGetStatus() {
-  server.send(200, "application/json", createStatusJSON());
+  int axis;
+  if (!readAxisArg(axis)) {
+    sendJSONResponse(400, "error", "Invalid axis");
+    return;
+  }
+  
+  const char* statusJSON = createStatusJSON(statusSnapshots[axis].read());
+  server.send(200, "application/json", statusJSON, statusEncoders[axis].size());
 }
 
 void handleSetPosition() {
@@ -370,82 +940,75 @@ void handleSetPosition() {
     return;
   }
   
-  if (!doc.containsKey("position")) {
-    sendJSONResponse(400, "error", "Missing position parameter");
-    return;
-  }
-  
-  int pos = doc["position"];
-  error = motor.validatePosition(pos);
-  
-  if (error == ERROR_HARD_LIMIT) {
-    sendJSONResponse(400, "error", "Position out of range", error);
-    return;
-  }
-  
-  motor.setTargetPosition(pos);
-  
-  if (error == ERROR_SOFT_LIMIT_WARNING) {
-    sendJSONResponse(200, "warning", "Near soft limit", error);
-  } else {
-    sendJSONResponse(200, "success");
-  }
+  sendCommandResult(runSetPosition(doc.as<JsonVariantConst>()));
 }
 
 void handleSetSpeed() {
   StaticJsonDocument<100> doc;
   ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
   
-  if (error != ERROR_NONE || !doc.containsKey("speed")) {
+  if (error != ERROR_NONE) {
     sendJSONResponse(400, "error", "Invalid request", ERROR_INVALID_SPEED);
     return;
   }
   
-  int speed = doc["speed"];
-  motor.setSpeed(speed);
-  preferences.putInt("speed", speed);
-  
-  sendJSONResponse(200, "success");
+  sendCommandResult(runSetSpeed(doc.as<JsonVariantConst>()));
 }
 
 void handleNudge() {
   StaticJsonDocument<100> doc;
   ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
   
-  if (error != ERROR_NONE || !doc.containsKey("steps")) {
+  if (error != ERROR_NONE) {
     sendJSONResponse(400, "error", "Invalid request");
     return;
   }
   
-  int steps = doc["steps"];
-  int newPos = motor.getCurrentPosition() + steps;
+  sendCommandResult(runNudge(doc.as<JsonVariantConst>()));
+}
+
+// The body is optional: {"axis": n}
+void handleZero() {
+  StaticJsonDocument<100> doc;
+  ErrorCode error = parseOptionalJSONRequest(server.arg("plain"), doc);
   
-  error = motor.validatePosition(newPos);
-  if (error == ERROR_HARD_LIMIT) {
-    sendJSONResponse(400, "error", "Would exceed limits", error);
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
     return;
   }
   
-  motor.setTargetPosition(newPos);
-  sendJSONResponse(200, "success");
+  sendCommandResult(runZero(doc.as<JsonVariantConst>()));
 }
 
-void handleZero() {
-  motor.setCurrentPosition(0);
-  preferences.putInt("position", 0);
-  sendJSONResponse(200, "success", "Position zeroed");
+// The body is optional: {"axis": n}; without it every axis stops
+void handleEmergencyStop() {
+  StaticJsonDocument<100> doc;
+  ErrorCode error = parseOptionalJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runEmergencyStop(doc.as<JsonVariantConst>()));
 }
 
-void handleEmergencyStop() {
-  motor.emergencyStop();
-  logger.log(motor.getCurrentPosition(), motor.getTargetPosition(), 
-             0, STATE_EMERGENCY_STOP, ERROR_NONE);
-  sendJSONResponse(200, "success", "Emergency stop");
+void handleMove() {
+  StaticJsonDocument<SEQUENCE_JSON_SIZE> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runMove(doc.as<JsonVariantConst>()));
 }
 
 void handleReboot() {
   sendJSONResponse(200, "success", "Rebooting...");
   server.handleClient(); // Ensure response is sent
+  configStore.flush();
   delay(REBOOT_DELAY);
   ESP.restart();
 }
@@ -454,97 +1017,1019 @@ void handleSetMaxSteps() {
   StaticJsonDocument<100> doc;
   ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
   
-  if (error != ERROR_NONE || !doc.containsKey("maxSteps")) {
+  if (error != ERROR_NONE) {
     sendJSONResponse(400, "error", "Invalid request");
     return;
   }
   
-  int val = doc["maxSteps"];
-  if (val > 0) {
-    motor.setMaxSteps(val);
-    preferences.putInt("maxSteps", val);
-    sendJSONResponse(200, "success");
-  } else {
-    sendJSONResponse(400, "error", "Invalid value");
-  }
+  sendCommandResult(runSetMaxSteps(doc.as<JsonVariantConst>()));
 }
 
 void handleSetStepsPerRotation() {
   StaticJsonDocument<100> doc;
   ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
   
-  if (error != ERROR_NONE || !doc.containsKey("stepsPerRot")) {
+  if (error != ERROR_NONE) {
     sendJSONResponse(400, "error", "Invalid request");
     return;
   }
   
-  int val = doc["stepsPerRot"];
-  if (val > 0) {
-    motor.setStepsPerRotation(val);
-    preferences.putInt("stepsPerRot", val);
-    sendJSONResponse(200, "success");
-  } else {
-    sendJSONResponse(400, "error", "Invalid value");
-  }
+  sendCommandResult(runSetStepsPerRotation(doc.as<JsonVariantConst>()));
 }
 
-void handleGetLogs() {
-  String logs = logger.getLastErrors(20);
-  server.send(200, "application/json", logs);
-}
-
-// ----------------------------------------------------------------
-// Helper Functions
-// ----------------------------------------------------------------
-ErrorCode parseJSONRequest(const String& body, JsonDocument& doc) {
-  // Buffer overflow protection
-  if (body.length() > 1024) {
-    return ERROR_BUFFER_OVERFLOW;
-  }
+void handleSetBacklash() {
+  StaticJsonDocument<100> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
   
-  DeserializationError error = deserializeJson(doc, body);
-  if (error) {
-    Serial.print("JSON parse error: ");
-    Serial.println(error.c_str());
-    return ERROR_INVALID_JSON;
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
   }
   
-  return ERROR_NONE;
+  sendCommandResult(runSetBacklash(doc.as<JsonVariantConst>()));
 }
 
-void sendJSONResponse(int code, const char* status, const char* message, ErrorCode error) {
-  StaticJsonDocument<200> doc;
-  doc["status"] = status;
-  
-  if (message) {
-    doc["message"] = message;
+// GET /api/settings/backlash?axis=n (axis 0 by default)
+void handleGetBacklash() {
+  static const char* const modeNames[] = { "off", "overshoot", "slack" };
+  int axis;
+  if (!readAxisArg(axis)) {
+    sendJSONResponse(400, "error", "Invalid axis");
+    return;
   }
   
-  if (error != ERROR_NONE) {
-    doc["errorCode"] = error;
-  }
+  // From the store, which every change goes through; the motor's copy
+  // belongs to the motion task
+  MotorConfig config = configStore.get(axis);
+  StaticJsonDocument<100> doc;
+  doc["mode"] = modeNames[config.backlashMode];
+  doc["steps"] = config.backlashSteps;
+  doc["direction"] = config.backlashDirection;
   
   String output;
   serializeJson(doc, output);
-  server.send(code, "application/json", output);
+  server.send(200, "application/json", output);
 }
 
-bool validateAndSavePosition() {
-  int pos = motor.getCurrentPosition();
-  ErrorCode error = motor.validatePosition(pos);
+void handleRunSequence() {
+  StaticJsonDocument<SEQUENCE_JSON_SIZE> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runSequence(doc.as<JsonVariantConst>()));
+}
+
+void handleAutofocus() {
+  StaticJsonDocument<200> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runAutofocus(doc.as<JsonVariantConst>()));
+}
+
+void handleAutofocusMetric() {
+  StaticJsonDocument<100> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runAutofocusMetric(doc.as<JsonVariantConst>()));
+}
+
+void handleAutofocusCancel() {
+  sendCommandResult(runAutofocusCancel());
+}
+
+void handleSetTrace() {
+  StaticJsonDocument<100> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runSetTrace(doc.as<JsonVariantConst>()));
+}
+
+// Stream the step trace as chunked binary straight out of the ring
+// buffer (format in StepTrace.h)
+void handleGetTrace() {
+  if (!stepTrace.beginExport()) {
+    sendJSONResponse(409, "error", "Trace still recording");
+    return;
+  }
+  
+  StepTraceHeader header = stepTrace.header();
+  server.sendHeader("Content-Disposition", "attachment; filename=\"steptrace.bin\"");
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/octet-stream", "");
+  server.sendContent((const char*)&header, sizeof(header));
+  
+  for (int p = 0; p < 2; p++) {
+    const StepTraceRecord* data = nullptr;
+    uint32_t count = stepTrace.piece(p, data);
+    for (uint32_t i = 0; i < count && server.client().connected(); i += TRACE_EXPORT_CHUNK) {
+      uint32_t n = min(count - i, (uint32_t)TRACE_EXPORT_CHUNK);
+      server.sendContent((const char*)(data + i), n * sizeof(StepTraceRecord));
+      esp_task_wdt_reset();        // A full PSRAM trace takes a while
+    }
+  }
+  server.sendContent("");
+  stepTrace.endExport();
+}
+
+void handleSetRecord() {
+  StaticJsonDocument<100> doc;
+  ErrorCode error = parseJSONRequest(server.arg("plain"), doc);
+  
+  if (error != ERROR_NONE) {
+    sendJSONResponse(400, "error", "Invalid request");
+    return;
+  }
+  
+  sendCommandResult(runSetRecord(doc.as<JsonVariantConst>()));
+}
+
+// Stream the recorded commands as JSON lines (format in
+// CommandRecorder.h)
+void handleGetRecord() {
+  server.sendHeader("Content-Disposition", "attachment; filename=\"commands.ndjson\"");
+  ChunkedResponse out(server, 200, "application/x-ndjson");
+  out.printf("{\"version\":%d,\"records\":%lu,\"dropped\":%lu,\"recording\":%s,\"now\":%lu}\n",
+             RECORDER_FORMAT_VERSION, (unsigned long)commandRecorder.getCount(),
+             (unsigned long)commandRecorder.getDropped(),
+             commandRecorder.isRecording() ? "true" : "false", (unsigned long)micros());
+             
+  int written = 0;
+  for (uint32_t c = commandRecorder.first(); c != 0 && server.client().connected();
+       c = commandRecorder.next(c)) {
+    commandRecorder.writeRecord(out, c);
+    if (++written % 64 == 0) {
+      esp_task_wdt_reset();        // A full PSRAM ring takes a while
+    }
+  }
+  out.end();
+}
+
+// GET /api/logs?since=<seq>&level=info|warning|error&error=<code>&limit=<n>
+// Matching entries go out oldest first, streamed through one fixed
+// chunk buffer. Without since the newest page is returned; passing the
+// reply's "next" back as since then fetches only what is new.
+void handleGetLogs() {
+  LogFilter filter = { LOG_LEVEL_INFO, -1 };
+  String level = server.arg("level");
+  if (level == "warning") {
+    filter.level = LOG_LEVEL_WARNING;
+  } else if (level == "error") {
+    filter.level = LOG_LEVEL_ERROR;
+  } else if (level.length() > 0 && level != "info") {
+    sendJSONResponse(400, "error", "Invalid level");
+    return;
+  }
+  if (server.hasArg("error")) {
+    filter.error = server.arg("error").toInt();
+  }
+  int limit = server.hasArg("limit") ? server.arg("limit").toInt() : LOG_PAGE_DEFAULT;
+  limit = constrain(limit, 1, LOG_BUFFER_SIZE);
+  
+  uint32_t oldest = logger.getOldestSequence();
+  uint32_t next = logger.getNextSequence();
+  uint32_t start;
+  uint32_t missed = 0;
+  if (server.hasArg("since")) {
+    start = strtoul(server.arg("since").c_str(), nullptr, 10) + 1;
+    if (start > next) {
+      start = oldest;              // Cursor from before a reboot
+    } else if (start < oldest) {
+      missed = oldest - start;     // Overwritten before the client caught up
+      start = oldest;
+    }
+  } else {
+    start = logger.tailStart(filter, limit);
+  }
+  
+  ChunkedResponse out(server, 200, "application/json");
+  out.print("{\"entries\":[");
+  
+  uint32_t cursor = start - 1;     // Last sequence scanned
+  int sent = 0;
+  char line[RESPONSE_LINE_SIZE];
+  for (uint32_t seq = start; seq < next && sent < limit; seq++) {
+    cursor = seq;
+    const LogEntry* entry = logger.getEntry(seq);
+    if (entry == nullptr || !Logger::matches(*entry, filter)) continue;
+    
+    if (sent > 0) out.write(",", 1);
+    out.write(line, Logger::formatEntry(*entry, line, sizeof(line)));
+    sent++;
+  }
+  
+  out.printf("],\"next\":%lu,\"more\":%s,\"missed\":%lu}",
+             (unsigned long)cursor, cursor + 1 < next ? "true" : "false",
+             (unsigned long)missed);
+  out.end();
+}
+
+// Prometheus text format: timing histograms (see Metrics.h) and a few
+// gauges, streamed through one chunk buffer
+void handleGetMetrics() {
+  ChunkedResponse out(server, 200, "text/plain; version=0.0.4");
+  
+  out.print("# HELP focuser_step_lateness_seconds Time from a step's scheduled time to the step interrupt.\n"
+            "# TYPE focuser_step_lateness_seconds histogram\n");
+  Metrics::writeHistogram(out, "focuser_step_lateness_seconds", "", metrics.stepLateness.read());
+  
+  out.print("# HELP focuser_task_pass_seconds Time for one pass of a firmware task.\n"
+            "# TYPE focuser_task_pass_seconds histogram\n");
+  Metrics::writeHistogram(out, "focuser_task_pass_seconds", "task=\"motion\"", metrics.motionPass.read());
+  Metrics::writeHistogram(out, "focuser_task_pass_seconds", "task=\"network\"", metrics.networkPass.read());
+  
+  out.print("# HELP focuser_http_request_duration_seconds Time spent in an API handler.\n"
+            "# TYPE focuser_http_request_duration_seconds histogram\n");
+  char labels[METRICS_LABELS_SIZE];
+  for (int i = 0; i < metrics.getRouteCount(); i++) {
+    snprintf(labels, sizeof(labels), "method=\"%s\",path=\"%s\"",
+             metrics.getRouteMethod(i), metrics.getRoutePath(i));
+    Metrics::writeHistogram(out, "focuser_http_request_duration_seconds", labels,
+                            metrics.getRouteHistogram(i).read());
+  }
+  
+  out.printf("# HELP focuser_sequence_events_dropped_total Sequence events lost to a full queue.\n"
+             "# TYPE focuser_sequence_events_dropped_total counter\n"
+             "focuser_sequence_events_dropped_total %lu\n",
+             (unsigned long)metrics.sequenceEventsDropped.load(std::memory_order_relaxed));
+  out.printf("# TYPE focuser_uptime_seconds counter\nfocuser_uptime_seconds %lu\n", millis() / 1000);
+  out.printf("# TYPE focuser_free_heap_bytes gauge\nfocuser_free_heap_bytes %lu\n",
+             (unsigned long)ESP.getFreeHeap());
+  out.print("# TYPE focuser_position_steps gauge\n");
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    out.printf("focuser_position_steps{axis=\"%d\"} %d\n", axis, statusSnapshots[axis].read().position);
+  }
+  out.print("# TYPE focuser_running gauge\n");
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    out.printf("focuser_running{axis=\"%d\"} %d\n", axis, statusSnapshots[axis].read().running ? 1 : 0);
+  }
+  out.end();
+}
+
+// Loop profiler sections and slowest network passes, in microseconds;
+// ?reset=1 clears the data after reading it
+void handleGetProfile() {
+#if ENABLE_PROFILER
+  float cyclesPerUs = ESP.getCpuFreqMHz();
+  ChunkedResponse out(server, 200, "application/json");
+  out.print("{\"sections\":[");
+  
+  LoopProfiler::SectionStats stats;
+  for (int i = 0; i < PROFILE_SECTION_COUNT; i++) {
+    profiler.readSection((ProfileSection)i, stats);
+    float avg = stats.count ? (float)stats.total / stats.count : 0;
+    out.printf("%s{\"name\":\"%s\",\"count\":%lu,\"minUs\":%.1f,\"avgUs\":%.1f,"
+               "\"maxUs\":%.1f,\"p99Us\":%.1f}",
+               i ? "," : "", PROFILE_SECTION_NAMES[i], (unsigned long)stats.count,
+               stats.min / cyclesPerUs, avg / cyclesPerUs, stats.max / cyclesPerUs,
+               LoopProfiler::percentile(stats, 0.99f) / cyclesPerUs);
+  }
+  
+  out.print("],\"worst\":[");
+  LoopProfiler::Iteration worst[PROFILER_WORST_COUNT];
+  int count = profiler.readWorst(worst);
+  for (int i = 0; i < count; i++) {
+    out.printf("%s{\"time\":%lu,\"totalUs\":%.1f,\"sections\":{",
+               i ? "," : "", worst[i].timestamp, worst[i].cycles / cyclesPerUs);
+    for (int j = 0; j < PROFILE_NETWORK_PASS; j++) {
+      out.printf("%s\"%s\":%.1f", j ? "," : "", PROFILE_SECTION_NAMES[j],
+                 worst[i].sections[j] / cyclesPerUs);
+    }
+    out.print("}}");
+  }
+  out.print("]}");
+  out.end();
+  
+  if (server.arg("reset") == "1") {
+    profiler.reset();
+  }
+#else
+  sendJSONResponse(501, "error", "Profiler not built in (set ENABLE_PROFILER in Config.h)");
+#endif
+}
+
+// Microbenchmarks of the per-request and per-status hot paths, run on
+// the network task: ns per call and net heap change per call. Motor
+// stepping is owned by the motion task and its timer, so it is covered
+// by the motorUpdate section and /api/metrics instead.
+void handleGetBench() {
+#if ENABLE_PROFILER
+  static const struct {
+    const char* name;
+    const char* body;
+  } payloads[] = {
+    { "parse/position", "{\"position\":1500}" },
+    { "parse/nudge", "{\"steps\":-100}" },
+    { "parse/speed", "{\"speed\":250}" },
+    { "parse/backlash", "{\"mode\":\"slack\",\"steps\":40,\"direction\":1}" },
+    { "parse/sequence", "{\"tag\":7,\"legs\":[{\"position\":1000,\"dwell\":500},"
+                        "{\"steps\":200,\"speed\":300},{\"steps\":200},{\"position\":0}]}" }
+  };
+  
+  ChunkedResponse out(server, 200, "application/json");
+  out.printf("{\"cpuMHz\":%lu,\"iterations\":%d,\"results\":[",
+             (unsigned long)ESP.getCpuFreqMHz(), BENCH_ITERATIONS);
+  bool first = true;
+  auto report = [&](const char* name, float ns, int32_t heapBefore) {
+    float heapPerOp = (float)(heapBefore - (int32_t)ESP.getFreeHeap()) / BENCH_ITERATIONS;
+    out.printf("%s{\"name\":\"%s\",\"nsPerOp\":%.0f,\"heapBytesPerOp\":%.2f}",
+               first ? "" : ",", name, ns, heapPerOp);
+    first = false;
+    esp_task_wdt_reset();
+  };
+  
+  MotorStatus status = statusSnapshots[0].read();
+  MotorStatus base = status;
+  int32_t heap = ESP.getFreeHeap();
+  StatusEncoder jsonEncoder;
+  float ns = benchmarkNs(BENCH_ITERATIONS, [&](int i) {
+    status.position = i;             // Defeat the unchanged-status cache
+    jsonEncoder.encode(status);
+  });
+  report("statusJSON", ns, heap);
+  
+  StatusFrameEncoder frameEncoder;
+  heap = ESP.getFreeHeap();
+  ns = benchmarkNs(BENCH_ITERATIONS, [&](int i) {
+    status.position = i;
+    frameEncoder.encode(status, nullptr);
+  });
+  report("statusFrame/full", ns, heap);
+  
+  heap = ESP.getFreeHeap();
+  ns = benchmarkNs(BENCH_ITERATIONS, [&](int i) {
+    status.position = base.position + (i & 63);
+    frameEncoder.encode(status, &base);
+  });
+  report("statusFrame/delta", ns, heap);
+  
+  for (const auto& payload : payloads) {
+    String body(payload.body);
+    StaticJsonDocument<SEQUENCE_JSON_SIZE> doc;
+    heap = ESP.getFreeHeap();
+    ns = benchmarkNs(BENCH_ITERATIONS, [&](int) {
+      parseJSONRequest(body, doc);
+    });
+    report(payload.name, ns, heap);
+  }
+  
+  static Logger benchLog;          // Keeps the real log clean
+  heap = ESP.getFreeHeap();
+  ns = benchmarkNs(BENCH_ITERATIONS, [&](int i) {
+    benchLog.log(i, i + 100, 250, STATE_RUNNING, ERROR_NONE);
+  });
+  report("logger/log", ns, heap);
+  
+  char line[RESPONSE_LINE_SIZE];
+  heap = ESP.getFreeHeap();
+  ns = benchmarkNs(BENCH_ITERATIONS, [&](int i) {
+    const LogEntry* entry = benchLog.getEntry(benchLog.getNextSequence() - 1 - (i % LOG_BUFFER_SIZE));
+    Logger::formatEntry(*entry, line, sizeof(line));
+  });
+  report("logger/formatEntry", ns, heap);
+  
+  out.print("]}");
+  out.end();
+#else
+  sendJSONResponse(501, "error", "Profiler not built in (set ENABLE_PROFILER in Config.h)");
+#endif
+}
+
+// ----------------------------------------------------------------
+// Commands - shared by the REST handlers and the WebSocket protocol
+// ----------------------------------------------------------------
+// Commands act on the axis in an optional "axis" field, 0 by default
+CommandResult runSetPosition(JsonVariantConst args) {
+  if (!args.containsKey("position")) {
+    return { 400, "error", "Missing position parameter", ERROR_NONE };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  int pos = args["position"];
+  ErrorCode error = checkPosition(pos, statusSnapshots[axis].read().maxSteps);
   
   if (error == ERROR_HARD_LIMIT) {
-    Serial.println("ERROR: Position validation failed!");
-    return false;
+    return { 400, "error", "Position out of range", error };
   }
   
-  preferences.putInt("position", pos);
-  return true;
+  if (!sendMotionCommand(CMD_SET_TARGET, pos, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  cancelAutofocus(axis);
+  
+  if (error == ERROR_SOFT_LIMIT_WARNING) {
+    return { 200, "warning", "Near soft limit", error };
+  }
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+CommandResult runSetSpeed(JsonVariantConst args) {
+  if (!args.containsKey("speed")) {
+    return { 400, "error", "Invalid request", ERROR_INVALID_SPEED };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  int speed = args["speed"];
+  if (speed < MIN_SPEED || speed > MAX_SPEED) {
+    return { 400, "error", "Speed out of range", ERROR_INVALID_SPEED };
+  }
+  if (!sendMotionCommand(CMD_SET_SPEED, speed, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  configStore.set(axis, &MotorConfig::defaultSpeed, speed);
+  
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+CommandResult runNudge(JsonVariantConst args) {
+  if (!args.containsKey("steps")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  int steps = args["steps"];
+  MotorStatus status = statusSnapshots[axis].read();
+  int newPos = status.position + steps;
+  
+  ErrorCode error = checkPosition(newPos, status.maxSteps);
+  if (error == ERROR_HARD_LIMIT) {
+    return { 400, "error", "Would exceed limits", error };
+  }
+  
+  if (!sendMotionCommand(CMD_NUDGE, steps, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  cancelAutofocus(axis);
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+CommandResult runZero(JsonVariantConst args) {
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  if (!sendMotionCommand(CMD_SET_POSITION, 0, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  cancelAutofocus(axis);
+  return { 200, "success", "Position zeroed", ERROR_NONE };
+}
+
+// Stops every axis unless one is named
+CommandResult runEmergencyStop(JsonVariantConst args) {
+  int axis;
+  if (!readAxis(args, axis, ALL_AXES)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  if (!sendMotionCommand(CMD_EMERGENCY_STOP, 0, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  cancelAutofocus(axis);
+  int pos = statusSnapshots[axis == ALL_AXES ? 0 : axis].read().position;
+  logger.log(pos, pos, 0, STATE_EMERGENCY_STOP, ERROR_NONE);
+  return { 200, "success", "Emergency stop", ERROR_NONE };
+}
+
+// Move several axes together so they start and arrive at the same time:
+// {"axes": [{"axis": n, "position"|"steps": n}, ...]}
+CommandResult runMove(JsonVariantConst args) {
+  JsonArrayConst axes = args["axes"];
+  if (axes.isNull() || axes.size() == 0) {
+    return { 400, "error", "Missing axes", ERROR_NONE };
+  }
+  
+  CoordinatedMove move;
+  move.mask = 0;
+  for (JsonVariantConst entry : axes) {
+    int axis;
+    if (!entry.containsKey("axis") || !readAxis(entry, axis) || (move.mask & (1 << axis))) {
+      return { 400, "error", "Invalid axis", ERROR_NONE };
+    }
+    bool relative = entry.containsKey("steps");
+    if (relative == entry.containsKey("position")) {
+      return { 400, "error", "Each axis needs position or steps", ERROR_NONE };
+    }
+    
+    move.mask |= 1 << axis;
+    move.relative[axis] = relative;
+    move.targets[axis] = relative ? entry["steps"] : entry["position"];
+    MotorStatus status = statusSnapshots[axis].read();
+    int target = relative ? status.position + move.targets[axis] : move.targets[axis];
+    if (checkPosition(target, status.maxSteps) == ERROR_HARD_LIMIT) {
+      return { 400, "error", "Move exceeds limits", ERROR_HARD_LIMIT };
+    }
+  }
+  
+  if (!moveSlot.offer(move)) {
+    return { 503, "error", "Move handoff busy", ERROR_NONE };
+  }
+  if (!sendMotionCommand(CMD_MOVE_COORDINATED)) {
+    moveSlot.withdraw();
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    if (move.mask & (1 << axis)) {
+      cancelAutofocus(axis);
+    }
+  }
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+CommandResult runSetMaxSteps(JsonVariantConst args) {
+  if (!args.containsKey("maxSteps")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  int val = args["maxSteps"];
+  if (val <= 0) {
+    return { 400, "error", "Invalid value", ERROR_NONE };
+  }
+  
+  if (!sendMotionCommand(CMD_SET_MAX_STEPS, val, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  configStore.set(axis, &MotorConfig::maxSteps, val);
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+CommandResult runSetStepsPerRotation(JsonVariantConst args) {
+  if (!args.containsKey("stepsPerRot")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  int val = args["stepsPerRot"];
+  if (val <= 0) {
+    return { 400, "error", "Invalid value", ERROR_NONE };
+  }
+  
+  if (!sendMotionCommand(CMD_SET_STEPS_PER_ROT, val, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  configStore.set(axis, &MotorConfig::stepsPerRotation, val);
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// {"mode": "off"|"overshoot"|"slack", "steps": n, "direction": 1|-1};
+// any subset of the fields may be given
+CommandResult runSetBacklash(JsonVariantConst args) {
+  const char* modeName = args["mode"];
+  int steps = args["steps"] | 0;
+  int direction = args["direction"] | 1;
+  BacklashMode mode = BACKLASH_OFF;
+  
+  if (!modeName && !args.containsKey("steps") && !args.containsKey("direction")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  if (modeName) {
+    if (strcmp(modeName, "off") == 0) {
+      mode = BACKLASH_OFF;
+    } else if (strcmp(modeName, "overshoot") == 0) {
+      mode = BACKLASH_OVERSHOOT;
+    } else if (strcmp(modeName, "slack") == 0) {
+      mode = BACKLASH_SLACK;
+    } else {
+      return { 400, "error", "Invalid mode", ERROR_NONE };
+    }
+  }
+  if (steps < 0 || steps > statusSnapshots[axis].read().maxSteps || (direction != 1 && direction != -1)) {
+    return { 400, "error", "Invalid value", ERROR_NONE };
+  }
+  
+  // All or nothing: the network task is the queue's only producer, so
+  // the room checked here is still there for every command
+  uint32_t commands = args.containsKey("steps") + args.containsKey("direction") + (modeName != nullptr);
+  if (!commandQueue.hasRoom(commands)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  if (args.containsKey("steps")) {
+    sendMotionCommand(CMD_SET_BACKLASH_STEPS, steps, axis);
+    configStore.set(axis, &MotorConfig::backlashSteps, steps);
+  }
+  if (args.containsKey("direction")) {
+    sendMotionCommand(CMD_SET_BACKLASH_DIRECTION, direction, axis);
+    configStore.set(axis, &MotorConfig::backlashDirection, direction);
+  }
+  if (modeName) {
+    sendMotionCommand(CMD_SET_BACKLASH_MODE, mode, axis);
+    configStore.set(axis, &MotorConfig::backlashMode, mode);
+  }
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// Batch of moves run by the motion task on one axis:
+// {"axis": n, "tag": n, "legs": [{"position"|"steps": n, "speed": n, "dwell": ms}, ...]}
+CommandResult runSequence(JsonVariantConst args) {
+  JsonArrayConst legs = args["legs"];
+  if (legs.isNull() || legs.size() == 0) {
+    return { 400, "error", "Missing legs", ERROR_NONE };
+  }
+  if (legs.size() > SEQUENCE_MAX_LEGS) {
+    return { 400, "error", "Too many legs", ERROR_BUFFER_OVERFLOW };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  MotionSequence sequence;
+  sequence.tag = args["tag"] | 0;
+  sequence.axis = axis;
+  sequence.count = 0;
+  
+  // Check targets up front, chaining relative legs from where we are now
+  MotorStatus status = statusSnapshots[axis].read();
+  int target = status.position;
+  for (JsonVariantConst leg : legs) {
+    bool relative = leg.containsKey("steps");
+    if (relative == leg.containsKey("position")) {
+      return { 400, "error", "Each leg needs position or steps", ERROR_NONE };
+    }
+    
+    SequenceLeg& out = sequence.legs[sequence.count++];
+    out.relative = relative;
+    out.value = relative ? leg["steps"] : leg["position"];
+    out.speed = leg["speed"] | 0;
+    long dwell = leg["dwell"] | 0L;
+    
+    if (out.speed < 0) {
+      return { 400, "error", "Invalid speed", ERROR_INVALID_SPEED };
+    }
+    if (dwell < 0) {
+      return { 400, "error", "Invalid dwell", ERROR_NONE };
+    }
+    out.dwell = dwell;
+    
+    target = relative ? target + out.value : out.value;
+    if (checkPosition(target, status.maxSteps) == ERROR_HARD_LIMIT) {
+      return { 400, "error", "Sequence exceeds limits", ERROR_HARD_LIMIT };
+    }
+  }
+  
+  if (!sequenceSlot.offer(sequence)) {
+    return { 503, "error", "Sequence handoff busy", ERROR_NONE };
+  }
+  if (!sendMotionCommand(CMD_RUN_SEQUENCE)) {
+    sequenceSlot.withdraw();
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  cancelAutofocus(axis);
+  return { 200, "success", "Sequence started", ERROR_NONE };
+}
+
+// Start a V-curve sweep:
+// {"axis": n, "start": n, "step": n, "count": n, "metric": "hfr"|"contrast", "settle": ms}
+CommandResult runAutofocus(JsonVariantConst args) {
+  if (!args.containsKey("start") || !args.containsKey("step") || !args.containsKey("count")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  AutofocusParams params;
+  params.axis = axis;
+  params.start = args["start"];
+  params.step = args["step"];
+  params.count = args["count"];
+  params.backlash = AUTOFOCUS_BACKLASH_STEPS;
+  long settle = args["settle"] | 0L;
+  const char* metric = args["metric"] | "hfr";
+  
+  if (params.step == 0 || params.count < 3 || params.count > AUTOFOCUS_MAX_SAMPLES || settle < 0) {
+    return { 400, "error", "Invalid value", ERROR_NONE };
+  }
+  params.settle = settle;
+  
+  if (strcmp(metric, "hfr") == 0) {
+    params.metric = METRIC_HFR;
+  } else if (strcmp(metric, "contrast") == 0) {
+    params.metric = METRIC_CONTRAST;
+  } else {
+    return { 400, "error", "Unknown metric", ERROR_NONE };
+  }
+  
+  // Backlash take-up before the first sample and the last sample must fit
+  int direction = params.step > 0 ? 1 : -1;
+  int first = params.start - direction * params.backlash;
+  int last = params.start + (params.count - 1) * params.step;
+  int maxSteps = statusSnapshots[axis].read().maxSteps;
+  if (checkPosition(first, maxSteps) == ERROR_HARD_LIMIT || checkPosition(last, maxSteps) == ERROR_HARD_LIMIT) {
+    return { 400, "error", "Sweep exceeds limits", ERROR_HARD_LIMIT };
+  }
+  
+  cancelAutofocus(ALL_AXES);
+  autofocus.start(params);
+  return { 200, "success", "Autofocus started", ERROR_NONE };
+}
+
+// Focus metric for the sample announced by the last "sample" event
+CommandResult runAutofocusMetric(JsonVariantConst args) {
+  if (!args.containsKey("value")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  return autofocus.addMetric(args["index"] | -1, args["value"].as<float>());
+}
+
+CommandResult runAutofocusCancel() {
+  if (!autofocus.isActive()) {
+    return { 409, "error", "Autofocus not running", ERROR_NONE };
+  }
+  cancelAutofocus(ALL_AXES);
+  return { 200, "success", "Autofocus cancelled", ERROR_NONE };
+}
+
+// {"enabled": true, "axis": n} starts a fresh step trace of one axis,
+// false stops it so it can be downloaded from GET /api/trace
+CommandResult runSetTrace(JsonVariantConst args) {
+  if (!args["enabled"].is<bool>()) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  int axis;
+  if (!readAxis(args, axis)) {
+    return { 400, "error", "Invalid axis", ERROR_NONE };
+  }
+  
+  if (!sendMotionCommand(CMD_SET_TRACE, args["enabled"].as<bool>() ? 1 : 0, axis)) {
+    return { 503, "error", "Motion queue full", ERROR_NONE };
+  }
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// {"enabled": true} clears the command recorder and starts recording,
+// false stops it so it can be downloaded from GET /api/record
+CommandResult runSetRecord(JsonVariantConst args) {
+  if (!args["enabled"].is<bool>()) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  
+  if (!args["enabled"].as<bool>()) {
+    commandRecorder.stop();
+  } else if (!commandRecorder.start()) {
+    return { 500, "error", "Not enough memory to record", ERROR_NONE };
+  }
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// WebSocket-only: cap this client's status update rate
+CommandResult runSetStatusRate(uint8_t num, JsonVariantConst args) {
+  if (!args.containsKey("maxRate")) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  
+  int hz = args["maxRate"];
+  if (hz < 0) {
+    return { 400, "error", "Invalid value", ERROR_NONE };
+  }
+  
+  statusPublisher.setMaxRate(num, hz);
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// WebSocket-only: switch this client between JSON and binary status
+// frames, optionally delta-encoded. Sent by clients right after connect.
+CommandResult runSetStatusFormat(uint8_t num, JsonVariantConst args) {
+  const char* format = args["format"];
+  if (!format) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  
+  if (strcmp(format, "json") == 0) {
+    statusPublisher.setFormat(num, STATUS_FORMAT_JSON, false);
+  } else if (strcmp(format, "binary") == 0) {
+    statusPublisher.setFormat(num, STATUS_FORMAT_BINARY, args["delta"] | false);
+  } else {
+    return { 400, "error", "Invalid value", ERROR_NONE };
+  }
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// WebSocket-only: choose which axes' status this client receives:
+// {"axes": [0, 1]}
+CommandResult runSetStatusAxes(uint8_t num, JsonVariantConst args) {
+  JsonArrayConst axes = args["axes"];
+  if (axes.isNull() || axes.size() == 0) {
+    return { 400, "error", "Invalid request", ERROR_NONE };
+  }
+  
+  uint8_t mask = 0;
+  for (JsonVariantConst value : axes) {
+    int axis = value | -1;
+    if (!value.is<int>() || axis < 0 || axis >= AXIS_COUNT) {
+      return { 400, "error", "Invalid axis", ERROR_NONE };
+    }
+    mask |= 1 << axis;
+  }
+  
+  statusPublisher.setAxes(num, mask);
+  return { 200, "success", nullptr, ERROR_NONE };
+}
+
+// Map a WebSocket "cmd" onto the matching command; names follow the
+// REST paths under /api
+CommandResult runWebSocketCommand(uint8_t num, const char* cmd, JsonVariantConst args) {
+  if (strcmp(cmd, "position") == 0) return runSetPosition(args);
+  if (strcmp(cmd, "nudge") == 0) return runNudge(args);
+  if (strcmp(cmd, "speed") == 0) return runSetSpeed(args);
+  if (strcmp(cmd, "zero") == 0) return runZero(args);
+  if (strcmp(cmd, "stop") == 0) return runEmergencyStop(args);
+  if (strcmp(cmd, "move") == 0) return runMove(args);
+  if (strcmp(cmd, "settings/max") == 0) return runSetMaxSteps(args);
+  if (strcmp(cmd, "settings/stepsperrot") == 0) return runSetStepsPerRotation(args);
+  if (strcmp(cmd, "settings/backlash") == 0) return runSetBacklash(args);
+  if (strcmp(cmd, "sequence") == 0) return runSequence(args);
+  if (strcmp(cmd, "autofocus") == 0) return runAutofocus(args);
+  if (strcmp(cmd, "autofocus/metric") == 0) return runAutofocusMetric(args);
+  if (strcmp(cmd, "autofocus/cancel") == 0) return runAutofocusCancel();
+  if (strcmp(cmd, "trace") == 0) return runSetTrace(args);
+  if (strcmp(cmd, "record") == 0) return runSetRecord(args);
+  if (strcmp(cmd, "status") == 0) return { 200, "success", nullptr, ERROR_NONE };
+  if (strcmp(cmd, "rate") == 0) return runSetStatusRate(num, args);
+  if (strcmp(cmd, "format") == 0) return runSetStatusFormat(num, args);
+  if (strcmp(cmd, "axes") == 0) return runSetStatusAxes(num, args);
+  return { 400, "error", "Unknown command", ERROR_NONE };
 }
 
 // ----------------------------------------------------------------
-// HTML Interface
+// Helper Functions
 // ----------------------------------------------------------------
-String getHTML() {
-  return String(HTML_PAGE);
+ErrorCode parseJSONRequest(const String& body, JsonDocument& doc) {
+  // Buffer overflow protection
+  if (body.length() > 1024) {
+    return ERROR_BUFFER_OVERFLOW;
+  }
+  
+  DeserializationError error = deserializeJson(doc, body);
+  if (error) {
+    Serial.print("JSON parse error: ");
+    Serial.println(error.c_str());
+    return ERROR_INVALID_JSON;
+  }
+  
+  return ERROR_NONE;
+}
+
+// As parseJSONRequest, but an empty body is allowed (doc stays null)
+ErrorCode parseOptionalJSONRequest(const String& body, JsonDocument& doc) {
+  if (body.length() == 0) {
+    return ERROR_NONE;
+  }
+  return parseJSONRequest(body, doc);
+}
+
+// The axis a command names in its "axis" field, or fallback when it has
+// none. False if the field is not a valid axis.
+bool readAxis(JsonVariantConst args, int& axis, int fallback) {
+  JsonVariantConst value = args["axis"];
+  if (value.isNull()) {
+    axis = fallback;
+    return true;
+  }
+  if (!value.is<int>()) {
+    return false;
+  }
+  axis = value.as<int>();
+  return axis >= 0 && axis < AXIS_COUNT;
+}
+
+// The ?axis= query argument of a GET, 0 when absent
+bool readAxisArg(int& axis) {
+  axis = server.hasArg("axis") ? server.arg("axis").toInt() : 0;
+  return axis >= 0 && axis < AXIS_COUNT;
+}
+
+// NVS key of an axis's fallback position; axis 0 keeps the key older
+// firmware used
+const char* positionKey(int axis, char* buffer) {
+  if (axis == 0) return "position";
+  sprintf(buffer, "position%d", axis);
+  return buffer;
+}
+
+void sendJSONResponse(int code, const char* status, const char* message, ErrorCode error) {
+  StaticJsonDocument<200> doc;
+  doc["status"] = status;
+  
+  if (message) {
+    doc["message"] = message;
+  }
+  
+  if (error != ERROR_NONE) {
+    doc["errorCode"] = error;
+  }
+  
+  String output;
+  serializeJson(doc, output);
+  server.send(code, "application/json", output);
+}
+
+void sendCommandResult(const CommandResult& result) {
+  sendJSONResponse(result.code, result.status, result.message, result.error);
+}
+
+void sendWebSocketAck(uint8_t num, JsonVariantConst id, const CommandResult& result) {
+  StaticJsonDocument<200> doc;
+  doc["type"] = "ack";
+  doc["id"] = id;
+  doc["code"] = result.code;
+  doc["status"] = result.status;
+  
+  if (result.message) {
+    doc["message"] = result.message;
+  }
+  
+  if (result.error != ERROR_NONE) {
+    doc["errorCode"] = result.error;
+  }
+  
+  String output;
+  serializeJson(doc, output);
+  webSocket.sendTXT(num, output);
+}
+
+// Journal each axis's position when it has come to rest somewhere new.
+// Flash writes stall both cores, so nothing is written mid-move.
+bool validateAndSavePosition() {
+  bool running = false;
+  MotorStatus statuses[AXIS_COUNT];
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    statuses[axis] = statusSnapshots[axis].read();
+    running = running || statuses[axis].state == STATE_RUNNING;
+  }
+  if (running) {
+    return false;
+  }
+  
+  bool saved = false;
+  for (int axis = 0; axis < AXIS_COUNT; axis++) {
+    const MotorStatus& status = statuses[axis];
+    if (status.position != status.target ||
+        (status.position == lastSavedPosition[axis] && status.phase == lastSavedPhase[axis])) {
+      continue;
+    }
+  
+    // Only try each resting position once
+    lastSavedPosition[axis] = status.position;
+    lastSavedPhase[axis] = status.phase;
+    
+    ErrorCode error = checkPosition(status.position, status.maxSteps);
+    if (error == ERROR_HARD_LIMIT) {
+      Serial.println("ERROR: Position validation failed!");
+      continue;
+    }
+    
+    if (!positionJournal.append(axis, status.position, status.phase)) {
+      if (positionJournal.isReady()) {
+        Serial.println("ERROR: Position journal write failed, saving to NVS");
+      }
+      char key[16];
+      preferences.putInt(positionKey(axis, key), status.position);
+    }
+    saved = true;
+  }
+  return saved;
 }
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""
+Compress the web UI for the firmware.
+
+Reads HTML_PAGE from web_interface.h, gzips it and writes
+web_interface_gz.h with the compressed bytes as a PROGMEM array and an
+ETag derived from the page content. Run it after every change to
+web_interface.h and commit both files:
+
+    python3 tools/build_web_ui.py
+"""
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+SKETCH_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(SKETCH_DIR, "web_interface.h")
+OUTPUT = os.path.join(SKETCH_DIR, "web_interface_gz.h")
+BYTES_PER_LINE = 16
+
+
+def read_page(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    match = re.search(r'HTML_PAGE\[\] PROGMEM = R"rawliteral\((.*)\)rawliteral"', text, re.S)
+    if not match:
+        sys.exit("HTML_PAGE raw literal not found in " + path)
+    return match.group(1).encode("utf-8")
+
+
+def main():
+    page = read_page(SOURCE)
+    # mtime=0 keeps the output identical for identical input
+    compressed = gzip.compress(page, compresslevel=9, mtime=0)
+    etag = hashlib.sha256(page).hexdigest()[:16]
+
+    lines = []
+    for i in range(0, len(compressed), BYTES_PER_LINE):
+        chunk = compressed[i:i + BYTES_PER_LINE]
+        lines.append("  " + ", ".join("0x%02x" % b for b in chunk) + ",")
+
+    with open(OUTPUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write("/*\n")
+        f.write(" * Web Interface - gzip-compressed\n")
+        f.write(" *\n")
+        f.write(" * Generated by tools/build_web_ui.py from web_interface.h.\n")
+        f.write(" * Do not edit; regenerate after changing the UI.\n")
+        f.write(" */\n\n")
+        f.write("#ifndef WEB_INTERFACE_GZ_H\n")
+        f.write("#define WEB_INTERFACE_GZ_H\n\n")
+        f.write("#include <Arduino.h>\n\n")
+        f.write("// %d bytes uncompressed\n" % len(page))
+        f.write('#define HTML_PAGE_ETAG "\\"%s\\""\n' % etag)
+        f.write("#define HTML_PAGE_GZ_SIZE %d\n\n" % len(compressed))
+        f.write("const uint8_t HTML_PAGE_GZ[] PROGMEM = {\n")
+        f.write("\n".join(lines) + "\n")
+        f.write("};\n\n")
+        f.write("#endif // WEB_INTERFACE_GZ_H\n")
+
+    print("%s: %d -> %d bytes, ETag %s" % (os.path.basename(OUTPUT), len(page), len(compressed), etag))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Convert a step trace from GET /api/trace to CSV.
+
+    curl -o steptrace.bin http://<focuser>/api/trace
+    python3 tools/decode_trace.py steptrace.bin > steptrace.csv
+
+The binary format is described at the top of StepTrace.h. Each CSV row
+is one step: absolute time and position are rebuilt from the header's
+base values and the per-step deltas.
+"""
+
+import csv
+import struct
+import sys
+
+HEADER = struct.Struct("<4sBBHIIi")
+RECORD = struct.Struct("<IhBB")
+
+STEP_REVERSE = 0x01
+STEP_SLACK = 0x02
+STEP_FROM_REST = 0x04
+STEP_RESYNC = 0x08
+
+TRACE_WRAPPED = 0x0001
+TRACE_OVERFLOWED = 0x0002
+
+
+COLUMNS = ["step", "time_us", "interval_us", "lateness_us", "position",
+           "phase", "direction", "slack", "from_rest", "resync"]
+
+
+def read_trace(data):
+    """Yield one row per step, in COLUMNS order."""
+    if len(data) < HEADER.size:
+        sys.exit("File too short for a trace header")
+    magic, version, record_size, flags, count, base_time, base_position = HEADER.unpack_from(data)
+    if magic != b"STRC":
+        sys.exit("Not a step trace")
+    if version != 1 or record_size != RECORD.size:
+        sys.exit("Unsupported trace version %d" % version)
+
+    available = (len(data) - HEADER.size) // record_size
+    if available < count:
+        print("warning: trace truncated, %d of %d records" % (available, count), file=sys.stderr)
+        count = available
+    if flags & TRACE_WRAPPED:
+        print("warning: ring wrapped, oldest steps were overwritten", file=sys.stderr)
+    if flags & TRACE_OVERFLOWED:
+        print("warning: trace stopped early, the motion task fell behind", file=sys.stderr)
+
+    time = base_time
+    position = base_position
+    offset = HEADER.size
+    for i in range(count):
+        interval, lateness, phase, step_flags = RECORD.unpack_from(data, offset)
+        offset += record_size
+
+        direction = -1 if step_flags & STEP_REVERSE else 1
+        slack = bool(step_flags & STEP_SLACK)
+        time = (time + interval) & 0xFFFFFFFF
+        if not slack:
+            position += direction
+
+        yield (i, time, interval, lateness, position, phase, direction,
+               int(slack), int(bool(step_flags & STEP_FROM_REST)),
+               int(bool(step_flags & STEP_RESYNC)))
+
+
+def decode(data, out):
+    writer = csv.writer(out)
+    writer.writerow(COLUMNS)
+    writer.writerows(read_trace(data))
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: decode_trace.py <steptrace.bin>")
+    with open(sys.argv[1], "rb") as f:
+        decode(f.read(), sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
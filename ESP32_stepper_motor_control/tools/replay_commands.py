@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""
+Replay a command recording from GET /api/record against a focuser.
+
+    curl -o commands.ndjson http://<focuser>/api/record
+    python3 tools/replay_commands.py commands.ndjson <bench-focuser> > run.json
+    python3 tools/replay_commands.py commands.ndjson --sim host/build/replay > run.json
+
+Commands are sent at their recorded offsets (--speedup compresses the
+gaps) over REST; WebSocket commands go to the matching REST route, since
+both run the same handler code. Recorder and trace controls in the
+recording are skipped, as are WebSocket-only commands (status, rate,
+format, axes). A step trace runs for the whole replay. Once the motor settles
+the tool prints a JSON report: commands sent and rejected, step interval
+and lateness statistics, and the final status. Diff the reports of two
+firmware builds to see a timing regression; --trajectory also writes the
+per-step trace as CSV.
+
+--sim replays on the host build instead (host/replay.cpp): the firmware
+runs on the simulator's virtual clock, each record reaches the handler it
+reached on the device (WebSocket messages included) at its recorded
+offset, and the run takes as long as the simulation, not the recording.
+The report is the same, so a simulated run can be diffed against a live
+one or against another build's.
+"""
+
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.error
+import urllib.request
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from decode_trace import COLUMNS, read_trace  # noqa: E402
+
+# WebSocket cmd -> REST route running the same command
+WS_ROUTES = {
+    "position": "/api/position",
+    "nudge": "/api/nudge",
+    "speed": "/api/speed",
+    "zero": "/api/zero",
+    "stop": "/api/stop",
+    "move": "/api/move",
+    "settings/max": "/api/settings/max",
+    "settings/stepsperrot": "/api/settings/stepsperrot",
+    "settings/backlash": "/api/settings/backlash",
+    "sequence": "/api/sequence",
+    "autofocus": "/api/autofocus",
+    "autofocus/metric": "/api/autofocus/metric",
+    "autofocus/cancel": "/api/autofocus/cancel",
+}
+
+SKIPPED_ROUTES = {"/api/record", "/api/trace", "/api/reboot"}
+
+
+def request(base, path, body=None, timeout=10):
+    data = body.encode() if body is not None else None
+    req = urllib.request.Request(base + path, data=data, method="POST" if body is not None else "GET")
+    if data is not None:
+        req.add_header("Content-Type", "application/json")
+    try:
+        with urllib.request.urlopen(req, timeout=timeout) as reply:
+            return reply.status, reply.read()
+    except urllib.error.HTTPError as e:
+        return e.code, e.read()
+
+
+def load(path):
+    """Return the recording as (offset_us, route, body) in arrival order."""
+    with open(path) as f:
+        lines = [json.loads(line) for line in f if line.strip()]
+    if not lines or lines[0].get("version") != 1:
+        sys.exit("Not a version 1 command recording")
+    if lines[0].get("dropped"):
+        print("warning: %d oldest commands were dropped" % lines[0]["dropped"], file=sys.stderr)
+
+    commands = []
+    start = None
+    elapsed = 0
+    last = None
+    for record in lines[1:]:
+        # micros() wraps every ~71 minutes
+        if last is not None:
+            elapsed += (record["t"] - last) & 0xFFFFFFFF
+        last = record["t"]
+        if record.get("truncated"):
+            print("warning: command %d was truncated, skipped" % record["seq"], file=sys.stderr)
+            continue
+
+        if record["src"] == "rest":
+            route = record["uri"]
+        else:
+            try:
+                route = WS_ROUTES.get(json.loads(record["body"]).get("cmd"))
+            except ValueError:
+                route = None
+        if route is None or route in SKIPPED_ROUTES:
+            continue
+        if start is None:
+            start = elapsed
+        commands.append((elapsed - start, route, record["body"]))
+    return commands
+
+
+def percentile(values, fraction):
+    if not values:
+        return None
+    ordered = sorted(values)
+    return ordered[min(len(ordered) - 1, int(len(ordered) * fraction))]
+
+
+def stats(values):
+    if not values:
+        return {"count": 0}
+    return {
+        "count": len(values),
+        "min": min(values),
+        "mean": round(sum(values) / len(values), 1),
+        "p50": percentile(values, 0.50),
+        "p99": percentile(values, 0.99),
+        "max": max(values),
+    }
+
+
+def wait_until_idle(base, timeout):
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        code, body = request(base, "/api/status")
+        if code == 200:
+            status = json.loads(body)
+            if not status.get("running"):
+                return status
+        time.sleep(0.2)
+    sys.exit("Motor still running after %d s" % timeout)
+
+
+def replay_live(args, commands):
+    """Send the commands to a focuser; return (sent, rejections, trace, final status)."""
+    base = "http://" + args.host
+    code, body = request(base, "/api/trace", json.dumps({"enabled": True}))
+    if code != 200:
+        sys.exit("Could not start a step trace: %d %s" % (code, body.decode(errors="replace")))
+
+    sent = 0
+    rejected = []
+    start = time.monotonic()
+    for offset, route, body in commands:
+        delay = start + offset / 1e6 / args.speedup - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+        code, reply = request(base, route, body)
+        sent += 1
+        if code != 200:
+            rejected.append({"route": route, "code": code, "reply": reply.decode(errors="replace")})
+
+    final = wait_until_idle(base, args.settle)
+    request(base, "/api/trace", json.dumps({"enabled": False}))
+    time.sleep(0.2)                # Trace stops on the motion task's next pass
+    code, data = request(base, "/api/trace", timeout=60)
+    if code != 200:
+        sys.exit("Could not download the step trace: %d" % code)
+    return sent, rejected, data, final
+
+
+def replay_sim(args):
+    """Run the host replay driver on the recording; same results as replay_live."""
+    with tempfile.TemporaryDirectory() as tmp:
+        trace_path = os.path.join(tmp, "steptrace.bin")
+        run = subprocess.run([args.sim, args.recording, "--trace", trace_path], stdout=subprocess.PIPE,
+                             env=dict(os.environ, HOST_QUIET="1"))
+        if run.returncode == 2:
+            sys.exit("%s could not replay %s" % (args.sim, args.recording))
+        if run.returncode != 0:
+            sys.exit("Motor still running after the simulated replay")
+        result = json.loads(run.stdout)
+        with open(trace_path, "rb") as f:
+            data = f.read()
+    commands = result["commands"]
+    return commands["sent"], commands["rejections"], data, result["final"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    parser.add_argument("recording", help="file saved from GET /api/record")
+    parser.add_argument("host", nargs="?", help="focuser address, e.g. 192.168.1.50")
+    parser.add_argument("--sim", metavar="REPLAY", help="replay on the host build's replay binary instead")
+    parser.add_argument("--speedup", type=float, default=1.0, help="divide recorded gaps by this")
+    parser.add_argument("--settle", type=int, default=120, help="seconds to wait for the motor to stop")
+    parser.add_argument("--trajectory", help="also write the step trace as CSV to this file")
+    args = parser.parse_args()
+    if (args.host is None) == (args.sim is None):
+        parser.error("give either a focuser address or --sim")
+
+    if args.sim:
+        sent, rejected, data, final = replay_sim(args)
+    else:
+        sent, rejected, data, final = replay_live(args, load(args.recording))
+    steps = list(read_trace(data))
+
+    if args.trajectory:
+        with open(args.trajectory, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(COLUMNS)
+            writer.writerows(steps)
+
+    report = {
+        "commands": {"sent": sent, "rejected": len(rejected), "rejections": rejected},
+        "steps": len(steps),
+        # The first step's interval runs from the trace start, not a step
+        "intervalUs": stats([s[2] for s in steps[1:]]),
+        "latenessUs": stats([s[3] for s in steps]),
+        "resyncs": sum(s[9] for s in steps),
+        "final": final,
+    }
+    json.dump(report, sys.stdout, indent=2)
+    print()
+
+
+if __name__ == "__main__":
+    main()
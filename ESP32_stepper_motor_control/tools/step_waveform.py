@@ -0,0 +1,355 @@
+#!/usr/bin/env python3
+"""
+Generate and check the coil waveforms StepStream.h plays through the RMT.
+
+    python3 tools/step_waveform.py generate --steps 3000 --speed 1000 --accel 4000 move.wave
+    python3 tools/step_waveform.py generate --trace steptrace.bin move.wave
+    python3 tools/step_waveform.py verify move.wave > report.json
+    host/build/stream_wave move.wave && python3 tools/step_waveform.py verify move.wave
+
+generate expands a list of steps into the four per-coil RMT symbol
+streams with the same rules as the firmware's encoder (the layout is at
+the top of StepStream.h). The steps come from a synthetic trapezoidal
+move in drive steps, or from a step trace: recorded with STEP_STREAM
+set, a trace holds each step's planned time, so the waveform the board
+would play can be rebuilt off-board. verify reads a waveform file back,
+plays it the way the RMT would and checks it: every half in range, the
+coils' halves identical, each coil pattern change a single step of the
+drive sequence landing exactly on its planned time, and the encoder's
+read-ahead inside the lookahead. It prints a JSON report of step
+interval statistics and exits non-zero if any check fails. The host
+build's stream_wave writes a waveform from the firmware's own encoders
+(see host/stream_wave.cpp), so verify checks those too, not only this
+tool's copy of them. The stream constants and coil sequences are read
+from Config.h.
+
+Waveform file, little-endian:
+    header   "SWAV", version (1), drive mode, flags (0), max half (ticks),
+             step count, symbol count per coil, lookahead (us), end time
+    steps    time (us), position, phase, 3 pad bytes; one per step
+    symbols  coil A's symbols, then B, C and D (rmt_symbol_word_t)
+"""
+
+import argparse
+import json
+import math
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from decode_trace import read_trace  # noqa: E402
+
+HEADER = struct.Struct("<4sBBHHIIII")
+STEP = struct.Struct("<IiB3x")
+SYMBOL = struct.Struct("<I")
+
+CONFIG_H = os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "Config.h")
+RMT_MEM_SYMBOLS = 48               # SOC_RMT_MEM_WORDS_PER_CHANNEL on the ESP32-S3
+RMT_REFILL_SYMBOLS = RMT_MEM_SYMBOLS // 2
+
+
+def read_config(path):
+    """The stream constants and the coil sequences (coils A B C D, by
+    DRIVE_MODE) from the firmware's Config.h, so the two cannot drift."""
+    try:
+        with open(path) as f:
+            text = f.read()
+    except OSError as e:
+        sys.exit("Cannot read %s: %s" % (path, e))
+    defines = dict(re.findall(r"^#define\s+(\w+)\s+(\d+)\b", text, re.M))
+
+    def define(name):
+        if name not in defines:
+            sys.exit("%s: no #define %s" % (path, name))
+        return int(defines[name])
+
+    def sequence(name):
+        body = re.search(r"\b%s\[\d+\]\[4\]\s*=\s*\{(.*?)\};" % name, text, re.S)
+        if body is None:
+            sys.exit("%s: no %s" % (path, name))
+        rows = re.findall(r"\{\s*([01])\s*,\s*([01])\s*,\s*([01])\s*,\s*([01])\s*\}", body.group(1))
+        return [tuple(int(bit) for bit in row) for row in rows]
+
+    drives = {"wave": define("DRIVE_WAVE"), "full": define("DRIVE_FULL_STEP"),
+              "half": define("DRIVE_HALF_STEP")}
+    sequences = {
+        drives["wave"]: sequence("waveSequence"),
+        drives["full"]: sequence("fullStepSequence"),
+        drives["half"]: sequence("stepSequence"),
+    }
+    return (define("STREAM_MAX_HALF"), define("STREAM_SCRATCH_SYMBOLS"),
+            define("STREAM_LOOKAHEAD_US"), sequences, drives)
+
+
+(STREAM_MAX_HALF, STREAM_SCRATCH_SYMBOLS, STREAM_LOOKAHEAD_US,
+ SEQUENCES, DRIVE_NAMES) = read_config(CONFIG_H)
+
+
+def coil_bits(coils):
+    return sum(bit << coil for coil, bit in enumerate(coils))
+
+
+# ----------------------------------------------------------------
+# Step lists: (time, position, phase), in time order
+# ----------------------------------------------------------------
+
+def trapezoid_steps(steps, speed, accel, phase, phases):
+    """A move of steps drive steps from rest at time 0. Returns the steps
+    and the time the axis comes to rest."""
+    direction = 1 if steps >= 0 else -1
+    count = abs(steps)
+    ramp = min(speed * speed / (2.0 * accel), count / 2.0)
+    peak = math.sqrt(2.0 * accel * ramp)
+    ramp_time = peak / accel
+    cruise_time = (count - 2.0 * ramp) / peak if peak > 0 else 0.0
+
+    def time_at(distance):
+        if distance <= ramp:
+            return math.sqrt(2.0 * distance / accel)
+        if distance <= count - ramp:
+            return ramp_time + (distance - ramp) / peak
+        left = count - distance
+        return 2.0 * ramp_time + cruise_time - math.sqrt(2.0 * left / accel)
+
+    # Step i is taken once the axis has covered i of them, the first at 0
+    out = []
+    for i in range(count):
+        phase = (phase + direction) % phases
+        out.append((int(round(time_at(i) * 1e6)), (i + 1) * direction, phase))
+    end = int(round((2.0 * ramp_time + cruise_time) * 1e6))
+    return out, max(end, out[-1][0] + 1) if out else 0
+
+
+def trace_steps(data):
+    """Steps from a trace, rebased to start at 0; the axis is taken to
+    rest one interval after the last step."""
+    rows = list(read_trace(data))
+    if not rows:
+        sys.exit("Trace holds no steps")
+    base = rows[0][1]
+    out = [((row[1] - base) & 0xFFFFFFFF, row[4], row[5]) for row in rows]
+    last = out[-1][0] - out[-2][0] if len(out) > 1 else STREAM_MAX_HALF
+    return out, out[-1][0] + last
+
+
+# ----------------------------------------------------------------
+# Encoding, as StepStream's coil encoders do it
+# ----------------------------------------------------------------
+
+def expand(steps, end, max_half):
+    """Symbol halves (duration, phase) for the whole stream; phase None is
+    the 1-tick low half that pads a 1-tick odd last half."""
+    halves = []
+    for i, (time, _, phase) in enumerate(steps):
+        stop = steps[i + 1][0] if i + 1 < len(steps) else end
+        remaining = stop - time
+        pieces = -(-remaining // max_half)
+        for left in range(pieces, 0, -1):
+            piece = -(-remaining // left)
+            halves.append((piece, phase))
+            remaining -= piece
+    if len(halves) % 2:
+        duration, phase = halves.pop()
+        if duration > 1:
+            halves.append((duration - duration // 2, phase))
+            halves.append((duration // 2, phase))
+        else:
+            halves.append((duration, phase))
+            halves.append((1, None))
+    return halves
+
+
+def encode(steps, end, drive, max_half):
+    levels = [coil_bits(c) for c in SEQUENCES[drive]]
+    halves = expand(steps, end, max_half)
+    coils = []
+    for coil in range(4):
+        words = []
+        for i in range(0, len(halves), 2):
+            word = 0
+            for shift, (duration, phase) in ((0, halves[i]), (16, halves[i + 1])):
+                level = (levels[phase] >> coil) & 1 if phase is not None else 0
+                word |= (duration | (level << 15)) << shift
+            words.append(word)
+        coils.append(words)
+    return coils
+
+
+def write_wave(path, drive, max_half, steps, end, coils):
+    with open(path, "wb") as f:
+        f.write(HEADER.pack(b"SWAV", 1, drive, 0, max_half, len(steps), len(coils[0]),
+                            STREAM_LOOKAHEAD_US, end))
+        for time, position, phase in steps:
+            f.write(STEP.pack(time, position, phase))
+        for words in coils:
+            for word in words:
+                f.write(SYMBOL.pack(word))
+
+
+def read_wave(data):
+    if len(data) < HEADER.size:
+        sys.exit("File too short for a waveform header")
+    magic, version, drive, _, max_half, step_count, symbol_count, lookahead, end = \
+        HEADER.unpack_from(data)
+    if magic != b"SWAV" or version != 1 or drive not in SEQUENCES:
+        sys.exit("Not a version 1 step waveform")
+    if len(data) != HEADER.size + step_count * STEP.size + 4 * symbol_count * SYMBOL.size:
+        sys.exit("Waveform file is truncated")
+    offset = HEADER.size
+    steps = []
+    for _ in range(step_count):
+        steps.append(STEP.unpack_from(data, offset))
+        offset += STEP.size
+    coils = []
+    for _ in range(4):
+        coils.append([SYMBOL.unpack_from(data, offset + 4 * i)[0] for i in range(symbol_count)])
+        offset += 4 * symbol_count
+    return drive, max_half, lookahead, end, steps, coils
+
+
+# ----------------------------------------------------------------
+# Checks
+# ----------------------------------------------------------------
+
+def verify(data):
+    drive, max_half, lookahead, end, steps, coils = read_wave(data)
+    sequence = [coil_bits(c) for c in SEQUENCES[drive]]
+    phases = len(sequence)
+    errors = []
+
+    def fail(message):
+        if len(errors) < 20:
+            errors.append(message)
+
+    # Halves as the RMT reads them, with every coil's level
+    halves = []
+    for i in range(len(coils[0])):
+        for shift in (0, 16):
+            durations = {(coils[c][i] >> shift) & 0x7FFF for c in range(4)}
+            if len(durations) != 1:
+                fail("symbol %d: coils disagree on duration %s" % (i, sorted(durations)))
+            duration = min(durations)
+            if duration == 0:
+                fail("symbol %d: zero duration would end the transmission" % i)
+            elif duration > max_half:
+                fail("symbol %d: %d ticks over the %d tick limit" % (i, duration, max_half))
+            bits = sum(((coils[c][i] >> (shift + 15)) & 1) << c for c in range(4))
+            halves.append((duration, bits))
+
+    # A 1-tick all-low half after a 1-tick one pads an odd count; the
+    # coils go low when the transmission ends in any case
+    if len(halves) >= 2 and halves[-1] == (1, 0) and halves[-2][0] == 1:
+        halves.pop()
+
+    # Replay: every pattern change is a step
+    played = []
+    time = 0
+    pattern = None
+    for duration, bits in halves:
+        if bits != pattern:
+            if bits not in sequence:
+                fail("t=%d: coil pattern %s is not in the drive sequence" % (time, format(bits, "04b")))
+            elif pattern is not None and pattern in sequence:
+                moved = (sequence.index(bits) - sequence.index(pattern)) % phases
+                if moved not in (1, phases - 1):
+                    fail("t=%d: phase jumps %d steps" % (time, min(moved, phases - moved)))
+            played.append((time, sequence.index(bits) if bits in sequence else -1))
+            pattern = bits
+        time += duration
+    if time != end:
+        fail("waveform lasts %d us, the stream ends at %d" % (time, end))
+
+    if len(played) != len(steps):
+        fail("%d steps played, %d planned" % (len(played), len(steps)))
+    worst = 0
+    for (t, phase), (planned, _, planned_phase) in zip(played, steps):
+        worst = max(worst, abs(t - planned))
+        if phase != planned_phase:
+            fail("step at %d: phase %d, planned %d" % (planned, phase, planned_phase))
+    if worst:
+        fail("steps land up to %d us from their planned times" % worst)
+
+    # The encoder keeps channel memory and its scratch full, so it reads
+    # this many symbols ahead of playback
+    window = RMT_MEM_SYMBOLS + STREAM_SCRATCH_SYMBOLS
+    symbol_time = [halves[2 * i][0] + halves[2 * i + 1][0] for i in range(len(halves) // 2)]
+    readahead = span = 0
+    for i, duration in enumerate(symbol_time):
+        span += duration
+        if i >= window:
+            span -= symbol_time[i - window]
+        readahead = max(readahead, span)
+    if readahead >= lookahead:
+        fail("encoder reads %d us ahead, past the %d us lookahead" % (readahead, lookahead))
+
+    intervals = [b[0] - a[0] for a, b in zip(steps, steps[1:])]
+    report = {
+        "ok": not errors,
+        "errors": errors,
+        "drive": {v: k for k, v in DRIVE_NAMES.items()}[drive],
+        "steps": len(steps),
+        "duration_us": end,
+        "symbols_per_coil": len(coils[0]),
+        "refill_interrupts": 4 * (len(coils[0]) // RMT_REFILL_SYMBOLS),
+        "readahead_us": readahead,
+        "lookahead_us": lookahead,
+        "max_timing_error_us": worst,
+    }
+    if intervals:
+        report["interval_us"] = {
+            "min": min(intervals),
+            "max": max(intervals),
+            "mean": round(sum(intervals) / len(intervals), 1),
+        }
+        report["peak_rate_hz"] = round(1e6 / min(intervals), 1) if min(intervals) else None
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate and check RMT step waveforms")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    gen = commands.add_parser("generate", help="expand steps into a waveform file")
+    gen.add_argument("output")
+    gen.add_argument("--trace", help="step trace from GET /api/trace")
+    gen.add_argument("--steps", type=int, default=3000, help="synthetic move length (drive steps)")
+    gen.add_argument("--speed", type=float, default=1000.0, help="cruise speed (drive steps/s)")
+    gen.add_argument("--accel", type=float, default=4000.0, help="acceleration (drive steps/s^2)")
+    gen.add_argument("--phase", type=int, default=0, help="coil phase before the move")
+    gen.add_argument("--drive", choices=sorted(DRIVE_NAMES), default="half")
+    gen.add_argument("--max-half", type=int, default=STREAM_MAX_HALF,
+                     help="STREAM_MAX_HALF the firmware was built with")
+
+    check = commands.add_parser("verify", help="check a waveform file")
+    check.add_argument("input")
+
+    args = parser.parse_args()
+    if args.command == "generate":
+        drive = DRIVE_NAMES[args.drive]
+        if not 1 < args.max_half <= 0x7FFF:
+            sys.exit("--max-half must be 2..32767")
+        if args.trace:
+            with open(args.trace, "rb") as f:
+                steps, end = trace_steps(f.read())
+        else:
+            if args.steps == 0 or args.speed <= 0 or args.accel <= 0:
+                sys.exit("--steps, --speed and --accel must be non-zero and positive")
+            steps, end = trapezoid_steps(args.steps, args.speed, args.accel, args.phase,
+                                         len(SEQUENCES[drive]))
+        coils = encode(steps, end, drive, args.max_half)
+        write_wave(args.output, drive, args.max_half, steps, end, coils)
+        print("%d steps, %.3f s, %d symbols per coil" % (len(steps), end / 1e6, len(coils[0])),
+              file=sys.stderr)
+    else:
+        with open(args.input, "rb") as f:
+            report = verify(f.read())
+        json.dump(report, sys.stdout, indent=2)
+        print()
+        if not report["ok"]:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
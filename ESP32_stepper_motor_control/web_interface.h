@@ -438,8 +438,8 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
                     <div class="section-title">Speed: <span id="speedVal" style="color:var(--primary)">250</span></div>
                     <div class="slider-container">
                         <span style="font-size:0.8rem">50</span>
-                        <input type="range" id="speedSlider" min="50" max="600" step="10" onchange="commitSpeed()" oninput="previewSpeed(this.value)">
-                        <span style="font-size:0.8rem">600</span>
+                        <input type="range" id="speedSlider" min="50" max="1000" step="10" onchange="commitSpeed()" oninput="previewSpeed(this.value)">
+                        <span style="font-size:0.8rem">1000</span>
                     </div>
                 </div>
             </div>
@@ -495,6 +495,8 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
         // WebSocket connection
         let ws = null;
         let wsReconnectInterval = null;
+        let wsNextId = 1;
+        const wsPending = new Map();
         
         // State
         let state = { pos: 0, target: 0, speed: 250, running: false, stepsPerRot: 4096 };
@@ -511,10 +513,13 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
             
             try {
                 ws = new WebSocket(wsUrl);
+                ws.binaryType = 'arraybuffer';
                 
                 ws.onopen = () => {
                     console.log('WebSocket connected');
                     updateConnectionStatus(true);
+                    // Ask for compact binary status frames
+                    ws.send(JSON.stringify({ cmd: 'format', format: 'binary', delta: true }));
                     if(wsReconnectInterval) {
                         clearInterval(wsReconnectInterval);
                         wsReconnectInterval = null;
@@ -522,9 +527,22 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
                 };
                 
                 ws.onmessage = (event) => {
+                    if(event.data instanceof ArrayBuffer) {
+                        const data = decodeStatusFrame(event.data);
+                        if(data) updateUI(data);
+                        return;
+                    }
                     try {
                         const data = JSON.parse(event.data);
-                        updateUI(data);
+                        if(data.type === 'ack') {
+                            const resolve = wsPending.get(data.id);
+                            if(resolve) {
+                                wsPending.delete(data.id);
+                                resolve(data);
+                            }
+                        } else if(!data.type) {
+                            updateUI(data);
+                        }
                     } catch(e) {
                         console.error('Parse error:', e);
                     }
@@ -552,6 +570,37 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
             }
         }
         
+        // Binary status frame (see StatusEncoder.h); deltas apply to the
+        // last status received
+        function decodeStatusFrame(buf) {
+            const v = new DataView(buf);
+            if(v.getUint8(0) !== 1) return null;
+            const flags = v.getUint8(2);
+            const s = Object.assign({}, state, {
+                state: v.getUint8(3),
+                running: (flags & 1) !== 0,
+                nearLimit: (flags & 2) !== 0
+            });
+            if(v.getUint8(1) === 0) {
+                s.position = v.getInt32(4, true);
+                s.target = v.getInt32(8, true);
+                s.maxSteps = v.getInt32(12, true);
+                s.stepsPerRot = v.getInt32(16, true);
+                s.speed = v.getUint16(20, true);
+                s.percentage = v.getUint16(22, true) / 100;
+                return s;
+            }
+            const mask = v.getUint8(4);
+            let o = 5;
+            if(mask & 1) { s.position += v.getInt16(o, true); o += 2; }
+            if(mask & 2) { s.target = v.getInt32(o, true); o += 4; }
+            if(mask & 4) { s.speed = v.getUint16(o, true); o += 2; }
+            if(mask & 8) { s.maxSteps = v.getInt32(o, true); o += 4; }
+            if(mask & 16) { s.stepsPerRot = v.getInt32(o, true); o += 4; }
+            if(mask & 32) { s.percentage = v.getUint16(o, true) / 100; o += 2; }
+            return s;
+        }
+        
         function updateConnectionStatus(connected) {
             const dot = $('wsDot');
             const status = $('wsStatus');
@@ -638,6 +687,16 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
             if (document.activeElement !== $('stepsRotInput')) $('stepsRotInput').value = data.stepsPerRot;
         }
 
+        function showResult(data) {
+            if(data.status === 'error') {
+                showToast(data.message || 'Error occurred', 'error');
+            } else if(data.status === 'warning') {
+                showToast(data.message || 'Warning', 'warning');
+            } else if(data.message) {
+                showToast(data.message, 'success');
+            }
+        }
+
         // API Calls with error handling
         async function apiCall(endpoint, method = 'GET', body = null, paramName = null) {
             try {
@@ -651,15 +710,7 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
                 
                 const response = await fetch(endpoint, options);
                 const data = await response.json();
-                
-                if(data.status === 'error') {
-                    showToast(data.message || 'Error occurred', 'error');
-                } else if(data.status === 'warning') {
-                    showToast(data.message || 'Warning', 'warning');
-                } else if(data.message) {
-                    showToast(data.message, 'success');
-                }
-                
+                showResult(data);
                 return data;
             } catch(e) {
                 showToast('Connection error', 'error');
@@ -667,14 +718,40 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
             }
         }
 
+        // Send a command over the WebSocket and wait for its ack; falls
+        // back to the matching REST endpoint when the socket is down
+        function command(cmd, body = null, paramName = null) {
+            if(!ws || ws.readyState !== WebSocket.OPEN) {
+                return apiCall('/api/' + cmd, 'POST', body, paramName);
+            }
+            
+            const id = wsNextId++;
+            const msg = { cmd, id };
+            if(body !== null) msg[paramName] = body;
+            
+            return new Promise(resolve => {
+                const timer = setTimeout(() => {
+                    wsPending.delete(id);
+                    showToast('Command timed out', 'error');
+                    resolve(null);
+                }, 3000);
+                wsPending.set(id, data => {
+                    clearTimeout(timer);
+                    showResult(data);
+                    resolve(data);
+                });
+                ws.send(JSON.stringify(msg));
+            });
+        }
+
         function stopMotor() {
             vib();
-            apiCall('/api/stop', 'POST');
+            command('stop');
         }
 
         function nudge(steps) {
             vib();
-            apiCall('/api/nudge', 'POST', steps, 'steps');
+            command('nudge', steps, 'steps');
         }
 
         function previewSpeed(val) {
@@ -683,24 +760,24 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
 
         function commitSpeed() {
             const val = $('speedSlider').value;
-            apiCall('/api/speed', 'POST', parseInt(val), 'speed');
+            command('speed', parseInt(val), 'speed');
         }
 
         function goToPos() {
             const val = $('gotoInput').value;
             if(!val) return;
-            apiCall('/api/position', 'POST', parseInt(val), 'position');
+            command('position', parseInt(val), 'position');
             $('gotoInput').value = '';
         }
 
         function goToZero() {
             vib();
-            apiCall('/api/position', 'POST', 0, 'position');
+            command('position', 0, 'position');
         }
 
         function setZero() {
             if(confirm('Set current position as zero?')) {
-                apiCall('/api/zero', 'POST');
+                command('zero');
             }
         }
 
@@ -715,12 +792,12 @@ const char HTML_PAGE[] PROGMEM = R"rawliteral(
         }
 
         function saveCfg(type) {
-            const endpoint = type === 'max' ? '/api/settings/max' : '/api/settings/stepsperrot';
+            const cmd = type === 'max' ? 'settings/max' : 'settings/stepsperrot';
             const paramName = type === 'max' ? 'maxSteps' : 'stepsPerRot';
             const val = type === 'max' ? $('maxInput').value : $('stepsRotInput').value;
             if(!val) return;
-            apiCall(endpoint, 'POST', parseInt(val), paramName).then(() => {
-                showToast('Settings saved!', 'success');
+            command(cmd, parseInt(val), paramName).then(data => {
+                if(data && data.status === 'success') showToast('Settings saved!', 'success');
             });
         }
 
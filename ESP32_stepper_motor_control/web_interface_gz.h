@@ -0,0 +1,452 @@
+/*
+ * Web Interface - gzip-compressed
+ *
+ * Generated by tools/build_web_ui.py from web_interface.h.
+ * Do not edit; regenerate after changing the UI.
+ */
+
+#ifndef WEB_INTERFACE_GZ_H
+#define WEB_INTERFACE_GZ_H
+
+#include <Arduino.h>
+
+// 31122 bytes uncompressed
+#define HTML_PAGE_ETAG "\"d2ac5f87cf713f17\""
+#define HTML_PAGE_GZ_SIZE 6910
+
+const uint8_t HTML_PAGE_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcd, 0x3d, 0x69, 0x77, 0xe3, 0x36,
+  0x92, 0xdf, 0xfb, 0x57, 0x20, 0xea, 0xa4, 0x29, 0xa5, 0x75, 0x50, 0xb2, 0xe5, 0xb6, 0x65, 0xcb,
+  0x49, 0x9f, 0x99, 0x9e, 0x97, 0x3e, 0x5e, 0xdb, 0xc9, 0x6c, 0x36, 0x2f, 0x1f, 0x28, 0x12, 0x92,
+  0x18, 0x53, 0x04, 0x17, 0xa4, 0x2c, 0x3b, 0x3d, 0xfe, 0xef, 0x5b, 0x05, 0x80, 0x37, 0x78, 0xc8,
+  0x76, 0x66, 0xd7, 0x89, 0x5b, 0x14, 0x01, 0x14, 0x0a, 0x75, 0x17, 0x50, 0xa4, 0x9f, 0x9c, 0x7d,
+  0xf3, 0xe6, 0xd3, 0xeb, 0xcb, 0xdf, 0x3e, 0xbf, 0x25, 0xeb, 0x68, 0xe3, 0x9d, 0x3f, 0x39, 0xc3,
+  0x0f, 0xe2, 0x59, 0xfe, 0x6a, 0xde, 0xa1, 0x7e, 0x07, 0x6f, 0x50, 0xcb, 0x39, 0x7f, 0x42, 0xe0,
+  0xe7, 0x6c, 0x43, 0x23, 0x8b, 0xd8, 0x6b, 0x8b, 0x87, 0x34, 0x9a, 0x77, 0x7e, 0xb9, 0x7c, 0x37,
+  0x38, 0xee, 0x64, 0x9b, 0x7c, 0x6b, 0x43, 0xe7, 0x9d, 0x6b, 0x97, 0xee, 0x02, 0xc6, 0xa3, 0x0e,
+  0xb1, 0x99, 0x1f, 0x51, 0x1f, 0xba, 0xee, 0x5c, 0x27, 0x5a, 0xcf, 0x1d, 0x7a, 0xed, 0xda, 0x74,
+  0x20, 0xbe, 0xf4, 0x89, 0xeb, 0xbb, 0x91, 0x6b, 0x79, 0x83, 0xd0, 0xb6, 0x3c, 0x3a, 0x1f, 0x0f,
+  0xcd, 0x3e, 0xd9, 0x58, 0x37, 0xee, 0x66, 0xbb, 0xc9, 0xde, 0xda, 0x86, 0x94, 0x8b, 0xef, 0xd6,
+  0x02, 0x6e, 0xf9, 0x2c, 0x9e, 0x2f, 0x72, 0x23, 0x8f, 0x9e, 0xff, 0x4c, 0xfd, 0x90, 0xbc, 0x86,
+  0x59, 0x38, 0xf3, 0x3c, 0xca, 0xc9, 0xf5, 0x64, 0x68, 0x9e, 0x8d, 0x64, 0x9b, 0xec, 0x17, 0x46,
+  0xb7, 0xf1, 0x35, 0xfe, 0xfc, 0xe8, 0x6e, 0x10, 0x35, 0xb2, 0xe5, 0x5e, 0xd7, 0x58, 0x47, 0x51,
+  0x10, 0xce, 0x46, 0xa3, 0x25, 0x00, 0x08, 0x87, 0x2b, 0xc6, 0x56, 0x1e, 0xb5, 0x02, 0x37, 0x1c,
+  0xda, 0x6c, 0x33, 0xb2, 0xc3, 0x70, 0xf2, 0xc3, 0xd2, 0xda, 0xb8, 0xde, 0xed, 0xfc, 0x9f, 0x34,
+  0x7a, 0xc5, 0x2d, 0xd7, 0x0f, 0x9f, 0x7f, 0x60, 0x3e, 0x9b, 0xed, 0x56, 0xeb, 0xe8, 0xc7, 0x43,
+  0xd3, 0x3c, 0x7d, 0x61, 0x9a, 0xcf, 0x1c, 0x37, 0x0c, 0x3c, 0xeb, 0x76, 0x1e, 0xee, 0xac, 0xc0,
+  0xe8, 0x9d, 0x26, 0x33, 0x25, 0x17, 0x33, 0xce, 0x58, 0x44, 0xbe, 0x26, 0xdf, 0xf1, 0x67, 0x30,
+  0x58, 0xac, 0x66, 0xe4, 0xa9, 0x29, 0x7e, 0x4e, 0x0b, 0x4d, 0xe1, 0x96, 0x2f, 0x2d, 0x9b, 0x62,
+  0xbb, 0x85, 0xff, 0x55, 0xb4, 0x0f, 0xd6, 0xec, 0x9a, 0x72, 0xe8, 0x35, 0x5e, 0xe2, 0x7f, 0xc5,
+  0x5e, 0x01, 0x77, 0x37, 0x16, 0xbf, 0x85, 0xf6, 0x05, 0x1d, 0x4f, 0x0e, 0xec, 0x62, 0x7b, 0x44,
+  0x6f, 0xa2, 0xc1, 0x06, 0x16, 0x05, 0x3d, 0xe8, 0x84, 0x1e, 0x2f, 0x4d, 0x7d, 0x8f, 0x6d, 0x44,
+  0x1d, 0xe8, 0x72, 0x72, 0x68, 0x1d, 0x2c, 0x8e, 0x8b, 0x5d, 0x1c, 0x90, 0x13, 0x81, 0xc3, 0x8b,
+  0xe5, 0xd8, 0x19, 0x3b, 0x65, 0x4c, 0x6d, 0x9b, 0x86, 0x21, 0xb4, 0x4f, 0x26, 0xf6, 0x74, 0x4a,
+  0x8b, 0xed, 0x3b, 0x8b, 0xfb, 0xae, 0x8f, 0x94, 0x58, 0x2e, 0x16, 0xcb, 0xc9, 0x61, 0xb1, 0x9d,
+  0x5b, 0x8e, 0xbb, 0x85, 0xe1, 0xe3, 0x49, 0x70, 0x53, 0x82, 0xbd, 0xb6, 0x1c, 0xb6, 0x9b, 0x11,
+  0x93, 0x1c, 0x06, 0x37, 0xe4, 0x08, 0x7e, 0x07, 0x63, 0xf8, 0x87, 0xaf, 0x16, 0x56, 0x17, 0xe4,
+  0x46, 0xfd, 0x3f, 0x9c, 0x66, 0x58, 0x72, 0xf7, 0x24, 0xb9, 0xfc, 0x9e, 0x7c, 0x25, 0x0b, 0x76,
+  0x33, 0x08, 0xdd, 0xbf, 0x04, 0x02, 0x0b, 0xc6, 0x1d, 0x10, 0x34, 0xb8, 0x75, 0x4a, 0x06, 0x3b,
+  0xba, 0xb8, 0x72, 0xa3, 0x41, 0x64, 0x05, 0x83, 0xb5, 0xbb, 0x5a, 0x7b, 0xf0, 0x1b, 0x0d, 0x6c,
+  0xe6, 0x31, 0x58, 0x69, 0xc4, 0x2d, 0x3f, 0x0c, 0x2c, 0x0e, 0x62, 0x7d, 0x0a, 0x00, 0x4b, 0xdc,
+  0x5e, 0x30, 0xe7, 0xb6, 0xc0, 0x6c, 0x14, 0xaf, 0x81, 0x94, 0xa4, 0x19, 0x31, 0x12, 0x59, 0x22,
+  0x28, 0x4b, 0x46, 0x9f, 0x0c, 0xac, 0x20, 0xf0, 0xe8, 0x20, 0xbc, 0x0d, 0x23, 0xba, 0x01, 0x1d,
+  0x80, 0xbb, 0x30, 0x81, 0x5d, 0x20, 0xd6, 0xc2, 0xb2, 0xaf, 0x56, 0x9c, 0x6d, 0x7d, 0x27, 0xc6,
+  0xe4, 0xda, 0xe2, 0x5d, 0x94, 0xa3, 0x5e, 0xbe, 0x63, 0xae, 0x35, 0x61, 0x72, 0xa1, 0x13, 0x48,
+  0xc6, 0x0a, 0x39, 0x5f, 0xe0, 0xb9, 0x92, 0xe5, 0x19, 0x59, 0x7a, 0xb4, 0x40, 0xf0, 0x3f, 0xb7,
+  0x61, 0xe4, 0x2e, 0x6f, 0x07, 0x4a, 0xa5, 0x67, 0xc4, 0x86, 0x7f, 0x29, 0x2f, 0x80, 0x75, 0xfd,
+  0xc1, 0x9a, 0x22, 0xb9, 0x80, 0x67, 0xa6, 0x79, 0xbd, 0xae, 0x5c, 0x03, 0xc8, 0xe6, 0x0a, 0x24,
+  0xdc, 0x73, 0x7d, 0x6a, 0xf1, 0xc1, 0x0a, 0x19, 0x0d, 0xf0, 0xba, 0x82, 0x7b, 0xd3, 0x71, 0x9f,
+  0x1c, 0x4d, 0xfb, 0xe4, 0x78, 0x8a, 0x0c, 0x1c, 0xf7, 0x08, 0xf0, 0xb5, 0x9f, 0x25, 0x3c, 0xde,
+  0xe8, 0xf5, 0x73, 0xa0, 0x8b, 0x80, 0x4e, 0x4c, 0x87, 0xae, 0xfa, 0x64, 0x0f, 0x78, 0x95, 0xa8,
+  0x82, 0x88, 0x00, 0xa6, 0x13, 0x13, 0x84, 0x0b, 0xff, 0xc9, 0x8a, 0x53, 0x89, 0xfb, 0x43, 0xe0,
+  0xa5, 0x20, 0x11, 0x90, 0x1c, 0xcc, 0x51, 0x5e, 0x0e, 0x84, 0xdd, 0x13, 0x84, 0xf9, 0xae, 0xc8,
+  0x8d, 0x9b, 0x81, 0x6a, 0x3c, 0x31, 0xcd, 0xa2, 0xa8, 0x07, 0x96, 0xe3, 0x08, 0x19, 0x1d, 0x1f,
+  0x15, 0x9b, 0x12, 0x7e, 0xad, 0xb8, 0x5b, 0x50, 0x3e, 0xbc, 0x03, 0xec, 0xdf, 0x40, 0x7b, 0x44,
+  0x51, 0x64, 0xb6, 0x1b, 0x1f, 0x35, 0x69, 0xc9, 0xf1, 0xb7, 0xd0, 0xd7, 0x0a, 0x66, 0x85, 0xb5,
+  0xe1, 0x8f, 0x05, 0x82, 0xef, 0x0f, 0x5c, 0x00, 0x02, 0x03, 0xc3, 0xc8, 0xe2, 0x91, 0x56, 0x95,
+  0x7e, 0xdc, 0x50, 0xc7, 0xb5, 0x48, 0x37, 0xb3, 0x8a, 0x17, 0x47, 0xc7, 0x40, 0xd1, 0xc2, 0xf2,
+  0x6b, 0x69, 0x53, 0x8f, 0x72, 0x1e, 0xaf, 0xbb, 0x5a, 0x0e, 0xc0, 0xb8, 0xc1, 0x8e, 0xc3, 0x5c,
+  0xa5, 0x39, 0x6a, 0xa4, 0x1b, 0xef, 0x0c, 0x1c, 0x97, 0x53, 0x3b, 0x72, 0x19, 0xe8, 0x85, 0x9c,
+  0x5c, 0x43, 0xa5, 0x3c, 0x0f, 0x32, 0x54, 0x18, 0xda, 0x16, 0x77, 0x0a, 0x13, 0xa6, 0x42, 0x14,
+  0xeb, 0xa3, 0x32, 0xdd, 0x45, 0x61, 0x93, 0xc6, 0x27, 0xb6, 0x76, 0xb2, 0xab, 0xfc, 0xd6, 0xab,
+  0x90, 0x85, 0x32, 0xb7, 0x84, 0x35, 0x53, 0x36, 0x51, 0x4d, 0x26, 0xbe, 0x69, 0xe7, 0x9a, 0xa1,
+  0xc8, 0x93, 0x90, 0x79, 0xae, 0x93, 0xc7, 0x4c, 0x3a, 0x95, 0x5e, 0xbd, 0x90, 0x2f, 0x22, 0x7f,
+  0x10, 0x46, 0x2c, 0xa8, 0x5c, 0x6e, 0xde, 0x44, 0x49, 0x27, 0xa1, 0x37, 0x53, 0xbb, 0x35, 0xc8,
+  0x97, 0x1e, 0x43, 0x9f, 0xf9, 0xb4, 0xf5, 0xea, 0x85, 0x8d, 0x95, 0x9a, 0x3a, 0x1e, 0x4e, 0x38,
+  0xdd, 0x68, 0x9a, 0x77, 0xca, 0x32, 0xbd, 0x28, 0xba, 0xdc, 0xf6, 0xf4, 0x17, 0xf6, 0x54, 0x58,
+  0x8e, 0x25, 0xe3, 0x9b, 0x19, 0xd9, 0xa2, 0x98, 0xd9, 0x56, 0x58, 0x40, 0xd4, 0xa3, 0x51, 0x84,
+  0x61, 0x0b, 0x98, 0x71, 0xa9, 0xb9, 0x45, 0x74, 0xed, 0x2d, 0x0f, 0x71, 0xf9, 0x01, 0x73, 0xcb,
+  0x56, 0xb4, 0x25, 0x27, 0x05, 0x1a, 0xae, 0x94, 0xd7, 0x04, 0x25, 0x34, 0x70, 0x61, 0x9f, 0x30,
+  0x9c, 0x39, 0xba, 0x15, 0xdf, 0x4e, 0xdb, 0x19, 0xa1, 0x9c, 0x97, 0x72, 0xfd, 0x35, 0xe5, 0x6e,
+  0xa4, 0x13, 0x83, 0x84, 0xfb, 0x33, 0x0b, 0x94, 0xe5, 0x9a, 0x82, 0x23, 0xcd, 0x10, 0x44, 0x44,
+  0x6e, 0x5d, 0x73, 0x78, 0x72, 0xdc, 0x3b, 0x8d, 0xb1, 0x00, 0x37, 0x33, 0x3c, 0xd1, 0x3a, 0xcb,
+  0x21, 0xd8, 0xeb, 0x60, 0xed, 0xda, 0x95, 0x66, 0xe1, 0xa1, 0x0e, 0x29, 0x67, 0xc2, 0xb4, 0x1e,
+  0x4b, 0x38, 0x42, 0xf0, 0xfb, 0x51, 0xc4, 0x36, 0x5a, 0xb5, 0x2a, 0xe9, 0x70, 0xc9, 0xe3, 0x16,
+  0xc4, 0xa7, 0x1c, 0xac, 0x24, 0x72, 0x6b, 0x3e, 0x4c, 0x17, 0xf1, 0x07, 0x6f, 0x2d, 0x3d, 0x14,
+  0x8d, 0xb5, 0xeb, 0x38, 0xd4, 0x6f, 0xc9, 0x5d, 0x2b, 0x0c, 0xc0, 0xb6, 0x01, 0x8e, 0x20, 0x2f,
+  0xd0, 0x4e, 0x46, 0x64, 0x7c, 0x4a, 0xaa, 0x9c, 0xd0, 0x61, 0xd9, 0x09, 0x29, 0x3a, 0x79, 0x74,
+  0x09, 0x94, 0xb6, 0xb6, 0x11, 0xd3, 0x36, 0x73, 0xa9, 0x60, 0xf9, 0x76, 0x1d, 0xdf, 0x37, 0x2c,
+  0x62, 0x1c, 0xc5, 0x7a, 0x59, 0x8c, 0x8c, 0x13, 0x59, 0x1a, 0x30, 0x80, 0x86, 0x31, 0xca, 0x78,
+  0x8a, 0xae, 0x77, 0x3c, 0x2e, 0xe1, 0x54, 0xa9, 0x00, 0xd3, 0x10, 0x14, 0x6c, 0x01, 0x62, 0xb5,
+  0xa0, 0x7f, 0xb9, 0x94, 0x83, 0x38, 0x1e, 0xa2, 0xe7, 0x17, 0xf1, 0xe0, 0xa4, 0x4f, 0xc6, 0x0d,
+  0xe6, 0x0d, 0x5c, 0x5d, 0xb4, 0x0d, 0x07, 0xe8, 0x8e, 0xaa, 0xc4, 0xf1, 0x11, 0xfc, 0xed, 0xb8,
+  0x8a, 0xc6, 0xb1, 0x2c, 0x8e, 0xa7, 0x4d, 0xc1, 0x06, 0x22, 0x8a, 0x21, 0x6b, 0x8d, 0xdb, 0x11,
+  0x01, 0xd0, 0x64, 0x0a, 0x91, 0x4f, 0xfa, 0x0f, 0x50, 0x62, 0x5a, 0xe5, 0x57, 0xc6, 0x1a, 0xbf,
+  0x92, 0x93, 0xee, 0x23, 0x7d, 0xfb, 0xc3, 0x1c, 0x8a, 0x58, 0x08, 0x64, 0x78, 0xd4, 0xd3, 0x85,
+  0xce, 0xd2, 0xac, 0x9b, 0xc3, 0x17, 0x25, 0xb3, 0xae, 0x89, 0x75, 0x31, 0x5d, 0xb9, 0x9f, 0xd1,
+  0x2e, 0x90, 0xff, 0xb0, 0x15, 0xf5, 0xaf, 0x2d, 0x6f, 0x4b, 0xab, 0x91, 0x6e, 0xf4, 0x45, 0x0b,
+  0xe6, 0x39, 0x35, 0x6b, 0x52, 0x49, 0x5c, 0xaf, 0xc6, 0x54, 0x6b, 0xf2, 0x85, 0x1a, 0xa1, 0xe6,
+  0x6c, 0xf7, 0x00, 0x13, 0x2b, 0xe6, 0x01, 0xad, 0x8a, 0x76, 0xb4, 0x68, 0x79, 0x94, 0x98, 0xa0,
+  0x5f, 0xd8, 0xcb, 0x9e, 0x29, 0xc9, 0x53, 0x03, 0xa7, 0x25, 0x47, 0xd9, 0x8a, 0xc3, 0x39, 0x31,
+  0x39, 0xc9, 0x51, 0xfc, 0xae, 0x44, 0x02, 0xf4, 0x06, 0xe0, 0xb4, 0xf2, 0xeb, 0xd6, 0x7a, 0x0a,
+  0xa9, 0xa8, 0x10, 0xca, 0x66, 0x9d, 0xd7, 0xd0, 0xc1, 0x6c, 0x3e, 0xb6, 0xb4, 0xa2, 0x31, 0x4e,
+  0x79, 0xc4, 0x97, 0x82, 0xbe, 0x4c, 0xc1, 0x12, 0xe7, 0x34, 0xf2, 0xe9, 0xe1, 0x8b, 0xe9, 0xf4,
+  0xe8, 0xa4, 0x08, 0x72, 0x98, 0x78, 0x53, 0x5d, 0xd4, 0x28, 0xd2, 0xe8, 0xde, 0x69, 0x2e, 0x34,
+  0x30, 0xe1, 0x3f, 0x98, 0xb1, 0xd4, 0xa7, 0x00, 0x57, 0xe5, 0xd8, 0x5a, 0xc0, 0xaa, 0xad, 0x16,
+  0x70, 0xda, 0x47, 0x2b, 0x56, 0x32, 0x62, 0x1e, 0x88, 0x2d, 0x97, 0x82, 0x64, 0xdd, 0x83, 0x77,
+  0xc7, 0x25, 0x6d, 0xb9, 0x9f, 0xf2, 0x6a, 0x9c, 0x05, 0xc2, 0x11, 0x4c, 0xd6, 0x07, 0x02, 0xc5,
+  0x90, 0xcd, 0x1c, 0x36, 0x9a, 0x5f, 0x0c, 0x84, 0x1e, 0xc5, 0x49, 0x70, 0x1a, 0x50, 0x2b, 0xea,
+  0x82, 0x93, 0x02, 0x57, 0xd1, 0xd3, 0xf8, 0x8a, 0xe3, 0x26, 0x57, 0x31, 0x69, 0x83, 0xab, 0x1d,
+  0x71, 0xaf, 0x6d, 0x86, 0xa2, 0xd5, 0xd5, 0xea, 0xc8, 0xbc, 0xd5, 0xa6, 0x43, 0x2e, 0x91, 0x25,
+  0xf5, 0x31, 0xf8, 0x71, 0x6d, 0x80, 0x3f, 0xae, 0x37, 0xaa, 0x47, 0xc5, 0x00, 0xbf, 0x36, 0xdc,
+  0xce, 0x86, 0x11, 0x29, 0x3d, 0x34, 0xa1, 0xf3, 0x5e, 0x11, 0x32, 0x12, 0x7b, 0x56, 0xa3, 0xd3,
+  0x89, 0x65, 0x8f, 0x69, 0x87, 0x9b, 0x81, 0x15, 0x3a, 0x06, 0x96, 0x14, 0x48, 0x73, 0x8f, 0x18,
+  0xb9, 0x31, 0xfc, 0x95, 0x91, 0xc8, 0xb4, 0x32, 0x60, 0x9d, 0xe6, 0x19, 0x95, 0x62, 0xe7, 0xfa,
+  0xc1, 0x36, 0xfa, 0x3d, 0xba, 0x0d, 0xe8, 0xbc, 0xc3, 0x31, 0xbf, 0xeb, 0xfc, 0x51, 0xf4, 0x82,
+  0x80, 0x0d, 0xc0, 0xce, 0x03, 0x8e, 0x2d, 0xe5, 0x51, 0x73, 0x98, 0xdd, 0x2c, 0x88, 0x89, 0xb0,
+  0x1c, 0x14, 0xa1, 0xb1, 0x6d, 0x84, 0x1b, 0x42, 0x3a, 0x49, 0x8d, 0x37, 0xf7, 0x70, 0x83, 0xc0,
+  0x02, 0xcc, 0xed, 0x52, 0xaf, 0xda, 0x45, 0xce, 0x66, 0x31, 0x00, 0xc5, 0x95, 0x68, 0xbd, 0xdd,
+  0x2c, 0x8a, 0xbb, 0xbb, 0x8d, 0x73, 0x64, 0x62, 0xf5, 0x72, 0xca, 0x11, 0x13, 0xa9, 0x4d, 0x32,
+  0xa2, 0x0f, 0x10, 0x34, 0x3e, 0xe8, 0x7e, 0xe9, 0x27, 0xba, 0x02, 0xb4, 0xa5, 0x2a, 0x8e, 0x3c,
+  0x04, 0x13, 0x75, 0x74, 0xd0, 0x27, 0x27, 0x22, 0x9e, 0x3e, 0x6c, 0x8a, 0xea, 0xc0, 0xa4, 0x82,
+  0x14, 0x85, 0x03, 0xd0, 0x87, 0x1a, 0xbb, 0x53, 0xa6, 0xcc, 0x5e, 0x76, 0x46, 0xe3, 0x52, 0x2a,
+  0xb3, 0xa0, 0xd4, 0x02, 0x4d, 0xeb, 0xfc, 0x03, 0x66, 0x39, 0x75, 0x01, 0xc6, 0xb4, 0x1c, 0x88,
+  0xd6, 0x11, 0xf4, 0x91, 0x22, 0xac, 0xb6, 0xe6, 0x47, 0xc3, 0x00, 0x05, 0xbe, 0xca, 0x70, 0xd4,
+  0xec, 0xb4, 0x98, 0x82, 0x54, 0x95, 0xb9, 0x48, 0x69, 0x8a, 0x21, 0x0b, 0xa8, 0x9f, 0x8d, 0xae,
+  0x16, 0x1e, 0xb3, 0xaf, 0xf4, 0x76, 0x4d, 0xa8, 0xd7, 0x00, 0xc5, 0x20, 0x68, 0x6f, 0xd2, 0x5a,
+  0xe6, 0x4e, 0x4d, 0x0e, 0x31, 0xab, 0xda, 0x3e, 0x68, 0x30, 0xe5, 0x25, 0x03, 0x96, 0x0b, 0xda,
+  0xcc, 0xe5, 0xf8, 0xc5, 0xc4, 0x7a, 0x78, 0xfa, 0xbe, 0xa7, 0xa3, 0x9c, 0xec, 0x9b, 0x8d, 0x69,
+  0xad, 0x6e, 0xd6, 0x77, 0xea, 0x3d, 0xe7, 0x5e, 0x62, 0x85, 0xee, 0xcd, 0x12, 0x61, 0x5f, 0x81,
+  0x62, 0x19, 0xa9, 0x69, 0x63, 0xbb, 0xfe, 0xc6, 0x50, 0xa3, 0x89, 0x4c, 0xb5, 0xfa, 0x9a, 0x8b,
+  0x25, 0xa6, 0xc5, 0x58, 0x62, 0x7f, 0x7a, 0xad, 0xac, 0xed, 0x8a, 0x62, 0x0c, 0x6b, 0x5f, 0x3d,
+  0x28, 0xfc, 0x4a, 0x4e, 0x56, 0xf6, 0x96, 0x8a, 0x80, 0xc5, 0x01, 0x0e, 0xa7, 0x10, 0x7a, 0x42,
+  0x4c, 0xa2, 0xd5, 0x1e, 0x99, 0x83, 0x95, 0x38, 0x57, 0xbd, 0xe5, 0x74, 0x57, 0x5c, 0xe4, 0xc2,
+  0xe2, 0x8d, 0x4b, 0xd4, 0xbb, 0xac, 0xcc, 0xb1, 0xd1, 0x77, 0x55, 0xc8, 0x5b, 0x0b, 0x50, 0xb3,
+  0x6d, 0x71, 0xbf, 0x58, 0x60, 0x6d, 0x56, 0xc7, 0x74, 0x96, 0xe7, 0xe1, 0xbe, 0x4f, 0x58, 0x83,
+  0xb6, 0x0c, 0x8d, 0x40, 0x90, 0x78, 0x91, 0x43, 0x4d, 0x93, 0xcb, 0x0d, 0xb1, 0x92, 0x83, 0xd5,
+  0xe1, 0x14, 0xdb, 0x26, 0x53, 0x1f, 0x06, 0xd4, 0xe9, 0x4b, 0xb2, 0x8b, 0x13, 0xff, 0x9a, 0xc3,
+  0x03, 0xdd, 0x6e, 0xb0, 0x4c, 0x91, 0xc4, 0x25, 0x66, 0x18, 0xff, 0xd5, 0x1d, 0x00, 0x66, 0x85,
+  0x8e, 0x7f, 0x0d, 0x5c, 0xdf, 0x41, 0x23, 0x31, 0xa9, 0x95, 0xda, 0xd1, 0xf7, 0xe4, 0x2d, 0xe7,
+  0x8c, 0x8f, 0x2e, 0x64, 0x62, 0x49, 0x2e, 0x99, 0x15, 0x46, 0xe4, 0xfb, 0x51, 0x4a, 0xbb, 0x48,
+  0xdc, 0xa9, 0xa2, 0xd7, 0xd2, 0xbd, 0xa1, 0x8e, 0x86, 0x2a, 0x65, 0xcb, 0xc0, 0xab, 0xc2, 0x9d,
+  0x9c, 0xbb, 0xd6, 0x1e, 0x79, 0xb4, 0xdd, 0xb7, 0xdf, 0xef, 0x24, 0x66, 0x3f, 0x93, 0xde, 0x72,
+  0xbb, 0xbe, 0xc6, 0xdb, 0x26, 0x2c, 0x19, 0x97, 0xaa, 0x01, 0x2c, 0x1f, 0x94, 0x45, 0x12, 0x54,
+  0x04, 0x9c, 0xef, 0x7d, 0x90, 0xe5, 0x83, 0x90, 0xd0, 0x5c, 0x06, 0x7c, 0x57, 0x60, 0xca, 0x30,
+  0x5c, 0xe3, 0x3e, 0x4f, 0x8d, 0x17, 0x56, 0xfd, 0x28, 0xb2, 0x58, 0x1c, 0x85, 0x73, 0x99, 0x62,
+  0x68, 0x8e, 0x6d, 0x88, 0xfe, 0x6e, 0x79, 0x4e, 0x25, 0x28, 0x7a, 0x68, 0xe9, 0xfe, 0x44, 0xc5,
+  0xed, 0x12, 0xbc, 0xcc, 0xc6, 0x85, 0x06, 0x5e, 0xba, 0x2d, 0x51, 0x71, 0x5b, 0x23, 0xd3, 0x3f,
+  0x5e, 0xd1, 0xdb, 0x25, 0xb7, 0x36, 0x34, 0x4c, 0x88, 0x59, 0xc8, 0x59, 0x38, 0xdb, 0xe4, 0xcf,
+  0x33, 0x32, 0xba, 0x84, 0x96, 0x29, 0x77, 0xa8, 0x91, 0x9d, 0x43, 0x8a, 0x77, 0xe5, 0x58, 0x33,
+  0x3b, 0x70, 0x7c, 0x5a, 0x7f, 0x84, 0x09, 0xaa, 0xf7, 0x9a, 0xf9, 0xbe, 0xdc, 0x59, 0x21, 0x17,
+  0x62, 0xd7, 0x8a, 0xbc, 0xb2, 0x9c, 0x15, 0xcd, 0xa9, 0x9f, 0x9d, 0xf4, 0x01, 0xb3, 0x8b, 0x8d,
+  0xfb, 0x6a, 0x62, 0xd9, 0xd2, 0x4b, 0x6b, 0x36, 0x36, 0x6b, 0xf3, 0xc1, 0xc6, 0x2d, 0xe2, 0xda,
+  0xd3, 0x39, 0xdd, 0x36, 0xee, 0xdf, 0xa9, 0x9d, 0x0f, 0xce, 0x8e, 0x35, 0x91, 0xef, 0xd9, 0x48,
+  0x55, 0x15, 0x9d, 0x8d, 0x64, 0x71, 0xd4, 0x19, 0x56, 0x7d, 0xa8, 0x82, 0x23, 0xc7, 0xbd, 0x26,
+  0xb6, 0x67, 0x85, 0xe1, 0xbc, 0x53, 0xe4, 0x50, 0x27, 0xad, 0x43, 0xca, 0x76, 0x73, 0x58, 0xd4,
+  0x21, 0xae, 0x33, 0xef, 0xec, 0xc2, 0x37, 0x70, 0x79, 0x7e, 0x36, 0x82, 0xc6, 0x4c, 0x57, 0xc8,
+  0x09, 0x7c, 0xd5, 0x2e, 0x85, 0xa1, 0x73, 0x1e, 0xcb, 0x87, 0xbf, 0x1a, 0x0e, 0x87, 0x80, 0x0e,
+  0xf4, 0x50, 0xd3, 0xa7, 0x63, 0x4b, 0xe8, 0x08, 0xb5, 0x92, 0x33, 0xc9, 0xcb, 0xf3, 0xba, 0xde,
+  0xb9, 0xd3, 0xfa, 0x0a, 0xcc, 0x33, 0x67, 0xed, 0x99, 0x1e, 0xa5, 0x5e, 0x16, 0x77, 0x0a, 0xcd,
+  0xc5, 0x2e, 0xa5, 0x73, 0x40, 0x4d, 0x7f, 0x49, 0x8b, 0xeb, 0x95, 0xf4, 0x98, 0xf3, 0x0e, 0xea,
+  0x63, 0x47, 0xc5, 0x0d, 0xf1, 0x37, 0x2c, 0x3d, 0x7b, 0xc5, 0x6e, 0xe6, 0x9d, 0x43, 0xcc, 0x5b,
+  0xc9, 0x64, 0x02, 0xbf, 0x63, 0xb3, 0x43, 0x02, 0x4e, 0x43, 0xca, 0xaf, 0xe9, 0x4b, 0x71, 0x0c,
+  0xf6, 0x05, 0x2d, 0xea, 0xbc, 0x73, 0xf3, 0xc1, 0x75, 0x7e, 0x83, 0x5f, 0xb2, 0xa1, 0x14, 0xe8,
+  0x72, 0xb3, 0xf1, 0x7c, 0x40, 0x05, 0x8b, 0xc2, 0x66, 0xa3, 0xd1, 0x6e, 0xb7, 0x1b, 0xee, 0x0e,
+  0x86, 0x8c, 0xaf, 0x46, 0x13, 0xb0, 0xca, 0x23, 0x98, 0xb8, 0x02, 0x27, 0xb9, 0x16, 0xba, 0x0c,
+  0xab, 0x9b, 0x45, 0x17, 0x59, 0xa2, 0xf2, 0x93, 0xaa, 0x50, 0x11, 0x6c, 0xc0, 0xa2, 0x39, 0x2f,
+  0xbe, 0x03, 0x18, 0x8c, 0xe7, 0x1d, 0x5c, 0xc5, 0xad, 0xfa, 0xbc, 0x99, 0xc4, 0xeb, 0xba, 0x8d,
+  0xaf, 0xea, 0xe7, 0x50, 0x15, 0x6f, 0x2c, 0x20, 0x6c, 0xb9, 0x14, 0x35, 0x7a, 0x38, 0x58, 0x08,
+  0xeb, 0xbc, 0x83, 0xf7, 0x95, 0x0d, 0x8d, 0xab, 0xb9, 0xc4, 0xad, 0xd8, 0x2e, 0x8d, 0x3b, 0x64,
+  0xb4, 0x2f, 0xf8, 0x69, 0x05, 0x7c, 0x7b, 0xe1, 0x4c, 0xe9, 0xf8, 0xe1, 0xf0, 0xe5, 0xea, 0x1f,
+  0x6d, 0x01, 0x67, 0xa3, 0x3c, 0x13, 0x1a, 0x7a, 0x63, 0xaf, 0x94, 0x3f, 0x82, 0x63, 0x0e, 0x84,
+  0x88, 0xaf, 0x85, 0xa9, 0xe8, 0x10, 0xfb, 0x46, 0x11, 0xc0, 0xbe, 0x55, 0x17, 0x5c, 0x7d, 0x2e,
+  0xe3, 0x96, 0xa5, 0x6a, 0x79, 0x24, 0xb6, 0x1d, 0x1c, 0x1c, 0x8e, 0xa7, 0xd3, 0xbf, 0x91, 0xac,
+  0x2a, 0xcd, 0xdd, 0x9b, 0xac, 0x79, 0x4a, 0x35, 0xf4, 0x5e, 0xba, 0x1e, 0xd0, 0x4f, 0x92, 0x93,
+  0xb3, 0xe0, 0x42, 0x44, 0x4b, 0x20, 0xed, 0xf3, 0xce, 0x60, 0x22, 0x84, 0x3d, 0xbe, 0x88, 0x15,
+  0xfd, 0x30, 0xa7, 0xe8, 0x87, 0xed, 0xe8, 0xb9, 0xa4, 0x3f, 0x59, 0xdb, 0x30, 0x74, 0x2d, 0xff,
+  0x95, 0xb7, 0x85, 0xd9, 0xfc, 0x79, 0xe7, 0x82, 0x6d, 0xb9, 0x4d, 0x5f, 0x7a, 0xc1, 0xda, 0xc2,
+  0xd5, 0x3b, 0x6f, 0xe8, 0xb5, 0x2b, 0x82, 0x2b, 0xb0, 0x17, 0x9d, 0x51, 0x2b, 0x98, 0x9f, 0x04,
+  0x05, 0x89, 0x03, 0xc8, 0x4e, 0x3a, 0xc4, 0xb9, 0xc5, 0x91, 0x90, 0x54, 0x85, 0x5b, 0x0f, 0x50,
+  0x93, 0xe4, 0x5d, 0xc0, 0x74, 0x2d, 0xa1, 0xbd, 0x66, 0x9b, 0x00, 0xa2, 0x41, 0x3f, 0xba, 0x14,
+  0x51, 0x03, 0xe5, 0xcd, 0xa3, 0xc4, 0xb8, 0x77, 0x5b, 0xdf, 0x7e, 0x49, 0xe4, 0xee, 0x85, 0x94,
+  0x68, 0x58, 0x8f, 0xc7, 0xf0, 0xab, 0x39, 0x9c, 0xb6, 0x9a, 0x7c, 0x74, 0xaf, 0xd9, 0x61, 0xee,
+  0x0f, 0x94, 0xaf, 0xe8, 0x39, 0x69, 0x81, 0x68, 0xda, 0xfd, 0x23, 0x73, 0xe8, 0xe8, 0x7c, 0xef,
+  0x21, 0x19, 0xa6, 0xfd, 0x24, 0x1d, 0x04, 0x2c, 0x8d, 0xb4, 0x5a, 0x9b, 0xc4, 0xb2, 0x41, 0x6a,
+  0xa5, 0x20, 0xd6, 0x58, 0xf5, 0x91, 0x34, 0xeb, 0xd5, 0x1d, 0x02, 0x2b, 0x5a, 0x13, 0x90, 0xe3,
+  0x0f, 0x27, 0x66, 0x7f, 0x7c, 0x34, 0x25, 0xaf, 0xf1, 0xf3, 0xc4, 0x24, 0x2f, 0xe4, 0xc7, 0x54,
+  0x7c, 0xa0, 0xac, 0x71, 0x76, 0x85, 0x95, 0xd1, 0xd9, 0x10, 0x3a, 0xbe, 0x3d, 0x50, 0x62, 0x7e,
+  0x00, 0xe6, 0xc2, 0xf5, 0xbc, 0x79, 0x07, 0x13, 0x84, 0x3a, 0x1e, 0x66, 0x66, 0x3d, 0x52, 0xb3,
+  0xc2, 0xe7, 0xc9, 0x54, 0xce, 0x3a, 0x95, 0xb3, 0x4e, 0xd3, 0x59, 0x9f, 0x82, 0xa5, 0x9c, 0x2c,
+  0x8f, 0x1e, 0x61, 0xbe, 0xb1, 0x39, 0x91, 0x13, 0xe2, 0x05, 0xb8, 0x45, 0x9c, 0x11, 0x3f, 0xa6,
+  0xe2, 0x23, 0x33, 0xa3, 0x2c, 0xf7, 0x7d, 0x94, 0x19, 0x8f, 0xe3, 0x19, 0x8f, 0x61, 0x8e, 0xa9,
+  0x9c, 0x71, 0x2a, 0x67, 0xcc, 0xae, 0x51, 0x96, 0x52, 0xdf, 0x7f, 0x46, 0x2c, 0xfd, 0x43, 0x13,
+  0x74, 0x3c, 0x15, 0x06, 0x68, 0x7c, 0x64, 0x26, 0xf6, 0xe7, 0xc0, 0xcc, 0x58, 0x1f, 0x68, 0xe6,
+  0x52, 0xf9, 0x25, 0xe0, 0xa7, 0xcb, 0xf1, 0x72, 0xba, 0x3c, 0xa9, 0xb5, 0x91, 0x45, 0xe0, 0x87,
+  0xd3, 0xd4, 0xb6, 0xe5, 0x80, 0xe3, 0x17, 0x84, 0x7e, 0x1c, 0x43, 0xc7, 0x32, 0xf5, 0xa7, 0xb9,
+  0x28, 0xa1, 0x27, 0x9a, 0x40, 0x6c, 0x55, 0x63, 0x6a, 0x41, 0x7b, 0x19, 0x6a, 0x1c, 0x1d, 0xbe,
+  0x38, 0x3c, 0x5e, 0x14, 0xa9, 0x31, 0xae, 0xa5, 0x80, 0xed, 0x72, 0xdb, 0xa3, 0xc2, 0xab, 0x9d,
+  0x1c, 0x2b, 0xa7, 0x76, 0x2c, 0x7c, 0xda, 0x61, 0xb2, 0x58, 0x79, 0x76, 0x5d, 0xbf, 0xd8, 0x0c,
+  0x9c, 0x89, 0x39, 0x79, 0x1c, 0x40, 0x31, 0x42, 0xe3, 0xa3, 0xc9, 0x23, 0x61, 0xf4, 0x60, 0x48,
+  0xe3, 0xa9, 0xa9, 0x20, 0x61, 0x80, 0xc9, 0x25, 0x57, 0x33, 0x5c, 0x4b, 0x23, 0x85, 0x2c, 0x63,
+  0xa4, 0x07, 0x2f, 0x32, 0x66, 0x52, 0x3f, 0x2b, 0xee, 0x72, 0x92, 0x78, 0xca, 0x5b, 0xf5, 0x29,
+  0x0f, 0x2c, 0x7c, 0x7b, 0xcd, 0x60, 0xee, 0x8d, 0xeb, 0x38, 0x1e, 0x4d, 0x96, 0x12, 0xb3, 0x3f,
+  0xc9, 0xbb, 0xa4, 0x48, 0xa5, 0x3b, 0x97, 0x30, 0x22, 0x2e, 0x1b, 0xe9, 0x9c, 0x7f, 0xfe, 0x74,
+  0xf1, 0xfe, 0xf2, 0xfd, 0xa7, 0x8f, 0x67, 0x23, 0x84, 0x59, 0x83, 0xc7, 0x4a, 0x06, 0xad, 0x58,
+  0xbb, 0x75, 0x81, 0xa5, 0x5b, 0x9d, 0x38, 0x7c, 0xcf, 0x94, 0x73, 0x35, 0xb8, 0xe6, 0x5a, 0x0a,
+  0x8e, 0x53, 0xad, 0x92, 0x4f, 0x24, 0x64, 0x08, 0x27, 0x03, 0xbe, 0xe6, 0x50, 0x24, 0xb5, 0x1c,
+  0x07, 0x60, 0x39, 0xc0, 0x52, 0xfc, 0x0c, 0x9c, 0xc6, 0x0b, 0x0d, 0xac, 0xa2, 0x76, 0x34, 0x02,
+  0xaf, 0x43, 0x1e, 0x75, 0x57, 0x22, 0x9f, 0xa9, 0x2c, 0xcf, 0x4c, 0xba, 0x3c, 0x3c, 0x58, 0x96,
+  0x4d, 0xe2, 0x24, 0xb9, 0xe1, 0x58, 0x40, 0x3f, 0xce, 0x2d, 0xd4, 0x96, 0x3e, 0x60, 0xab, 0xc2,
+  0xaf, 0x56, 0x1e, 0x5d, 0xe4, 0x16, 0x22, 0x7d, 0x90, 0x22, 0x32, 0x56, 0x68, 0x89, 0x04, 0x42,
+  0xdc, 0x81, 0x8b, 0x17, 0x66, 0x23, 0x36, 0x07, 0xc9, 0x0d, 0x04, 0x68, 0x5b, 0xc1, 0xbc, 0x23,
+  0xd2, 0xf2, 0xce, 0x7d, 0x08, 0xf3, 0xc2, 0x2c, 0x28, 0x58, 0x3c, 0x67, 0x9d, 0xa8, 0x8f, 0x56,
+  0x15, 0x89, 0x1f, 0x26, 0x60, 0x9a, 0x1c, 0x52, 0x26, 0xb0, 0xb5, 0xb9, 0x65, 0xa6, 0x9c, 0xaf,
+  0x2a, 0xab, 0x2c, 0xf4, 0xc6, 0x9a, 0xba, 0xda, 0x64, 0xaf, 0xd0, 0x5d, 0x54, 0xae, 0x81, 0x1e,
+  0xa9, 0x1d, 0x97, 0x42, 0xfe, 0xde, 0x38, 0x5c, 0xd4, 0x90, 0xc9, 0xbc, 0x3c, 0x60, 0xe1, 0x1b,
+  0x37, 0x0c, 0x3a, 0xe7, 0x83, 0xc1, 0xa0, 0x06, 0x4c, 0x5d, 0xd3, 0xe3, 0xac, 0xe5, 0xd2, 0x82,
+  0xf8, 0x29, 0x7a, 0xc0, 0x4a, 0x22, 0x01, 0xe0, 0x01, 0x8b, 0xa9, 0x65, 0xad, 0x4a, 0x5d, 0xca,
+  0xfb, 0x4a, 0xd5, 0x27, 0xc4, 0xc5, 0x82, 0xaf, 0x86, 0xa3, 0xd7, 0xca, 0x0d, 0x88, 0x78, 0x33,
+  0x66, 0xe3, 0xfa, 0x3f, 0x4b, 0x5a, 0x41, 0xb2, 0x72, 0x95, 0xdd, 0x83, 0xd1, 0x8e, 0x39, 0x37,
+  0x1b, 0xbb, 0x48, 0xb0, 0xd6, 0x8d, 0x02, 0xfb, 0xbc, 0x06, 0x6c, 0x15, 0xcd, 0xb2, 0x5b, 0x2a,
+  0xe9, 0xa9, 0x53, 0x0b, 0xb1, 0x2f, 0x9d, 0x83, 0x94, 0xb6, 0xa1, 0xea, 0x47, 0x2e, 0x30, 0x05,
+  0x51, 0x12, 0xfc, 0x0a, 0xae, 0xcf, 0xef, 0xc3, 0xd5, 0xbc, 0xc2, 0x72, 0x48, 0x0a, 0xdb, 0xc9,
+  0xb8, 0x2a, 0xea, 0x6b, 0x29, 0xe6, 0xc9, 0x76, 0x9b, 0x1c, 0xaa, 0xdb, 0x72, 0xab, 0x66, 0x8f,
+  0x1c, 0x73, 0x09, 0x72, 0xd5, 0x39, 0x7f, 0x0f, 0x2e, 0xb7, 0x96, 0xa9, 0xb5, 0x24, 0xa8, 0xb9,
+  0x55, 0x24, 0x52, 0xcb, 0x2d, 0xb7, 0xc5, 0x36, 0x8a, 0x98, 0x1f, 0x77, 0x8c, 0xcb, 0xf4, 0xc1,
+  0x93, 0xf8, 0xb6, 0xe7, 0xda, 0x57, 0x32, 0xd3, 0xff, 0x80, 0xae, 0xba, 0xdb, 0xeb, 0x9c, 0xbf,
+  0xfd, 0xf0, 0xf6, 0xcb, 0x4f, 0x6f, 0x3f, 0xbe, 0xfe, 0x8d, 0x5c, 0x5c, 0x7e, 0xfa, 0x7c, 0x36,
+  0x92, 0xa3, 0xf3, 0x20, 0x1f, 0xb2, 0xa5, 0x97, 0xab, 0x0c, 0xec, 0x9c, 0xbf, 0x63, 0xf6, 0x36,
+  0x24, 0x2f, 0x1d, 0x54, 0xbb, 0x0d, 0x88, 0x59, 0x05, 0x71, 0x6a, 0x41, 0xc6, 0x05, 0x77, 0x55,
+  0x62, 0x51, 0x26, 0x00, 0x56, 0x61, 0x65, 0x08, 0xe0, 0x6f, 0x9d, 0x15, 0xed, 0x0e, 0xc6, 0x26,
+  0xac, 0xff, 0x99, 0x67, 0xfd, 0xcf, 0x96, 0x9d, 0xea, 0x17, 0xbe, 0x3f, 0x48, 0x01, 0x31, 0x7c,
+  0x44, 0x90, 0x02, 0x22, 0x7f, 0x54, 0x88, 0x62, 0xd9, 0xbc, 0x01, 0xe2, 0xff, 0x2d, 0x63, 0x4c,
+  0xc4, 0x71, 0x30, 0xbe, 0x7a, 0x2c, 0xb6, 0x28, 0x78, 0xa6, 0xf9, 0x58, 0x24, 0x44, 0x78, 0xcf,
+  0x1f, 0x13, 0x9e, 0x04, 0x78, 0xd5, 0xc8, 0x90, 0x5a, 0x47, 0x98, 0x3d, 0xc0, 0x17, 0xc7, 0x2f,
+  0x6d, 0x2c, 0x67, 0x5e, 0x41, 0x2f, 0x02, 0x8a, 0x0f, 0xfa, 0x66, 0x4c, 0x1d, 0xde, 0xf8, 0xd5,
+  0xf2, 0x92, 0x8d, 0x42, 0xe9, 0x5a, 0xf3, 0x87, 0xf8, 0x9d, 0xf3, 0xc9, 0x34, 0xf6, 0x6c, 0x6d,
+  0xa3, 0x92, 0x42, 0x39, 0x63, 0xa7, 0xc9, 0xee, 0x96, 0x9c, 0xbd, 0xac, 0x13, 0xee, 0x9c, 0x4f,
+  0x6b, 0x7d, 0xaa, 0x00, 0x20, 0xea, 0x7c, 0x48, 0xb6, 0x84, 0x2f, 0x5d, 0xdb, 0x85, 0x40, 0xa4,
+  0x83, 0x4f, 0xad, 0xe2, 0x2e, 0x6d, 0x07, 0x1f, 0x81, 0x11, 0x7b, 0xa3, 0x22, 0x50, 0xa6, 0x01,
+  0x5e, 0x0b, 0x8e, 0xad, 0x71, 0x20, 0xae, 0x7f, 0xb3, 0x71, 0x23, 0x41, 0x27, 0x30, 0xa0, 0xd0,
+  0x20, 0x80, 0x83, 0xcb, 0xe3, 0x14, 0xcf, 0x1d, 0x64, 0x43, 0xb4, 0x76, 0xc3, 0xa1, 0x88, 0x83,
+  0x7a, 0xf7, 0x5f, 0x18, 0xe2, 0xf0, 0xa8, 0x9e, 0xa5, 0xde, 0x90, 0xc7, 0x88, 0xe4, 0xcb, 0xe3,
+  0x74, 0xe8, 0x6b, 0x95, 0x3e, 0x1e, 0xde, 0xf0, 0x08, 0x4c, 0xb1, 0x46, 0xcb, 0x3c, 0xbd, 0xb7,
+  0xb9, 0x58, 0xb1, 0x4b, 0xf6, 0xdf, 0x94, 0x33, 0xf4, 0x63, 0x3f, 0x31, 0xf2, 0x0f, 0xb6, 0xa1,
+  0xa4, 0x6b, 0xf6, 0xee, 0xa9, 0x93, 0x1a, 0xf1, 0x8e, 0x4f, 0xb9, 0xb3, 0xce, 0x93, 0x46, 0xf1,
+  0x94, 0x17, 0x34, 0x22, 0x26, 0xf9, 0x07, 0xe5, 0x74, 0x2f, 0x33, 0x7a, 0x3f, 0x5e, 0x68, 0xc9,
+  0x54, 0x58, 0x4b, 0xb6, 0xd2, 0x32, 0x83, 0x72, 0xc4, 0x56, 0x2b, 0x8f, 0x5e, 0xa8, 0xc6, 0x6e,
+  0xaf, 0x2e, 0xa6, 0x3d, 0xbf, 0x64, 0xcc, 0x0b, 0xc9, 0x33, 0x3c, 0x7a, 0x5e, 0xba, 0xab, 0xad,
+  0x78, 0x52, 0xcc, 0x6f, 0x0e, 0x6b, 0x9f, 0x3d, 0x3d, 0x39, 0x3e, 0x1e, 0x9f, 0x56, 0x07, 0xaa,
+  0x95, 0x04, 0xca, 0x99, 0xa2, 0x7c, 0x15, 0xa1, 0x52, 0x52, 0x75, 0xf7, 0xb5, 0xba, 0xd9, 0x32,
+  0xe1, 0xc9, 0x65, 0x30, 0xa4, 0x45, 0x52, 0x96, 0x85, 0x90, 0xa9, 0x49, 0xec, 0xb4, 0x34, 0x2b,
+  0xaa, 0x7c, 0x50, 0xa0, 0xbc, 0x82, 0xe8, 0xea, 0x3d, 0xb6, 0x75, 0x08, 0x68, 0x81, 0x4d, 0xd7,
+  0xcc, 0x73, 0x70, 0xab, 0x0e, 0x84, 0x34, 0x62, 0xc9, 0x91, 0x7c, 0x1d, 0xe4, 0xb2, 0x90, 0xca,
+  0x52, 0xbb, 0x44, 0x30, 0xda, 0x96, 0x92, 0x17, 0xd4, 0x05, 0xe8, 0x20, 0xb4, 0xe5, 0x53, 0x83,
+  0x92, 0x54, 0x93, 0xa9, 0x9a, 0x76, 0x31, 0x66, 0xe9, 0x23, 0x40, 0x0d, 0x27, 0xf4, 0xf1, 0xfb,
+  0x07, 0x44, 0x69, 0x31, 0x0a, 0xf8, 0xbd, 0xa6, 0xd5, 0x30, 0xfd, 0x83, 0x75, 0x43, 0x2e, 0xb9,
+  0x75, 0x4d, 0x3d, 0xf2, 0xb3, 0x0b, 0xc6, 0x9a, 0x74, 0x9f, 0x8f, 0x06, 0xbd, 0xff, 0x0c, 0xef,
+  0xc1, 0x7b, 0xe8, 0x58, 0x2f, 0xf0, 0xb8, 0x1f, 0xc7, 0x53, 0xdb, 0x03, 0x2b, 0x7a, 0xbd, 0x5c,
+  0x75, 0x0d, 0x98, 0xc3, 0x40, 0x03, 0x04, 0xdf, 0xff, 0x06, 0x3e, 0x6a, 0x08, 0x7a, 0x01, 0x7e,
+  0x30, 0x24, 0x9f, 0x29, 0x27, 0x5f, 0x58, 0x64, 0xfd, 0xe7, 0x14, 0x09, 0xfd, 0x6f, 0x08, 0x53,
+  0xea, 0x28, 0x2a, 0x70, 0x1a, 0x7d, 0x61, 0x8f, 0x46, 0x55, 0xce, 0xa2, 0xbd, 0xa8, 0xfa, 0xff,
+  0x4a, 0x13, 0x1a, 0x0d, 0x86, 0x2c, 0x30, 0x14, 0x75, 0x95, 0x49, 0x21, 0x8f, 0x70, 0xf0, 0xd9,
+  0xb2, 0x4f, 0xe1, 0xf0, 0x53, 0xd2, 0xec, 0x5c, 0xdf, 0x61, 0xbb, 0xa1, 0xc7, 0x6c, 0xc1, 0xf3,
+  0xe1, 0x9a, 0xd3, 0xe5, 0xdc, 0x18, 0x6d, 0x03, 0x07, 0x5c, 0xbb, 0x51, 0x43, 0xf7, 0x5f, 0x44,
+  0x0f, 0xf2, 0xce, 0xe5, 0x9b, 0x9d, 0xc5, 0x69, 0x05, 0x15, 0xeb, 0x68, 0xfc, 0x77, 0xaf, 0x52,
+  0x53, 0x6d, 0x54, 0xac, 0x74, 0x7b, 0xba, 0x5c, 0x2e, 0xb3, 0xd4, 0xe0, 0x74, 0xc1, 0x58, 0xf4,
+  0x46, 0xbc, 0xbd, 0xa8, 0x5b, 0x17, 0xd6, 0x7d, 0x11, 0x1d, 0x89, 0xec, 0xb9, 0xe7, 0xda, 0x5b,
+  0x6f, 0x0b, 0x14, 0x05, 0xf1, 0x2c, 0xb4, 0xb9, 0x1b, 0x64, 0xf6, 0xed, 0x47, 0x23, 0xf2, 0x2f,
+  0xba, 0xb8, 0x60, 0xf6, 0x15, 0xf8, 0xbf, 0xb4, 0x06, 0xe9, 0x49, 0x5a, 0xe5, 0x15, 0x91, 0x5d,
+  0x48, 0xe6, 0xc4, 0xdf, 0x7a, 0xde, 0x69, 0xe1, 0xf6, 0x17, 0xaa, 0x46, 0xbc, 0xc7, 0xad, 0x20,
+  0x08, 0x64, 0x2b, 0xfa, 0x7d, 0xa4, 0x37, 0xd1, 0x7b, 0x07, 0x1a, 0x33, 0xb5, 0xe6, 0x30, 0x32,
+  0xc4, 0xb6, 0xcf, 0xd4, 0x47, 0xfa, 0xe3, 0x48, 0xba, 0x23, 0x1f, 0xac, 0xa0, 0xab, 0x7b, 0x2f,
+  0x12, 0xa0, 0x89, 0xe5, 0x4c, 0x34, 0x07, 0x18, 0x6d, 0x0f, 0x85, 0x81, 0x5f, 0xd1, 0x59, 0xce,
+  0xf0, 0x15, 0x3e, 0x72, 0x23, 0x51, 0x5c, 0x86, 0x32, 0x45, 0x81, 0x8c, 0xa3, 0x4f, 0xf8, 0xd6,
+  0x97, 0xaf, 0x0e, 0x5a, 0x5a, 0x5e, 0x48, 0xfb, 0x22, 0x60, 0x87, 0x89, 0x39, 0x98, 0x05, 0x7c,
+  0x80, 0xfd, 0xe4, 0x88, 0xdc, 0xe9, 0xe7, 0xfc, 0x25, 0x72, 0xbd, 0xb0, 0x80, 0xf2, 0xb7, 0x30,
+  0x23, 0x68, 0xe8, 0xfc, 0x9c, 0x38, 0xcc, 0xde, 0xe2, 0xf6, 0xc4, 0x10, 0xe6, 0x7c, 0xeb, 0x51,
+  0xbc, 0x7c, 0x75, 0xfb, 0xde, 0xe9, 0xba, 0xd9, 0x67, 0x4c, 0xe4, 0xa0, 0x6b, 0x77, 0x01, 0xc3,
+  0xba, 0x3d, 0x1c, 0xf6, 0x95, 0xb8, 0xcb, 0xae, 0x6f, 0x5d, 0xbb, 0x2b, 0x2b, 0x62, 0x7c, 0x08,
+  0x4d, 0x10, 0x3f, 0xd1, 0x1e, 0x29, 0xdd, 0xc2, 0x24, 0xfc, 0x14, 0x51, 0xd3, 0x73, 0x0b, 0x0f,
+  0xf6, 0x91, 0x57, 0x29, 0x82, 0x4b, 0x75, 0x27, 0x66, 0x64, 0xd2, 0xb7, 0xdb, 0x2b, 0x3d, 0x6e,
+  0xa9, 0xa8, 0x0f, 0xe6, 0x8c, 0x81, 0x24, 0x03, 0x72, 0x45, 0x35, 0x0e, 0x92, 0xa6, 0xf9, 0x9c,
+  0xa8, 0xd7, 0x5f, 0x19, 0xe4, 0x07, 0x62, 0xec, 0x42, 0xbc, 0x98, 0xe1, 0xc5, 0xcc, 0x38, 0xd5,
+  0x83, 0xc5, 0xd7, 0x66, 0xcd, 0xc9, 0xf1, 0x58, 0xdf, 0xfc, 0x0b, 0x17, 0x13, 0xa6, 0xb3, 0x3f,
+  0x27, 0xc6, 0x68, 0x64, 0xc0, 0x47, 0xc9, 0x96, 0xb0, 0x30, 0xc2, 0x17, 0x85, 0x61, 0x8f, 0x99,
+  0xe8, 0x20, 0x60, 0x9f, 0x56, 0xef, 0x3c, 0x45, 0xfc, 0x56, 0xf3, 0xba, 0x18, 0x29, 0xc2, 0x20,
+  0x60, 0x29, 0x49, 0x04, 0x1a, 0x85, 0x02, 0x40, 0xd9, 0x75, 0xb8, 0x70, 0x7d, 0x88, 0x91, 0x2e,
+  0xc1, 0xd1, 0xc0, 0x28, 0x43, 0x1c, 0xb4, 0x2c, 0xb6, 0xcb, 0x25, 0xe5, 0xc6, 0x69, 0xf3, 0x5e,
+  0x07, 0x8c, 0x67, 0xbe, 0x78, 0xb2, 0x25, 0x61, 0xb8, 0x56, 0xbb, 0x91, 0x18, 0xcc, 0xa3, 0xb0,
+  0x56, 0xf0, 0x2a, 0x25, 0x1d, 0xa4, 0x8e, 0xa1, 0xc1, 0x0d, 0x7f, 0xa4, 0x5d, 0x4d, 0x8b, 0x3e,
+  0x65, 0x99, 0x5f, 0x37, 0xe2, 0x5b, 0x5a, 0x31, 0x02, 0xa4, 0xe6, 0x65, 0x78, 0x45, 0x96, 0x8c,
+  0x03, 0xf4, 0x4d, 0x00, 0xc6, 0x90, 0xc8, 0x15, 0x12, 0xb9, 0x43, 0x49, 0x64, 0x9d, 0xab, 0x76,
+  0x2c, 0xac, 0x26, 0x04, 0x0d, 0xed, 0xfe, 0xf3, 0xe2, 0xd3, 0xc7, 0x61, 0x18, 0x71, 0x50, 0x23,
+  0x77, 0x79, 0xdb, 0xfd, 0x4a, 0xec, 0x0d, 0x68, 0x97, 0x81, 0xc5, 0xab, 0x56, 0x64, 0xf4, 0x89,
+  0xbc, 0x80, 0x3b, 0x12, 0x32, 0xdc, 0x71, 0xa8, 0x17, 0x59, 0x58, 0xd8, 0xba, 0xa5, 0xe4, 0xae,
+  0x57, 0x81, 0x1a, 0x68, 0x82, 0xc6, 0x8c, 0xf4, 0x2a, 0x48, 0x26, 0xc8, 0xe6, 0x51, 0x8b, 0xc7,
+  0x1d, 0xb5, 0x83, 0x4f, 0x2b, 0xc7, 0xb6, 0xb1, 0x58, 0xd9, 0x9f, 0xbb, 0xd2, 0xdd, 0xbb, 0xb6,
+  0x02, 0x00, 0xf4, 0x0c, 0xad, 0x15, 0xca, 0x4f, 0x97, 0x5e, 0xe3, 0x51, 0x7c, 0xb5, 0x20, 0x00,
+  0x0d, 0x44, 0x97, 0x21, 0xf0, 0xd5, 0x22, 0x2e, 0xa8, 0x08, 0x3e, 0x05, 0xc8, 0x96, 0xe4, 0x25,
+  0x0a, 0xde, 0x2b, 0x21, 0x78, 0xb5, 0x14, 0x11, 0x5a, 0x25, 0x06, 0xcf, 0x81, 0xea, 0x36, 0x73,
+  0xa8, 0x94, 0x89, 0x77, 0xc8, 0xd6, 0x0c, 0xec, 0x1a, 0xca, 0x00, 0x0e, 0xa2, 0x87, 0x92, 0xae,
+  0x5f, 0xde, 0x77, 0x1b, 0x06, 0x70, 0x1a, 0x6d, 0xb9, 0xdf, 0x96, 0x6c, 0xd5, 0x8a, 0xa9, 0x5d,
+  0x84, 0x10, 0xb6, 0x00, 0xdf, 0x1c, 0xb8, 0x17, 0xf6, 0xc3, 0x48, 0x68, 0x2c, 0x9a, 0x2b, 0x70,
+  0xdb, 0x46, 0x1d, 0xcd, 0xd2, 0x29, 0x39, 0x05, 0x2d, 0xbc, 0xa6, 0xd2, 0x1e, 0x49, 0x5f, 0x84,
+  0xf6, 0x5c, 0x02, 0x74, 0x9d, 0x9a, 0x59, 0xd5, 0xcc, 0x0a, 0x40, 0xd3, 0x6c, 0x52, 0x32, 0xe2,
+  0x19, 0x40, 0x39, 0x28, 0x18, 0xf8, 0x76, 0x93, 0x48, 0x7a, 0x8b, 0x59, 0x9a, 0xd8, 0x52, 0x4d,
+  0x7e, 0xd1, 0x42, 0x28, 0xf8, 0x3f, 0x44, 0xfa, 0x9b, 0x84, 0x5e, 0x4d, 0x78, 0xb7, 0x15, 0x08,
+  0xfd, 0xac, 0x77, 0x04, 0x0c, 0xb9, 0xbd, 0xee, 0xd2, 0x26, 0x01, 0x46, 0x4b, 0x28, 0x1e, 0x30,
+  0xe8, 0x1a, 0x9f, 0x91, 0xf1, 0x44, 0x7c, 0x99, 0x81, 0x1d, 0xa9, 0xb2, 0x6a, 0x0f, 0x50, 0x4e,
+  0xf9, 0x24, 0x03, 0xaa, 0x26, 0x5e, 0xb4, 0xb0, 0xd1, 0x0a, 0xb3, 0xd4, 0x4a, 0xa7, 0xd8, 0x09,
+  0x08, 0x7b, 0x59, 0x6a, 0x11, 0x84, 0x68, 0x86, 0xb4, 0x46, 0xdf, 0xf6, 0x58, 0x48, 0xef, 0xe7,
+  0x5d, 0x1c, 0x37, 0xbc, 0xaf, 0x83, 0xa9, 0x42, 0x3b, 0xf6, 0x30, 0x11, 0xee, 0xe6, 0xa1, 0x3e,
+  0xa9, 0x09, 0xaa, 0x6c, 0xdd, 0x37, 0x7b, 0x1a, 0x7c, 0xbd, 0xd1, 0x0e, 0x69, 0xf2, 0xad, 0x5b,
+  0x47, 0x07, 0x2d, 0x3d, 0x14, 0xae, 0x18, 0x76, 0xa6, 0xa4, 0x49, 0x10, 0x1f, 0x0e, 0x87, 0x46,
+  0x83, 0x8a, 0x95, 0xe3, 0xab, 0x1a, 0xc5, 0xe8, 0x93, 0x03, 0xdc, 0xb9, 0xbf, 0xa7, 0x14, 0xd7,
+  0x6a, 0x50, 0xa5, 0x7c, 0xa6, 0x91, 0x3c, 0xc4, 0xbc, 0xae, 0x07, 0x91, 0x70, 0x85, 0x26, 0xed,
+  0xc1, 0xec, 0xfa, 0xe7, 0x50, 0x46, 0xe4, 0x55, 0x39, 0xa6, 0x20, 0xdd, 0x90, 0x52, 0xf5, 0x54,
+  0xca, 0x5b, 0x1f, 0x3d, 0x13, 0x1f, 0xae, 0xf1, 0x78, 0x1d, 0x63, 0x83, 0x90, 0xe0, 0xcb, 0x2c,
+  0x6f, 0x71, 0xb3, 0x2b, 0x5a, 0xd3, 0x2c, 0x24, 0x0f, 0x9f, 0x15, 0x53, 0x70, 0x80, 0x2d, 0xd4,
+  0xbd, 0xa6, 0x4e, 0x39, 0xc8, 0x2d, 0xbb, 0x3a, 0x08, 0xd2, 0xf4, 0x81, 0xee, 0xb5, 0x8a, 0xfe,
+  0xde, 0x80, 0x0d, 0xfb, 0xd5, 0xa5, 0x3b, 0xd1, 0x33, 0xbf, 0x3a, 0x90, 0xcc, 0x6b, 0x34, 0xfc,
+  0xbf, 0xb8, 0x7e, 0x74, 0xdc, 0x35, 0x7b, 0xe4, 0x1b, 0xf0, 0x23, 0xe3, 0x9e, 0x72, 0x74, 0x9a,
+  0x20, 0x41, 0x42, 0x5e, 0x7a, 0xd6, 0x0a, 0x63, 0xcb, 0xcc, 0xd8, 0x49, 0x4f, 0xd7, 0x11, 0x3b,
+  0x7d, 0x5a, 0xfc, 0x89, 0xf2, 0x05, 0x69, 0xa9, 0xbb, 0xf2, 0xbb, 0x5f, 0xef, 0xfa, 0x32, 0x85,
+  0xe9, 0x6b, 0x38, 0x2b, 0x1a, 0x66, 0x59, 0xb0, 0x07, 0x85, 0xb7, 0x58, 0x0a, 0xaf, 0x10, 0x27,
+  0x36, 0x5d, 0x89, 0xc7, 0x33, 0xc4, 0x18, 0x11, 0x37, 0xcb, 0x7d, 0xb1, 0xf2, 0x57, 0xec, 0x2f,
+  0x65, 0x7a, 0x4f, 0x54, 0xef, 0x3c, 0x9f, 0x6b, 0x29, 0x03, 0x13, 0xa0, 0x87, 0x35, 0x75, 0xe2,
+  0x18, 0x0e, 0xe3, 0x5d, 0xcb, 0x98, 0x22, 0xa0, 0xa3, 0x07, 0x13, 0x7c, 0x59, 0x49, 0x45, 0x78,
+  0x1a, 0x0e, 0x65, 0xca, 0x96, 0xef, 0x7f, 0x5c, 0xd3, 0x7f, 0x63, 0xdd, 0xc8, 0x7d, 0xa6, 0xdc,
+  0x88, 0xf1, 0xa4, 0x66, 0x48, 0x26, 0xdd, 0x2b, 0x8c, 0x3a, 0xaa, 0x1b, 0x85, 0x09, 0x64, 0x96,
+  0xb3, 0xe3, 0xa3, 0xee, 0xc4, 0xac, 0x19, 0x80, 0xef, 0x9a, 0x81, 0x60, 0x45, 0x46, 0x7d, 0xb9,
+  0x51, 0x31, 0x72, 0xf8, 0x26, 0xb5, 0xe2, 0x43, 0x7b, 0x69, 0x30, 0x45, 0xc2, 0x2a, 0x7d, 0x4b,
+  0xa5, 0x68, 0x63, 0x41, 0x20, 0x9f, 0x93, 0xb6, 0xc3, 0x5e, 0xe9, 0xdd, 0x34, 0x84, 0x41, 0x97,
+  0x69, 0x89, 0x89, 0x62, 0xac, 0x90, 0x90, 0xaf, 0x59, 0x4e, 0x3d, 0x4f, 0x49, 0x02, 0xb8, 0xb2,
+  0x78, 0x81, 0x00, 0x04, 0x5a, 0x26, 0xc5, 0xe7, 0xd6, 0x52, 0x38, 0x13, 0x09, 0x47, 0xc7, 0xbf,
+  0x02, 0x90, 0xc3, 0x6a, 0x20, 0x87, 0x12, 0x88, 0x8e, 0xd6, 0xed, 0x31, 0x39, 0x96, 0x40, 0xf4,
+  0x92, 0xd1, 0x1e, 0x97, 0xf1, 0x91, 0x42, 0xa6, 0x4a, 0x5c, 0xda, 0x83, 0x3a, 0x50, 0xc4, 0xa9,
+  0x14, 0x09, 0x96, 0x97, 0x88, 0x8a, 0x25, 0x96, 0xe5, 0x42, 0x63, 0x79, 0x13, 0x7b, 0x58, 0x61,
+  0xca, 0x13, 0x7f, 0xaf, 0x37, 0x8d, 0x8e, 0x58, 0xe5, 0xb7, 0x5d, 0x43, 0x3c, 0x50, 0x66, 0xe8,
+  0x6d, 0x97, 0x34, 0xc5, 0xaa, 0x9b, 0x84, 0x6b, 0x94, 0xad, 0x44, 0xe5, 0x4c, 0xf8, 0x83, 0xaf,
+  0x97, 0x12, 0x3b, 0x72, 0x3f, 0xbb, 0x21, 0x98, 0x40, 0xc7, 0xe9, 0x1a, 0xf2, 0x8d, 0x37, 0x3a,
+  0x5f, 0x2b, 0x27, 0x1c, 0x62, 0x49, 0x96, 0x3a, 0xd0, 0xc1, 0x44, 0xfc, 0x75, 0x12, 0xb9, 0x14,
+  0x5d, 0xa4, 0x08, 0x6b, 0x9b, 0xe6, 0xe4, 0x74, 0xc3, 0x20, 0x82, 0xde, 0x7b, 0xda, 0x37, 0xd9,
+  0x98, 0x69, 0x3f, 0x97, 0x28, 0x9f, 0x83, 0xf6, 0x59, 0xe4, 0x2e, 0x5d, 0xb9, 0xa3, 0x51, 0x66,
+  0x1b, 0x3e, 0x7e, 0x2b, 0xfa, 0x75, 0x55, 0xce, 0xd8, 0x27, 0x91, 0xda, 0x79, 0x50, 0x0f, 0xbc,
+  0x1a, 0x7a, 0xce, 0xc9, 0x47, 0xaa, 0x05, 0x53, 0xc4, 0x65, 0x71, 0x45, 0xf2, 0xc9, 0xd8, 0xfc,
+  0x62, 0xd4, 0x14, 0xba, 0x8e, 0x82, 0x50, 0x1f, 0xd1, 0x69, 0xc3, 0xcc, 0x12, 0xb6, 0x78, 0x32,
+  0x18, 0x77, 0x5d, 0x10, 0xa1, 0xfc, 0x18, 0x88, 0xbf, 0x2e, 0xdd, 0x0d, 0x65, 0xdb, 0xa8, 0x32,
+  0xfc, 0xca, 0x80, 0xcd, 0xd1, 0x1f, 0xa1, 0x16, 0x71, 0x2d, 0x07, 0x49, 0x99, 0xd7, 0xe5, 0x26,
+  0xa4, 0x2a, 0x9e, 0x51, 0x16, 0x26, 0x05, 0x42, 0x14, 0x8e, 0x01, 0x8d, 0x5e, 0x66, 0x7e, 0x39,
+  0xba, 0x6b, 0xe0, 0xde, 0x8c, 0xd1, 0x30, 0x53, 0x3e, 0xeb, 0x29, 0xcc, 0x13, 0xef, 0x3b, 0x62,
+  0x5b, 0xcd, 0x4e, 0x14, 0xa0, 0xa3, 0x4a, 0x34, 0x01, 0x8d, 0x3c, 0x1b, 0x44, 0xf6, 0x15, 0x5b,
+  0xe0, 0xd3, 0xe2, 0xa8, 0xb4, 0x1c, 0x52, 0x3f, 0x50, 0xb6, 0xd7, 0xcc, 0x0c, 0xba, 0xf8, 0xad,
+  0x38, 0xff, 0x11, 0xd5, 0x81, 0x46, 0x4f, 0xa7, 0x8f, 0xb9, 0x0e, 0x45, 0x91, 0x7f, 0x8e, 0x4c,
+  0x97, 0xd9, 0x69, 0x6c, 0x55, 0x47, 0xa2, 0xfc, 0x04, 0x88, 0xf8, 0x0e, 0x9f, 0x10, 0xc6, 0x30,
+  0xe0, 0x39, 0x31, 0xae, 0x34, 0x1b, 0x62, 0x08, 0x58, 0x95, 0x3b, 0x96, 0x01, 0x0f, 0xee, 0x09,
+  0xf8, 0xae, 0x7a, 0xb1, 0xb8, 0x4d, 0x2b, 0x0f, 0x12, 0x16, 0x6e, 0xfa, 0x5a, 0x66, 0x48, 0x12,
+  0x16, 0x16, 0xd7, 0x68, 0x4d, 0x60, 0x23, 0x22, 0x62, 0x73, 0xe1, 0x9d, 0xc7, 0x2c, 0x95, 0xe8,
+  0xa7, 0x86, 0x5a, 0x6b, 0x00, 0xf1, 0x55, 0x15, 0x73, 0xc5, 0xd0, 0x57, 0x16, 0x2f, 0xdb, 0x3e,
+  0xd2, 0x45, 0xb8, 0xe7, 0xe0, 0x76, 0xb5, 0x81, 0x11, 0x8c, 0x1f, 0x8a, 0xb3, 0x87, 0x21, 0x3e,
+  0x35, 0x8d, 0x84, 0x98, 0x9a, 0xdf, 0x69, 0x68, 0x97, 0xf6, 0x13, 0x47, 0x14, 0x98, 0xe3, 0x21,
+  0xdc, 0x81, 0x00, 0x0b, 0x64, 0xf9, 0xae, 0xad, 0xe5, 0x2b, 0x4d, 0x88, 0x60, 0x34, 0x00, 0x2a,
+  0x26, 0x9d, 0x9a, 0x30, 0x27, 0x0c, 0xd1, 0x4f, 0x5a, 0xcb, 0x8b, 0xf8, 0xe8, 0x2f, 0x7d, 0x1b,
+  0xc1, 0x13, 0xdd, 0x56, 0x4d, 0xd6, 0xc9, 0x9e, 0xeb, 0xa3, 0x49, 0x49, 0x7a, 0xcb, 0x07, 0xa5,
+  0x45, 0x9c, 0x72, 0x3a, 0x03, 0x7e, 0xb3, 0x08, 0xa6, 0x47, 0xbe, 0x27, 0x07, 0x47, 0x9a, 0xe8,
+  0x4a, 0xf9, 0x30, 0xf1, 0xfe, 0x58, 0xc1, 0xc4, 0xf4, 0xa1, 0x04, 0x9d, 0x13, 0x00, 0x0c, 0x45,
+  0xdf, 0xaa, 0x9c, 0x54, 0x34, 0x2a, 0x82, 0xa5, 0x6f, 0x92, 0x05, 0x96, 0x72, 0x5c, 0x39, 0xd8,
+  0x17, 0xa0, 0x99, 0x44, 0x1a, 0x68, 0xe7, 0xd0, 0x55, 0x4f, 0x43, 0xf2, 0xbb, 0x3d, 0x08, 0xaa,
+  0x9e, 0xe9, 0x57, 0x15, 0xc9, 0x75, 0x1e, 0x3c, 0xa9, 0x51, 0xd5, 0x7b, 0xf1, 0xe8, 0x26, 0xd7,
+  0x0f, 0xeb, 0x52, 0x8b, 0x1d, 0x9f, 0xb4, 0xf6, 0x9e, 0x7d, 0x62, 0xa8, 0xd7, 0x27, 0xd4, 0xc2,
+  0x88, 0xd9, 0x9d, 0x24, 0x1f, 0x2d, 0x43, 0x83, 0x0a, 0xd8, 0xc2, 0xad, 0xdc, 0x14, 0x9d, 0x9a,
+  0xf1, 0x11, 0xa0, 0xcb, 0x33, 0xfc, 0x6f, 0x0c, 0xfd, 0x00, 0xc9, 0x2e, 0x71, 0x64, 0x87, 0x03,
+  0xf2, 0xef, 0x7f, 0xd0, 0x2b, 0x15, 0x2a, 0xb5, 0xc0, 0x5d, 0x25, 0x59, 0x0f, 0x0e, 0x6a, 0xd2,
+  0x58, 0x8a, 0x7e, 0x14, 0xef, 0x95, 0x98, 0x93, 0xdf, 0x0d, 0xac, 0x0b, 0x46, 0x62, 0x7e, 0x91,
+  0x93, 0xe0, 0xe5, 0x45, 0xc4, 0x82, 0x00, 0x42, 0x0d, 0xb8, 0x7c, 0x3b, 0xc0, 0x2f, 0xc6, 0x1f,
+  0x6d, 0xa8, 0x90, 0x02, 0xfe, 0x5d, 0xa9, 0x06, 0x7c, 0xff, 0x83, 0xfc, 0xfb, 0xdf, 0xc4, 0xf8,
+  0xc0, 0xae, 0xe5, 0xd3, 0xff, 0xfb, 0x50, 0x27, 0x7e, 0xdb, 0x46, 0x5b, 0x93, 0xa3, 0xe1, 0x8b,
+  0x58, 0xdc, 0x1e, 0x53, 0x66, 0x4a, 0xf0, 0xef, 0x63, 0xff, 0x45, 0x7d, 0x40, 0x88, 0x8c, 0x83,
+  0x88, 0x8b, 0x2c, 0xb1, 0x88, 0x38, 0xb3, 0x6f, 0x10, 0x1b, 0xea, 0xe4, 0xd4, 0x4e, 0x72, 0x4a,
+  0x1d, 0xdc, 0x89, 0x3c, 0x18, 0x75, 0x23, 0x2d, 0xf6, 0xab, 0xf4, 0x9b, 0xb9, 0x3e, 0xb2, 0x7e,
+  0x2f, 0x76, 0xcd, 0xa2, 0xe9, 0xb4, 0x72, 0xd0, 0xaf, 0x96, 0xa7, 0x77, 0xe9, 0x9a, 0x71, 0x77,
+  0x7b, 0x62, 0x1e, 0x97, 0x94, 0x20, 0xda, 0xb9, 0xaf, 0x79, 0x0c, 0x63, 0xb7, 0x7b, 0xba, 0x2f,
+  0x61, 0xb2, 0x45, 0x16, 0x6a, 0x8e, 0xc2, 0xbd, 0x02, 0x29, 0x52, 0xd3, 0x5c, 0x1f, 0x6b, 0x61,
+  0x3c, 0xf8, 0x45, 0x3c, 0x15, 0xad, 0x8d, 0xb6, 0x52, 0x8f, 0x21, 0x93, 0x10, 0xdc, 0xde, 0x17,
+  0xfb, 0x5d, 0xda, 0x0d, 0xfe, 0x34, 0x9a, 0x96, 0xab, 0x55, 0xc7, 0x30, 0xa8, 0x05, 0xe2, 0x15,
+  0x45, 0x84, 0xd9, 0xf6, 0x96, 0x73, 0xa9, 0x5e, 0x0a, 0x4c, 0x85, 0xfa, 0x97, 0xa7, 0x4d, 0xac,
+  0xd2, 0x7e, 0x13, 0xff, 0x4b, 0x0d, 0xab, 0xb6, 0x99, 0x85, 0x39, 0xd5, 0xe0, 0xf6, 0xd3, 0xf4,
+  0x33, 0xb9, 0x42, 0x75, 0x86, 0x92, 0xcd, 0x4c, 0x5e, 0x7e, 0x7e, 0x4f, 0x5e, 0x5b, 0x9e, 0x17,
+  0x92, 0x9d, 0x0b, 0x3e, 0x5f, 0xee, 0x88, 0xaf, 0x2d, 0xdf, 0xf1, 0x00, 0xbd, 0xa4, 0xa3, 0x15,
+  0xde, 0xfa, 0x76, 0xca, 0x29, 0x2b, 0x70, 0x71, 0x4c, 0x97, 0xfa, 0x8e, 0x78, 0x19, 0x5a, 0x1f,
+  0xf2, 0x89, 0x68, 0xcd, 0x30, 0x73, 0x37, 0x7e, 0x7a, 0x7b, 0x09, 0x0b, 0x14, 0x7f, 0xd1, 0x46,
+  0x1e, 0xa9, 0xf5, 0x31, 0xc8, 0xb2, 0x36, 0x2a, 0xa3, 0xc0, 0x3b, 0xbd, 0xd2, 0xeb, 0xdb, 0x6f,
+  0x2b, 0xdd, 0x3e, 0x0b, 0xc4, 0xd1, 0xb6, 0x38, 0xdd, 0x57, 0x93, 0xdc, 0x69, 0x7d, 0xb5, 0x98,
+  0x11, 0x65, 0x54, 0x37, 0x43, 0xd6, 0x46, 0x00, 0x7d, 0x03, 0x0e, 0x86, 0xd0, 0xa1, 0x8e, 0xc4,
+  0x4c, 0xfc, 0x05, 0x2a, 0xc2, 0xf0, 0x71, 0xff, 0x25, 0xe5, 0xf2, 0x7d, 0x3e, 0xf1, 0xca, 0x9e,
+  0x54, 0x1f, 0x18, 0x5d, 0xd1, 0x5b, 0x19, 0x40, 0xaa, 0xb5, 0x01, 0x87, 0xe3, 0x51, 0xa0, 0xc6,
+  0x9e, 0x1b, 0x75, 0x8d, 0x11, 0xe8, 0x42, 0xc0, 0x82, 0xaa, 0x5d, 0x61, 0xb5, 0xb6, 0xa1, 0x22,
+  0x56, 0xe9, 0x68, 0xf5, 0x77, 0x98, 0xe2, 0x8f, 0x99, 0xa4, 0xe5, 0x5d, 0x03, 0x0c, 0x7c, 0xa7,
+  0x0c, 0xe5, 0x92, 0x4e, 0x86, 0x32, 0x2a, 0x03, 0x3c, 0xb9, 0x36, 0x66, 0xc4, 0xc0, 0xfd, 0x55,
+  0x95, 0x77, 0x8e, 0xfe, 0x0c, 0x99, 0x6f, 0xe8, 0x68, 0x78, 0xd7, 0x7c, 0xea, 0x90, 0x9c, 0x94,
+  0x05, 0x70, 0x81, 0xdc, 0xb4, 0x76, 0x96, 0x0b, 0x16, 0x96, 0x8a, 0x8d, 0xe9, 0x44, 0x18, 0x14,
+  0x4e, 0x95, 0xae, 0x4f, 0x9d, 0xee, 0xc9, 0xc1, 0x31, 0xb4, 0x21, 0x22, 0xa6, 0xa3, 0x54, 0xd1,
+  0x2c, 0x54, 0x6e, 0x9b, 0x95, 0xd3, 0xb0, 0xda, 0x3d, 0xf3, 0x54, 0x83, 0x8c, 0xcc, 0x9b, 0x93,
+  0xa4, 0x29, 0xa8, 0xb2, 0x09, 0x9a, 0xbd, 0x76, 0x54, 0x20, 0x1b, 0x5f, 0x17, 0x57, 0xbd, 0xbf,
+  0x5e, 0xa5, 0x7b, 0x17, 0x40, 0x32, 0x62, 0xe1, 0x59, 0xfc, 0x06, 0x14, 0x4e, 0xbc, 0x32, 0x0f,
+  0x77, 0xc0, 0x33, 0x67, 0x11, 0x78, 0x5b, 0x92, 0x18, 0xc5, 0x13, 0x7c, 0x9a, 0x85, 0x6f, 0xe4,
+  0x5a, 0xa2, 0xbe, 0x66, 0x01, 0x61, 0x75, 0x92, 0xda, 0x3e, 0x27, 0x1b, 0x5c, 0x31, 0x9e, 0x68,
+  0x7c, 0x79, 0x7b, 0x71, 0x99, 0x48, 0x24, 0xd9, 0xad, 0xa9, 0x2f, 0xda, 0x43, 0x09, 0xd9, 0x85,
+  0x48, 0x92, 0xed, 0x7c, 0x5d, 0xc9, 0x88, 0xc0, 0xa6, 0x6b, 0x6f, 0x9c, 0x3d, 0xd5, 0x58, 0x9e,
+  0xe9, 0xa0, 0x1e, 0xec, 0x42, 0x08, 0x13, 0x2d, 0xe7, 0x56, 0x94, 0xea, 0x08, 0xa5, 0x4c, 0x96,
+  0x34, 0xfc, 0xf4, 0xf9, 0xed, 0x47, 0x1d, 0x3b, 0x14, 0x13, 0x63, 0xd3, 0x62, 0x8c, 0xe0, 0x4a,
+  0x94, 0x82, 0x08, 0x44, 0x8c, 0xcf, 0x9f, 0x2e, 0x62, 0xbb, 0x92, 0xc1, 0xa4, 0xd7, 0x3a, 0x3a,
+  0x90, 0x92, 0x87, 0xf5, 0x3a, 0x49, 0x1d, 0xd2, 0xf3, 0xe7, 0xba, 0xe8, 0x78, 0x13, 0xae, 0x84,
+  0x12, 0x89, 0x69, 0xdd, 0x92, 0xb5, 0x29, 0x5b, 0x1a, 0x18, 0xf0, 0x7b, 0x82, 0xd0, 0x1f, 0x30,
+  0x16, 0xdb, 0x6b, 0x42, 0xe1, 0xf8, 0x20, 0x81, 0xee, 0xc8, 0x67, 0x30, 0x35, 0x6e, 0x48, 0xbb,
+  0xc9, 0xd9, 0xf3, 0x79, 0xa5, 0x1d, 0x8c, 0xdc, 0x0d, 0xe5, 0xf2, 0xbc, 0xab, 0x69, 0xbf, 0x45,
+  0x7b, 0xc2, 0x5c, 0x79, 0xb8, 0x9c, 0x53, 0x03, 0x29, 0x88, 0x38, 0x97, 0x83, 0xef, 0x43, 0xae,
+  0xd5, 0x83, 0xec, 0x69, 0xb4, 0xa0, 0x84, 0xc6, 0xa4, 0x54, 0x1e, 0x79, 0xa5, 0xf8, 0xc1, 0x82,
+  0x00, 0xb9, 0xbe, 0x32, 0x0a, 0x95, 0xc7, 0x98, 0x58, 0xed, 0x11, 0x2f, 0x5c, 0xd0, 0xa2, 0x66,
+  0x39, 0xf5, 0xd6, 0xa2, 0xc5, 0x29, 0xfa, 0x9d, 0xbe, 0x1c, 0x48, 0x57, 0x00, 0x03, 0xdc, 0x2f,
+  0xd6, 0xb4, 0xdc, 0x35, 0xec, 0x29, 0x65, 0x9e, 0xa8, 0x2b, 0xac, 0xf6, 0xda, 0x5d, 0x74, 0x4b,
+  0x29, 0x9b, 0x54, 0x47, 0x03, 0x47, 0x35, 0xed, 0x56, 0xc9, 0xe7, 0x83, 0x44, 0xc0, 0xb5, 0x0f,
+  0x68, 0x31, 0xcc, 0x50, 0xe5, 0x70, 0x18, 0x42, 0xe0, 0x67, 0xd3, 0x5c, 0xb9, 0x07, 0x58, 0x34,
+  0x47, 0xb7, 0x75, 0xa1, 0x2e, 0x74, 0xaf, 0x07, 0x9e, 0x7b, 0x6a, 0x46, 0x7f, 0x92, 0x27, 0x4e,
+  0x7f, 0xf5, 0x41, 0x78, 0x15, 0x05, 0xb1, 0xa7, 0xd1, 0x97, 0x7b, 0x3e, 0xef, 0xfd, 0x48, 0x60,
+  0x8d, 0xcb, 0x15, 0xf7, 0x1b, 0x96, 0x9b, 0x94, 0xc3, 0xd7, 0x63, 0x93, 0xd4, 0xf2, 0xeb, 0x71,
+  0x41, 0x13, 0x29, 0x68, 0xa5, 0x2b, 0x9b, 0x49, 0x10, 0x8d, 0x37, 0x37, 0x34, 0xb8, 0x26, 0x4d,
+  0xbd, 0xd2, 0x6e, 0x61, 0x69, 0x6a, 0x8c, 0xc6, 0x8c, 0xe6, 0x55, 0xc9, 0x07, 0x54, 0xf6, 0x10,
+  0x97, 0x0c, 0x7a, 0x66, 0x05, 0x4a, 0x5a, 0xb1, 0x8f, 0x9f, 0x85, 0x29, 0xbb, 0x0d, 0x1b, 0x1f,
+  0x1f, 0xe1, 0x9b, 0xae, 0x81, 0x0f, 0xc9, 0x88, 0xb0, 0x1c, 0xc4, 0x24, 0xd9, 0xe2, 0xb1, 0x42,
+  0xf2, 0x17, 0x0c, 0xfc, 0x41, 0x9f, 0x87, 0x25, 0x68, 0x61, 0x9f, 0x56, 0x51, 0x6f, 0x82, 0x51,
+  0xbe, 0x44, 0xb7, 0x06, 0x2d, 0x55, 0xa2, 0x2b, 0xff, 0x14, 0xe9, 0x0f, 0xe4, 0x72, 0xed, 0x62,
+  0xb8, 0x0c, 0x3e, 0x1f, 0xec, 0x08, 0xfe, 0x89, 0x3b, 0xe1, 0x58, 0xdf, 0x5e, 0x7c, 0x3e, 0x98,
+  0x0c, 0xf5, 0x48, 0xe6, 0xbd, 0x9a, 0x9c, 0xd7, 0x88, 0xbd, 0x5a, 0x45, 0xcc, 0xa3, 0x8c, 0xb2,
+  0x44, 0x4f, 0xe1, 0xaa, 0xb2, 0xf7, 0xea, 0x04, 0xa2, 0xe5, 0x96, 0xbc, 0x38, 0x20, 0x8c, 0x6b,
+  0x2b, 0x39, 0xf5, 0x98, 0xe5, 0x74, 0xf5, 0xf6, 0x7b, 0x5a, 0xb6, 0xdf, 0xf5, 0x44, 0x8d, 0x0b,
+  0xe4, 0x75, 0x35, 0x45, 0x52, 0x59, 0xc0, 0xb3, 0x82, 0x68, 0xa6, 0x35, 0x5a, 0xf8, 0x7c, 0x02,
+  0xd6, 0x93, 0xc6, 0x7b, 0xf6, 0x23, 0x71, 0x63, 0x96, 0xb9, 0x21, 0x0c, 0x52, 0x80, 0x9e, 0x28,
+  0xd2, 0x16, 0x9a, 0x66, 0x23, 0x93, 0x32, 0xdc, 0x38, 0xd3, 0x95, 0x30, 0xd3, 0x6c, 0x54, 0x0b,
+  0x4a, 0x6a, 0x72, 0x09, 0x88, 0x2e, 0x91, 0x9e, 0x55, 0xa6, 0xbe, 0xf7, 0x50, 0x7a, 0x11, 0x6e,
+  0x14, 0xb4, 0x3d, 0x0d, 0x73, 0x86, 0x20, 0x60, 0x7e, 0xb7, 0xda, 0x45, 0xaa, 0x84, 0x91, 0x3c,
+  0x7b, 0x46, 0x4a, 0xc9, 0x6a, 0x7a, 0x78, 0x94, 0x91, 0xaa, 0xf8, 0xec, 0x44, 0xb0, 0xcb, 0xf9,
+  0xc6, 0xa8, 0x49, 0x1c, 0xf5, 0x6a, 0x0d, 0x51, 0xe7, 0x7b, 0xf9, 0xb7, 0x78, 0xdd, 0xbf, 0xe8,
+  0x93, 0x36, 0xf5, 0x30, 0xd9, 0xa1, 0xef, 0x40, 0x19, 0x44, 0xd0, 0x1a, 0x30, 0x0f, 0x13, 0x4d,
+  0xdc, 0x77, 0x48, 0xa3, 0x5e, 0x8c, 0xa4, 0xd3, 0xf8, 0xb6, 0xa9, 0xc2, 0xe7, 0x61, 0x61, 0xa7,
+  0xcc, 0x5d, 0xa4, 0x5e, 0x86, 0xea, 0x40, 0x53, 0xab, 0x2e, 0x92, 0x05, 0x1c, 0xe7, 0xe7, 0x2a,
+  0x57, 0xa9, 0xeb, 0x18, 0x1f, 0x1c, 0x55, 0xf4, 0x91, 0x79, 0x89, 0x5a, 0xce, 0x5d, 0xb5, 0x82,
+  0xf5, 0xc5, 0xeb, 0x7d, 0x55, 0xfb, 0xd9, 0x28, 0xae, 0xda, 0x3f, 0x1b, 0xc9, 0x97, 0x87, 0x9e,
+  0x8d, 0xe4, 0x1f, 0x60, 0xfe, 0x5f, 0x95, 0x25, 0x37, 0x2b, 0x92, 0x79, 0x00, 0x00,
+};
+
+#endif // WEB_INTERFACE_GZ_H